@@ -19,8 +19,8 @@ void init()
     // Create audio source from file and capture resource handle
     src_hndl = gs_audio_load_from_file("./assets/punch.wav");
 
-    // Persistent audio (music)
-    mus_hndl = gs_audio_load_from_file("./assets/music.mp3");
+    // Persistent audio (music), streamed from disk instead of being decoded up front
+    mus_hndl = gs_audio_load_stream_from_file("./assets/music.mp3");
 
     // Create instance decl, play sound to be looped
     inst_hndl = gs_audio_instance_create(
@@ -28,7 +28,8 @@ void init()
             .src = mus_hndl,
             .persistent = true,
             .volume = 0.1f,
-            .loop = true 
+            .loop = true,
+            .bus = GS_AUDIO_BUS_MUSIC
         }
     );
     gs_audio_play(inst_hndl);
@@ -73,7 +73,7 @@ void render_system(ecs_iter_t* it)
 
     // Render all into immediate draw instance data
     for (int32_t i = 0; i < it->count; ++i) {
-        gsi_rectvd(&app->gsi, p[i], b[i], gs_v2(0.f, 0.f), gs_v2(1.f, 1.f), c[i], GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+        gsi_rect_instanced(&app->gsi, p[i], b[i], gs_v2(0.f, 0.f), gs_v2(1.f, 1.f), c[i], GS_GRAPHICS_PRIMITIVE_TRIANGLES);
     }
 }
 
@@ -0,0 +1,112 @@
+/*================================================================
+    * Copyright: 2020 John Jackson
+    * pak_archive
+
+    The purpose of this example is to demonstrate how to pack assets 
+    into a single archive, mount it and load from it through the 
+    asset manager as if reading loose files.
+
+    Included: 
+        * Building a pak archive from a list of files
+        * Mounting a pak (memory mapped, stored entries are zero copy)
+        * Loading assets from mounted pak with the regular importers
+
+    Also doubles as the pak builder tool:
+
+        App -build <out.pak> <file> <file> ...
+
+    Files are stored under the paths given, so build from the directory
+    the game will load relative to.
+
+    Press `esc` to exit the application.
+================================================================*/
+
+#define GS_NO_HIJACK_MAIN
+#define GS_IMPL
+#include <gs/gs.h>
+
+#define GS_IMMEDIATE_DRAW_IMPL
+#include <gs/util/gs_idraw.h>
+
+#define GS_ASSET_IMPL
+#include <gs/util/gs_asset.h>
+
+gs_command_buffer_t                     gcb = {0}; 
+gs_immediate_draw_t                     gsi = {0};
+gs_asset_manager_t                      gsa = {0};
+
+gs_asset_t tex_hndl = {0}; 
+gs_asset_t fnt_hndl = {0};
+
+void init()
+{
+    gcb = gs_command_buffer_new();
+    gsi = gs_immediate_draw_new();
+    gsa = gs_asset_manager_new();
+
+    // Pack the asset manager example's assets, stored under the paths this example loads them by
+    if (!gs_util_file_exists("./assets.pak"))
+    {
+        const char* files[] = {
+            "../12_asset_manager/assets/champ.png",
+            "../12_asset_manager/assets/font.ttf"
+        };
+
+        const char* names[] = {
+            "./assets/champ.png",
+            "./assets/font.ttf"
+        };
+
+        gs_pak_build("./assets.pak", files, names, sizeof(files) / sizeof(files[0]), true);
+    }
+
+    // Mounted paks are searched before loose files by all file reads going through the platform layer
+    gs_platform_mount_pak("./assets.pak");
+
+    tex_hndl = gs_assets_load_from_file(&gsa, gs_asset_texture_t, "./assets/champ.png", NULL, false);
+    fnt_hndl = gs_assets_load_from_file(&gsa, gs_asset_font_t, "./assets/font.ttf", 32);
+}
+
+void update()
+{
+    if (gs_platform_key_pressed(GS_KEYCODE_ESC)) gs_engine_quit();
+
+    const gs_vec2 fb = gs_platform_framebuffer_sizev(gs_platform_main_window());
+
+    gs_asset_texture_t* tp = gs_assets_getp(&gsa, gs_asset_texture_t, tex_hndl);
+    gs_asset_font_t* fp = gs_assets_getp(&gsa, gs_asset_font_t, fnt_hndl);
+
+    gsi_camera2D(&gsi);
+    gsi_texture(&gsi, tp->hndl);
+    gsi_rectvd(&gsi, gs_v2(100.f, 100.f), gs_v2(256.f, 256.f), gs_v2(0.f, 1.f), gs_v2(1.f, 0.f), GS_COLOR_WHITE, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+    gsi_text(&gsi, 100.f, 420.f, "Loaded from assets.pak", fp, false, 255, 255, 255, 255);
+
+    gs_graphics_clear_desc_t clear = {.actions = &(gs_graphics_clear_action_t){.color = 0.1f, 0.1f, 0.1f, 1.f}};
+
+    gs_graphics_begin_render_pass(&gcb, GS_GRAPHICS_RENDER_PASS_DEFAULT);
+        gs_graphics_set_viewport(&gcb, 0, 0, (int32_t)fb.x, (int32_t)fb.y);
+        gs_graphics_clear(&gcb, &clear);
+        gsi_draw(&gsi, &gcb);
+    gs_graphics_end_render_pass(&gcb);
+
+    gs_graphics_submit_command_buffer(&gcb);
+}
+
+int32_t main(int32_t argc, char** argv)
+{
+    // Builder mode, no window
+    if (argc > 3 && gs_string_compare_equal(argv[1], "-build"))
+    {
+        gs_result res = gs_pak_build(argv[2], (const char**)&argv[3], NULL, (uint32_t)(argc - 3), true);
+        gs_println("Pak build %s: %s", res == GS_RESULT_SUCCESS ? "succeeded" : "failed", argv[2]);
+        return res == GS_RESULT_SUCCESS ? 0 : 1;
+    }
+
+    gs_app_desc_t app = {
+        .init = init,
+        .update = update
+    };
+
+    gs_engine_create(app)->run();
+    return 0;
+}
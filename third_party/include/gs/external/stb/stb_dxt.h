@@ -66,13 +66,16 @@
 #define STB_DXT_DITHER    1   // use dithering. dubious win. never use for normal maps and the like!
 #define STB_DXT_HIGHQUAL  2   // high quality mode, does two refinement steps instead of 1. ~30-40% slower.
 
+#ifdef __cplusplus
 void rygCompress(unsigned char *dst, unsigned char *src, int w, int h, int isDxt5);
 
 // TODO remove these, not working properly..
 void rygCompressYCoCg(unsigned char *dst, unsigned char *src, int w, int h);
 void linearize(unsigned char * dst, const unsigned char * src, int n);
+#endif
 
 void stb_compress_dxt_block(unsigned char *dest, const unsigned char *src, int alpha, int mode);
+void stb_compress_bc5_block(unsigned char *dest, const unsigned char *src_rg_twoBytesPerPixel);
 #define STB_COMPRESS_DXT_BLOCK
 
 #ifdef STB_DXT_IMPLEMENTATION
@@ -96,8 +99,10 @@ void stb_compress_dxt_block(unsigned char *dest, const unsigned char *src, int a
 #include <stddef.h>
 #include <string.h> // memset
 #include <assert.h>
+#ifdef __cplusplus
 #include <iostream>
 #include <algorithm>
+#endif
 
 
 static unsigned char stb__Expand5[32];
@@ -776,6 +781,20 @@ void stb_compress_dxt_block(unsigned char *dest, const unsigned char *src, int a
    stb__CompressColorBlock(dest,(unsigned char*) src,mode);
 }
 
+// two independent alpha blocks, one per channel (BC5 / RGTC2)
+void stb_compress_bc5_block(unsigned char *dest, const unsigned char *src)
+{
+   unsigned char block[16*4];
+   int i, c;
+   for (c=0;c<2;c++)
+   {
+      for (i=0;i<16;i++)
+         block[i*4+3] = src[i*2+c];
+      stb__CompressAlphaBlock(dest + c*8,block,0);
+   }
+}
+
+#ifdef __cplusplus
 int imin(int x, int y) { return (x < y) ? x : y; }
 
 
@@ -1035,6 +1054,7 @@ void linearize(unsigned char * dst, const unsigned char * src, int n)
   for(int i = 0; i < n; i++)
     dst[i] = linearize(src[i]);
 }
+#endif // __cplusplus
 
 
 
@@ -134,6 +134,30 @@
         such as window width, window height, window flags, window title, etc. Refer to the section for gs_app_desc_t 
         further in the code for all provided options.
 
+    Fixed Timestep:
+
+    Providing a 'fixed_update' callback runs it at 'fixed_rate' hz (default 60), independent of the render rate. 
+    Each frame the engine adds the last frame's time to an accumulator and calls 'fixed_update' once per whole step, 
+    up to 'max_fixed_steps' times; time past that cap is dropped so a long stall can't snowball. The unconsumed 
+    fraction of a step is available to 'update' for interpolating rendered state between the last two simulation steps:
+
+        void my_fixed_update() {
+            prev = curr;
+            curr = step_physics(curr, gs_platform_fixed_delta_time());
+        }
+
+        void my_update() {
+            draw(lerp(prev, curr, gs_platform_interpolation_alpha()));
+        }
+
+        gs_app_desc_t gs_main(int32_t argc, char** argv) {
+            return (gs_app_desc_t) {
+                .fixed_update = my_fixed_update,
+                .update = my_update,
+                .fixed_rate = 120.f
+            };
+        }
+
     It's also possible to define GS_NO_HIJACK_MAIN for your application. This will make it so gunslinger will not be
     the main entry point to your application. You will instead be responsible for creating an engine instance and 
     passing in your application description to it.
@@ -1093,6 +1117,29 @@ void gs_util_normalize_path
     // Normalize the path somehow...
 }
 
+// Decode codepoint at str and advance str past it (malformed sequences decode as U+FFFD)
+gs_force_inline
+uint32_t gs_util_utf8_next(const char** str)
+{
+    const uint8_t* s = (const uint8_t*)*str;
+    uint32_t c = s[0];
+    uint32_t n = c < 0x80 ? 0 : (c & 0xE0) == 0xC0 ? 1 : (c & 0xF0) == 0xE0 ? 2 : (c & 0xF8) == 0xF0 ? 3 : 4;
+    if (n == 4) {
+        *str += 1;
+        return 0xFFFD;
+    }
+    c = n ? (c & (0x3F >> n)) : c;
+    for (uint32_t i = 1; i <= n; ++i) {
+        if ((s[i] & 0xC0) != 0x80) {
+            *str += i;
+            return 0xFFFD;
+        }
+        c = (c << 6) | (s[i] & 0x3F);
+    }
+    *str += n + 1;
+    return c;
+}
+
 #ifdef __MINGW32__
     #define gs_printf(__FMT, ...) __mingw_printf(__FMT, ##__VA_ARGS__)
 #else
@@ -3629,6 +3676,34 @@ gs_vec4 gs_aabb_window_coords(gs_aabb_t* aabb, gs_camera_t* camera, gs_vec2 wind
 // Platform Time
 ============================================================*/
 
+#ifndef GS_PLATFORM_PACER_SPIN_MS
+    #if (defined GS_PLATFORM_WIN)
+        #define GS_PLATFORM_PACER_SPIN_MS 2.0       // Final stretch of a frame wait that is spun rather than slept (ms)
+    #else
+        #define GS_PLATFORM_PACER_SPIN_MS 1.0
+    #endif
+#endif
+
+#ifndef GS_PLATFORM_FRAME_HISTOGRAM_BUCKETS
+    #define GS_PLATFORM_FRAME_HISTOGRAM_BUCKETS 64
+#endif
+
+#ifndef GS_PLATFORM_FRAME_HISTOGRAM_BUCKET_MS
+    #define GS_PLATFORM_FRAME_HISTOGRAM_BUCKET_MS 0.5
+#endif
+
+typedef struct gs_platform_frame_stats_t
+{
+    uint64_t count;     // Frames recorded since last reset
+    uint64_t late;      // Frames longer than one and a half times the paced frame period
+    f64 min;            // Shortest frame (in ms)
+    f64 max;            // Longest frame (in ms)
+    f64 mean;           // Mean frame time (in ms)
+    f64 variance;       // Frame time variance (in ms^2)
+    f64 m2;             // Running sum of squared deviations from mean
+    uint32_t histogram[GS_PLATFORM_FRAME_HISTOGRAM_BUCKETS];   // Frame counts per GS_PLATFORM_FRAME_HISTOGRAM_BUCKET_MS, last bucket holds everything longer
+} gs_platform_frame_stats_t;
+
 typedef struct gs_platform_time_t
 {
     f64 max_fps;
@@ -3638,6 +3713,11 @@ typedef struct gs_platform_time_t
     f64 render;
     f64 delta;
     f64 frame;
+    f64 fixed_delta;    // Fixed simulation step (in seconds)
+    f64 accumulator;    // Unsimulated time carried between frames (in seconds)
+    f64 alpha;          // Interpolation factor between last two fixed steps [0, 1)
+    f64 deadline;       // Elapsed time the current frame is paced to end at (in ms)
+    gs_platform_frame_stats_t stats;
 } gs_platform_time_t;
 
 /*============================================================
@@ -3656,6 +3736,80 @@ typedef struct gs_uuid_t
     uint8_t bytes[16];
 } gs_uuid_t;
 
+/*============================================================
+// Platform Pak
+============================================================*/
+
+/*
+    Packed asset archive, read through a read only memory map:
+
+        header | index (entries sorted by path hash) | path strings | blobs (each aligned to GS_PAK_ALIGNMENT)
+
+    Stored entries resolve to a pointer into the map with no copy. Entries may be lz4 (block format) compressed
+    per file by the builder when it saves space, these are decompressed into an owned buffer on open. Either way
+    the view is followed by a null byte (the builder leaves one after every blob), so text assets can be treated
+    as strings.
+    Paths are matched with '\\' as '/' and without a leading "./".
+*/
+
+#define GS_PAK_MAGIC        0x4b505347  // 'GSPK'
+#define GS_PAK_VERSION      1
+#define GS_PAK_ALIGNMENT    16
+
+typedef enum gs_pak_compression
+{
+    GS_PAK_COMPRESSION_NONE = 0x00,
+    GS_PAK_COMPRESSION_LZ4
+} gs_pak_compression;
+
+typedef struct gs_pak_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+    uint64_t index_offset;
+    uint64_t names_offset;
+} gs_pak_header_t;
+
+typedef struct gs_pak_entry_t
+{
+    uint64_t hash;
+    uint64_t offset;
+    uint64_t size;          // Size in archive
+    uint64_t raw_size;      // Size once decompressed
+    uint32_t name_offset;   // Into path strings
+    uint32_t compression;
+} gs_pak_entry_t;
+
+typedef struct gs_pak_t
+{
+    const uint8_t* data;
+    size_t size;
+    const gs_pak_header_t* header;
+    const gs_pak_entry_t* entries;
+    const char* names;
+} gs_pak_t;
+
+// View of whole file contents, either into a mapped pak or an owned buffer
+typedef struct gs_platform_file_view_t
+{
+    const void* data;
+    size_t size;
+    void* alloc;            // Owned buffer to release, NULL when pointing into a mapped pak
+    void* map;              // Loose file mapping to release (gs_platform_file_view_open_mapped)
+} gs_platform_file_view_t;
+
+GS_API_DECL bool32_t              gs_pak_open(gs_pak_t* pak, const char* path);
+GS_API_DECL void                  gs_pak_close(gs_pak_t* pak);
+GS_API_DECL const gs_pak_entry_t* gs_pak_find(const gs_pak_t* pak, const char* path);
+GS_API_DECL bool32_t              gs_pak_read(const gs_pak_t* pak, const gs_pak_entry_t* entry, gs_platform_file_view_t* view);
+GS_API_DECL gs_result             gs_pak_build(const char* out_path, const char** file_paths, const char** names, uint32_t count, bool32_t compress);
+GS_API_DECL uint64_t              gs_pak_hash_path(const char* path);
+GS_API_DECL int32_t               gs_lz4_compress(const uint8_t* src, int32_t src_size, uint8_t* dst, int32_t dst_capacity);
+GS_API_DECL int32_t               gs_lz4_decompress(const uint8_t* src, int32_t src_size, uint8_t* dst, int32_t dst_size);
+GS_API_DECL int32_t               gs_lz4_compress_bound(int32_t src_size);
+
 /*============================================================
 // Platform Window
 ============================================================*/
@@ -3860,7 +4014,8 @@ typedef struct gs_platform_video_settings_t
 {
     gs_graphics_api_settings_t      graphics;
     gs_platform_video_driver_type   driver;
-    b32                             vsync_enabled;
+    b32                             vsync_enabled;  // Swap interval, 0 for off, n to present every n-th refresh
+    f32                             refresh_rate;   // Refresh rate of primary monitor at time vsync was set (0 if unknown)
 } gs_platform_video_settings_t;
 
 typedef struct gs_platform_settings_t
@@ -3933,6 +4088,13 @@ typedef void (* gs_dropped_files_callback_t)(void*, int32_t count, const char**
 typedef void (* gs_window_close_callback_t)(void*);
 typedef void (* gs_character_callback_t)(void*, uint32_t code_point);
 
+// Platform thread handles (API below)
+typedef void (* gs_platform_thread_func_t)(void* user_data);
+
+typedef struct gs_platform_thread_t    {void* hndl;} gs_platform_thread_t;
+typedef struct gs_platform_mutex_t     {void* hndl;} gs_platform_mutex_t;
+typedef struct gs_platform_semaphore_t {void* hndl;} gs_platform_semaphore_t;
+
 /*===============================================================================================
 // Platform Interface
 ===============================================================================================*/
@@ -3957,6 +4119,10 @@ typedef struct gs_platform_i
     // Cursors
     void* cursors[GS_PLATFORM_CURSOR_COUNT];
 
+    // Mounted archives, searched newest first before loose files
+    gs_dyn_array(gs_pak_t) paks;
+    gs_platform_mutex_t pak_lock;   // Mounts can happen while loader threads look up files
+
     // Specific user data (for custom implementations)
     void* user_data;
 } gs_platform_i;
@@ -3974,11 +4140,41 @@ GS_API_DECL gs_result       gs_platform_shutdown(gs_platform_i* platform);  // S
 
 // Platform Util
 GS_API_DECL void   gs_platform_sleep(float ms); // Sleeps platform for time in ms
+GS_API_DECL void   gs_platform_sleep_until(double ms); // Sleeps, then spins the last GS_PLATFORM_PACER_SPIN_MS, until elapsed time reaches ms
 GS_API_DECL double gs_platform_elapsed_time();  // Returns time in ms since initialization of platform
 GS_API_DECL float  gs_platform_delta_time();
+GS_API_DECL float  gs_platform_fixed_delta_time();  // Returns fixed simulation step in seconds
+GS_API_DECL float  gs_platform_interpolation_alpha(); // Returns fraction of a fixed step left unsimulated this frame
+GS_API_DECL const gs_platform_frame_stats_t* gs_platform_frame_stats();
+GS_API_DECL void   gs_platform_frame_stats_reset();
+GS_API_DECL double gs_platform_frame_stats_percentile(float p); // Returns frame time in ms that p percent [0, 100] of frames come in under
 
 // Platform Video
-GS_API_DECL void gs_platform_enable_vsync(int32_t enabled);
+GS_API_DECL void  gs_platform_enable_vsync(int32_t enabled);   // Values above 1 present every n-th refresh
+GS_API_DECL float gs_platform_refresh_rate();                  // Refresh rate in hz of primary monitor (0 if unknown)
+
+// Platform Threads
+GS_API_DECL gs_platform_thread_t    gs_platform_thread_create(gs_platform_thread_func_t func, void* user_data);
+GS_API_DECL void                    gs_platform_thread_join(gs_platform_thread_t thread);   // Waits for thread to finish and releases it
+GS_API_DECL uint32_t                gs_platform_hardware_thread_count();
+GS_API_DECL gs_platform_mutex_t     gs_platform_mutex_create();
+GS_API_DECL void                    gs_platform_mutex_destroy(gs_platform_mutex_t mutex);
+GS_API_DECL void                    gs_platform_mutex_lock(gs_platform_mutex_t mutex);
+GS_API_DECL void                    gs_platform_mutex_unlock(gs_platform_mutex_t mutex);
+GS_API_DECL gs_platform_semaphore_t gs_platform_semaphore_create(uint32_t count);
+GS_API_DECL void                    gs_platform_semaphore_destroy(gs_platform_semaphore_t sem);
+GS_API_DECL void                    gs_platform_semaphore_wait(gs_platform_semaphore_t sem);
+GS_API_DECL void                    gs_platform_semaphore_post(gs_platform_semaphore_t sem);
+
+// Platform Atomics (acquire load / release store, enough to hand off single producer single consumer queues)
+#if (defined _MSC_VER && !defined __clang__)
+    #include <intrin.h>
+    #define gs_atomic_load_u32(PTR)         ((uint32_t)_InterlockedOr((volatile long*)(PTR), 0))
+    #define gs_atomic_store_u32(PTR, VAL)   ((void)_InterlockedExchange((volatile long*)(PTR), (long)(VAL)))
+#else
+    #define gs_atomic_load_u32(PTR)         __atomic_load_n((PTR), __ATOMIC_ACQUIRE)
+    #define gs_atomic_store_u32(PTR, VAL)   __atomic_store_n((PTR), (VAL), __ATOMIC_RELEASE)
+#endif
 
 // Platform UUID
 GS_API_DECL gs_uuid_t gs_platform_generate_uuid();
@@ -4039,6 +4235,13 @@ GS_API_DECL gs_result  gs_platform_write_file_contents(const char* file_path, co
 GS_API_DECL bool       gs_platform_file_exists(const char* file_path);
 GS_API_DECL int32_t    gs_platform_file_size_in_bytes(const char* file_path);
 GS_API_DECL void       gs_platform_file_extension(char* buffer, size_t buffer_sz, const char* file_path);
+GS_API_DECL void*      gs_platform_file_map(const char* file_path, size_t* sz);    // Read only map of whole file, NULL on failure
+GS_API_DECL void       gs_platform_file_unmap(void* data, size_t sz);
+GS_API_DECL bool32_t   gs_platform_mount_pak(const char* pak_path);
+GS_API_DECL void       gs_platform_unmount_paks();  // Views opened from mounted paks must be closed first
+GS_API_DECL bool32_t   gs_platform_file_view_open(const char* file_path, gs_platform_file_view_t* view); // Mounted paks first, then loose file
+GS_API_DECL bool32_t   gs_platform_file_view_open_mapped(const char* file_path, gs_platform_file_view_t* view); // Same, but maps loose files instead of reading them
+GS_API_DECL void       gs_platform_file_view_close(gs_platform_file_view_t* view);
 
 /*=============================
 // GS_AUDIO
@@ -4055,30 +4258,302 @@ typedef enum gs_audio_file_type
 // Audio Source
 ==================*/
 
+// Decoder state for sources streamed from disk, see gs_audio_load_stream_from_file
+typedef struct gs_audio_stream_t gs_audio_stream_t;
+
+typedef enum gs_audio_sample_format
+{
+    GS_AUDIO_SAMPLE_FORMAT_S16 = 0x00,
+    GS_AUDIO_SAMPLE_FORMAT_ADPCM            // IMA ADPCM in GS_AUDIO_ADPCM_BLOCK_FRAMES frame blocks, see gs_audio_source_compress
+} gs_audio_sample_format;
+
 typedef struct gs_audio_source_t
 {
     int32_t channels;
     int32_t sample_rate;
-    void* samples;
-    int32_t sample_count;
+    void* samples;                  // NULL for streamed sources
+    int32_t sample_count;           // Decoded samples (frames * channels) whatever the format
+    gs_audio_sample_format format;
+    gs_audio_stream_t* stream;
 } gs_audio_source_t;
 
 gs_handle_decl(gs_audio_source_t);
 
+typedef enum gs_audio_attenuation_model
+{
+    GS_AUDIO_ATTENUATION_INVERSE = 0x00,   // min / (min + rolloff * (d - min))
+    GS_AUDIO_ATTENUATION_LINEAR,           // 1 - rolloff * (d - min) / (max - min)
+    GS_AUDIO_ATTENUATION_EXPONENTIAL,      // (d / min) ^ -rolloff
+    GS_AUDIO_ATTENUATION_NONE
+} gs_audio_attenuation_model;
+
+// Placement of a spatial instance, distances are clamped to [min_distance, max_distance] before attenuating
+typedef struct gs_audio_emitter_t
+{
+    gs_vec3 position;
+    gs_vec3 velocity;               // Units per second, only used for doppler
+    gs_audio_attenuation_model attenuation;
+    float min_distance;             // Full volume within, 0 is treated as 1
+    float max_distance;             // 0 is unbounded (linear attenuation then never falls off)
+    float rolloff;                  // 0 is treated as 1
+    float doppler;                  // Doppler strength, 0 disables it. Streams play at their own rate and get no doppler
+} gs_audio_emitter_t;
+
+// Where the instances are heard from. Right is +x and forward is -z of the rotation, like gs_camera_t
+typedef struct gs_audio_listener_t
+{
+    gs_vqs transform;
+    gs_vec3 velocity;
+} gs_audio_listener_t;
+
 typedef struct gs_audio_instance_decl_t
 {
     gs_handle(gs_audio_source_t) src;
     float volume;
+    float pitch;                    // Playback speed multiplier, 0 plays at the source's own rate (ignored by streams)
+    int32_t priority;               // Higher priority voices keep mixing (and are stolen last) when voices run out
+    bool32_t high_quality;          // Windowed sinc instead of linear interpolation while pitched
     bool32_t loop;
-    bool32_t persistent;
+    bool32_t persistent;            // Persistent instances report their play position back to the game thread
     bool32_t playing;
+    bool32_t spatial;               // Volume is attenuated and panned by the emitter's placement relative to the listener
+    gs_audio_emitter_t emitter;
+    uint32_t bus;                   // Bus mixed into, GS_AUDIO_BUS_MASTER by default
     double sample_position;
     void* user_data;
 } gs_audio_instance_decl_t;
 
-typedef gs_audio_instance_decl_t gs_audio_instance_t;
+typedef struct gs_audio_instance_t
+{
+    gs_audio_instance_decl_t decl;  // Game thread mirror of the mixer voice
+    uint32_t play_id;               // Unique per play, mixer events for older plays are ignored
+    bool32_t one_shot;              // Created by gs_audio_play_source, no handle escapes so it's recycled when finished
+} gs_audio_instance_t;
+
 gs_handle_decl(gs_audio_instance_t);
 
+/*==================
+// Audio Commands
+==================*/
+
+/*
+    The game thread never touches mixer state. Every instance call is pushed as a command into a single producer/single 
+    consumer ring that the mixer drains at the start of each callback, and the mixer reports back through a second ring 
+    (drained by gs_audio_update) so instance queries stay answerable without locking the audio thread.
+*/
+
+#ifndef GS_AUDIO_COMMAND_QUEUE_SIZE
+    #define GS_AUDIO_COMMAND_QUEUE_SIZE 1024    // Must be a power of two
+#endif
+
+#ifndef GS_AUDIO_EVENT_QUEUE_SIZE
+    #define GS_AUDIO_EVENT_QUEUE_SIZE   1024    // Must be a power of two
+#endif
+
+#ifndef GS_AUDIO_MAX_VOICES
+    #define GS_AUDIO_MAX_VOICES         256     // Voices tracked by the mixer, the lowest scored one is stolen when full
+#endif
+
+#ifndef GS_AUDIO_MAX_STREAMS
+    #define GS_AUDIO_MAX_STREAMS        32
+#endif
+
+#ifndef GS_AUDIO_STREAM_BUFFER_FRAMES
+    #define GS_AUDIO_STREAM_BUFFER_FRAMES   32768   // Decoded frames buffered per stream (~0.75s at 44.1kHz), must be a power of two
+#endif
+
+#ifndef GS_AUDIO_ADPCM_BLOCK_FRAMES
+    #define GS_AUDIO_ADPCM_BLOCK_FRAMES 256     // Frames per independently decodable ADPCM block, at least GS_AUDIO_RESAMPLE_TAPS
+#endif
+
+#ifndef GS_AUDIO_MAX_MIXED_VOICES
+    #define GS_AUDIO_MAX_MIXED_VOICES   64      // Voices actually mixed, the rest only advance (virtualized)
+#endif
+
+#ifndef GS_AUDIO_SPEED_OF_SOUND
+    #define GS_AUDIO_SPEED_OF_SOUND     343.3f  // World units per second, for doppler
+#endif
+
+#ifndef GS_AUDIO_AUDIBLE_THRESHOLD
+    #define GS_AUDIO_AUDIBLE_THRESHOLD  0.001f  // Voices quieter than this (-60dB) are always virtualized
+#endif
+
+#ifndef GS_AUDIO_SAMPLE_RATE
+    #define GS_AUDIO_SAMPLE_RATE        0       // Output rate requested from the device, 0 uses its native rate
+#endif
+
+#ifndef GS_AUDIO_MAX_BUSES
+    #define GS_AUDIO_MAX_BUSES          16
+#endif
+
+#ifndef GS_AUDIO_MAX_BUS_EFFECTS
+    #define GS_AUDIO_MAX_BUS_EFFECTS    4       // Effect slots per bus, processed in order
+#endif
+
+/*==================
+// Audio Buses
+==================*/
+
+/*
+    Voices mix into buses, every bus runs its effect chain over each mix block and adds the result, scaled by its 
+    volume, into its parent until everything reaches the master. Parents are always created before their children, 
+    so the mixer processes buses from the last one created back to the master.
+*/
+
+#define GS_AUDIO_BUS_INVALID    UINT32_MAX
+
+// Buses created by gs_audio_create
+typedef enum gs_audio_bus_default
+{
+    GS_AUDIO_BUS_MASTER = 0x00,
+    GS_AUDIO_BUS_MUSIC,
+    GS_AUDIO_BUS_SFX,
+    GS_AUDIO_BUS_UI
+} gs_audio_bus_default;
+
+typedef enum gs_audio_effect_type
+{
+    GS_AUDIO_EFFECT_NONE = 0x00,
+    GS_AUDIO_EFFECT_LOWPASS,
+    GS_AUDIO_EFFECT_HIGHPASS,
+    GS_AUDIO_EFFECT_REVERB,
+    GS_AUDIO_EFFECT_COMPRESSOR
+} gs_audio_effect_type;
+
+typedef struct gs_audio_effect_desc_t
+{
+    gs_audio_effect_type type;
+
+    /* Low/high pass */
+    float frequency;                // Cutoff in Hz
+    float q;                        // Resonance, 0 is treated as 0.7071 (no peak)
+
+    /* Reverb */
+    float room_size;                // 0 - 1
+    float damping;                  // 0 - 1, how quickly the highs die out
+    float wet;                      // 0 - 1
+
+    /* Compressor */
+    float threshold;                // In dB, gain is reduced while the key is louder than this
+    float ratio;                    // 0 is treated as 4
+    float attack_ms;
+    float release_ms;
+    uint32_t sidechain;             // Bus whose level is the key, e.g. sfx on the music bus to duck it. 0 (master), GS_AUDIO_BUS_INVALID or itself for plain compression
+} gs_audio_effect_desc_t;
+
+// Game thread view of a bus, the mixer keeps its own copy of everything but the name
+typedef struct gs_audio_bus_t
+{
+    char name[32];
+    uint32_t parent;
+    float volume;
+    gs_audio_effect_desc_t effects[GS_AUDIO_MAX_BUS_EFFECTS];
+    void* effect_memory[GS_AUDIO_MAX_BUS_EFFECTS];     // Reverb delay lines, allocated once per slot and kept until destroy
+} gs_audio_bus_t;
+
+typedef struct gs_audio_bus_command_t
+{
+    uint32_t id;
+    uint32_t parent;
+    uint32_t slot;
+    float volume;
+    gs_audio_effect_desc_t effect;
+    void* memory;
+} gs_audio_bus_command_t;
+
+typedef enum gs_audio_command_type
+{
+    GS_AUDIO_COMMAND_PLAY = 0x00,
+    GS_AUDIO_COMMAND_PAUSE,
+    GS_AUDIO_COMMAND_STOP,
+    GS_AUDIO_COMMAND_RESTART,
+    GS_AUDIO_COMMAND_SET_VOLUME,
+    GS_AUDIO_COMMAND_SET_DATA,      // Applies decl, keeps the mixer's position
+    GS_AUDIO_COMMAND_SEEK,          // Applies decl including sample_position
+    GS_AUDIO_COMMAND_SET_POSITION,  // Applies decl.emitter's position and velocity
+    GS_AUDIO_COMMAND_SET_LISTENER,
+    GS_AUDIO_COMMAND_ADD_BUS,
+    GS_AUDIO_COMMAND_SET_BUS_VOLUME,
+    GS_AUDIO_COMMAND_SET_BUS_EFFECT
+} gs_audio_command_type;
+
+typedef struct gs_audio_command_t
+{
+    gs_audio_command_type type;
+    uint32_t inst;                  // Instance slot id
+    uint32_t play_id;
+    gs_audio_source_t src;          // Copied so the mixer never reads the source cache
+    gs_audio_instance_decl_t decl;
+    union {
+        gs_audio_listener_t listener;
+        gs_audio_bus_command_t bus;
+    };
+} gs_audio_command_t;
+
+typedef enum gs_audio_event_type
+{
+    GS_AUDIO_EVENT_POSITION = 0x00,
+    GS_AUDIO_EVENT_FINISHED
+} gs_audio_event_type;
+
+typedef struct gs_audio_event_t
+{
+    gs_audio_event_type type;
+    uint32_t inst;
+    uint32_t play_id;
+    double sample_position;
+} gs_audio_event_t;
+
+typedef struct gs_audio_command_queue_t
+{
+    gs_audio_command_t data[GS_AUDIO_COMMAND_QUEUE_SIZE];
+    uint32_t write;                 // Only written by the game thread
+    uint8_t  __pad[60];
+    uint32_t read;                  // Only written by the mixer
+} gs_audio_command_queue_t;
+
+typedef struct gs_audio_event_queue_t
+{
+    gs_audio_event_t data[GS_AUDIO_EVENT_QUEUE_SIZE];
+    uint32_t write;                 // Only written by the mixer
+    uint8_t  __pad[60];
+    uint32_t read;                  // Only written by the game thread
+} gs_audio_event_queue_t;
+
+// Mixer owned playback state for an instance that is playing or paused
+typedef struct gs_audio_voice_t
+{
+    uint32_t inst;
+    uint32_t play_id;
+    gs_audio_source_t src;
+    float volume;
+    int32_t priority;
+    bool32_t loop;
+    bool32_t persistent;
+    bool32_t playing;
+    bool32_t virtualized;           // Advanced without being mixed
+    bool32_t finished;              // Kept until its finished event fits in the event queue
+    bool32_t high_quality;
+    uint64_t step;                  // Source frames per output frame, 32.32 fixed point
+    bool32_t spatial;
+    gs_audio_emitter_t emitter;
+    uint32_t bus;
+    double sample_position;
+    float gain[2];                  // Left/right gain applied by the last block, ramped towards the target
+    float target[2];                // Left/right gain for this callback, volume after attenuation and panning
+    float doppler;                  // Pitch factor for this callback
+    uint32_t adpcm_block;           // First of the two blocks held in adpcm_cache, UINT32_MAX if none
+    s16 adpcm_cache[GS_AUDIO_ADPCM_BLOCK_FRAMES * 2 * 2];
+} gs_audio_voice_t;
+
+typedef struct gs_audio_voice_stats_t
+{
+    uint32_t active;                // Voices mixed by the last callback
+    uint32_t virtualized;           // Playing voices skipped by the last callback
+    uint32_t stolen;                // Voices killed to make room for a new play, since init
+    uint32_t rejected;              // Plays dropped because every voice outranked them, since init
+} gs_audio_voice_stats_t;
+
 /*=============================
 // Audio Interface
 =============================*/
@@ -4088,9 +4563,38 @@ typedef struct gs_audio_i
     /* Audio source data cache */
     gs_slot_array(gs_audio_source_t) sources;
 
-    /* Audio instance data cache */
+    /* Audio instance data cache (game thread only) */
     gs_slot_array(gs_audio_instance_t) instances;
 
+    /* Game thread -> mixer commands */
+    gs_audio_command_queue_t commands;
+
+    /* Mixer -> game thread events */
+    gs_audio_event_queue_t events;
+
+    /* Voices, owned exclusively by the mixer */
+    gs_audio_voice_t voices[GS_AUDIO_MAX_VOICES];
+    uint32_t voice_count;
+
+    /* Voice counters, written by the mixer */
+    gs_audio_voice_stats_t voice_stats;
+
+    /* Listener spatial voices are heard from, owned by the mixer */
+    gs_audio_listener_t listener;
+
+    /* Mix buses (game thread only) */
+    gs_audio_bus_t buses[GS_AUDIO_MAX_BUSES];
+    uint32_t bus_count;
+
+    /* Source of unique play ids (game thread only) */
+    uint32_t play_id;
+
+    /* Streamed sources, appended by the game thread and decoded ahead of the mixer by the stream thread */
+    gs_audio_stream_t* streams[GS_AUDIO_MAX_STREAMS];
+    uint32_t stream_count;
+    uint32_t stream_running;
+    gs_platform_thread_t stream_thread;
+
     /* Max global volume setting */
     float max_audio_volume;
 
@@ -4103,7 +4607,7 @@ typedef struct gs_audio_i
     /* Amount of samples to write */
     uint32_t sample_count_to_output;    
 
-    /* Samples per second for hardware */
+    /* Samples per second for hardware, sources are converted to it on load (0 until the device is open) */
     uint32_t samples_per_second;
 
     /* User data for custom impl */
@@ -4119,9 +4623,15 @@ GS_API_DECL gs_audio_i* gs_audio_create();
 GS_API_DECL void        gs_audio_destroy(gs_audio_i* audio);
 GS_API_DECL gs_result   gs_audio_init(gs_audio_i* audio);
 GS_API_DECL gs_result   gs_audio_shutdown(gs_audio_i* audio);
+GS_API_DECL void        gs_audio_update(gs_audio_i* audio);    // Drains mixer events, called once per frame by the engine
 
 /* Audio create source */
 GS_API_DECL gs_handle(gs_audio_source_t) gs_audio_load_from_file(const char* file_path);
+GS_API_DECL gs_handle(gs_audio_source_t) gs_audio_load_stream_from_file(const char* file_path);           // Decoded while playing, one instance at a time, no pitch or doppler
+GS_API_DECL gs_handle(gs_audio_source_t) gs_audio_source_create(const gs_audio_source_t* src);                  // Takes ownership of decoded samples
+GS_API_DECL bool32_t                     gs_audio_load_source_data_from_file(const char* file_path, gs_audio_source_t* out); // Decode only, thread safe
+GS_API_DECL gs_handle(gs_audio_source_t) gs_audio_load_compressed_from_file(const char* file_path);       // Kept resident as ADPCM, ~4x smaller
+GS_API_DECL bool32_t                     gs_audio_source_compress(gs_audio_source_t* src);                      // Decoded samples to ADPCM in place, thread safe
 
 /* Audio create instance */
 GS_API_DECL gs_handle(gs_audio_instance_t) gs_audio_instance_create(gs_audio_instance_decl_t* decl);
@@ -4133,6 +4643,18 @@ GS_API_DECL void     gs_audio_pause(gs_handle(gs_audio_instance_t) inst);
 GS_API_DECL void     gs_audio_stop(gs_handle(gs_audio_instance_t) inst);
 GS_API_DECL void     gs_audio_restart(gs_handle(gs_audio_instance_t) inst);
 GS_API_DECL bool32_t gs_audio_is_playing(gs_handle(gs_audio_instance_t) inst);
+GS_API_DECL gs_audio_voice_stats_t gs_audio_get_voice_stats();
+
+/* Audio spatialization */
+GS_API_DECL void     gs_audio_set_listener(gs_vqs transform, gs_vec3 velocity);
+GS_API_DECL void     gs_audio_set_position(gs_handle(gs_audio_instance_t) inst, gs_vec3 position, gs_vec3 velocity);  // Spatial instances only
+
+/* Audio buses */
+GS_API_DECL uint32_t gs_audio_bus_create(const char* name, uint32_t parent);   // GS_AUDIO_BUS_INVALID once GS_AUDIO_MAX_BUSES exist
+GS_API_DECL uint32_t gs_audio_bus_find(const char* name);
+GS_API_DECL void     gs_audio_bus_set_volume(uint32_t bus, float volume);
+GS_API_DECL float    gs_audio_bus_get_volume(uint32_t bus);
+GS_API_DECL void     gs_audio_bus_set_effect(uint32_t bus, uint32_t slot, const gs_audio_effect_desc_t* effect);  // NULL clears the slot
 
 /* Audio instance data */
 GS_API_DECL void                     gs_audio_set_instance_data(gs_handle(gs_audio_instance_t) inst, gs_audio_instance_decl_t decl);
@@ -4165,6 +4687,7 @@ GS_API_DECL bool32_t gs_audio_load_mp3_data_from_file(const char* file_path, int
     #define gsa_init     gs_audio_init
     #define gsa_shutdown gs_audio_shutdown
     #define gsa_submit   gs_audio_submit
+    #define gsa_update   gs_audio_update
     /* Source */
     #define gsa_load     gs_audio_load_from_file            
     /* Instance */
@@ -4301,7 +4824,12 @@ gs_enum_decl(gs_graphics_vertex_attribute_type,
     GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE4,
     GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE3,
     GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE2,
-    GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE
+    GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE,
+    GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF4,             // 16 bit floats
+    GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF2,
+    GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT4N,           // Signed normalized 16 bit, read as [-1, 1]
+    GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT2N,
+    GS_GRAPHICS_VERTEX_ATTRIBUTE_INT_10_10_10_2N    // Packed signed normalized xyz 10 bits, w 2 bits (x in low bits)
 );
 
 /* Buffer Type */
@@ -4341,9 +4869,17 @@ gs_enum_decl(gs_graphics_texture_format_type,
     GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F,
     GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24_STENCIL8,
     GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F_STENCIL8,
-    GS_GRAPHICS_TEXTURE_FORMAT_STENCIL8
+    GS_GRAPHICS_TEXTURE_FORMAT_STENCIL8,
+    GS_GRAPHICS_TEXTURE_FORMAT_BC1,     // Block compressed (4x4 texel blocks), rgb + 1 bit alpha, 8 bytes per block
+    GS_GRAPHICS_TEXTURE_FORMAT_BC3,     // rgba, 16 bytes per block
+    GS_GRAPHICS_TEXTURE_FORMAT_BC5,     // rg (normal maps), 16 bytes per block
+    GS_GRAPHICS_TEXTURE_FORMAT_BC7      // rgba high quality, 16 bytes per block
 );
 
+#ifndef GS_GRAPHICS_TEXTURE_MAX_MIPS
+    #define GS_GRAPHICS_TEXTURE_MAX_MIPS 16
+#endif
+
 /* Texture Wrapping */
 gs_enum_decl(gs_graphics_texture_wrapping_type,
     GS_GRAPHICS_TEXTURE_WRAP_REPEAT,
@@ -4442,6 +4978,15 @@ typedef struct gs_graphics_shader_desc_t
     const char* name;               // Optional (for logging and debugging mainly)
 } gs_graphics_shader_desc_t;
 
+/* Graphics Texture Update Desc */
+typedef struct gs_graphics_texture_update_desc_t
+{
+    uint32_t x;                                     // Region x offset in pixels
+    uint32_t y;                                     // Region y offset in pixels
+    uint32_t width;                                 // Region width in pixels (0 for full width)
+    uint32_t height;                                // Region height in pixels (0 for full height)
+} gs_graphics_texture_update_desc_t;
+
 /* Graphics Texture Desc */
 typedef struct gs_graphics_texture_desc_t
 {
@@ -4453,9 +4998,13 @@ typedef struct gs_graphics_texture_desc_t
     gs_graphics_texture_filtering_type min_filter;  // Minification filter for texture
     gs_graphics_texture_filtering_type mag_filter;  // Magnification filter for texture
     gs_graphics_texture_filtering_type mip_filter;  // Mip filter for texture
-    uint32_t num_mips;                              // Number of mips to generate (default 0 is disable mip generation)
+    uint32_t num_mips;                              // Number of levels below base to generate, clamped to full chain (default 0 is disable mip generation)
+    float max_anisotropy;                           // Anisotropic filtering samples, clamped to device max (default 0 is disabled)
+    uint32_t base_level;                            // Finest level to allocate, finer prebuilt levels stay unallocated (streaming, default 0)
     void* data;                                     // Texture data to upload (can be null)
+    void* mip_data[GS_GRAPHICS_TEXTURE_MAX_MIPS];   // Optional prebuilt levels 1..n (level 0 is data), NULL terminated, uploaded instead of generated
     b32 render_target;                              // Default to false (not a render target)
+    gs_graphics_texture_update_desc_t update;       // Region for in-flight updates, data holds only region pixels (default full texture)
 } gs_graphics_texture_desc_t;
 
 /* Graphics Uniform Layout Desc */
@@ -4713,6 +5262,7 @@ typedef struct gs_graphics_info_t
         uint32_t max_work_group_size[3];
         uint32_t max_work_group_invocations;
     } compute;
+    float max_anisotropy;       // 0 if anisotropic filtering isn't supported
 } gs_graphics_info_t;
 
 /*==========================
@@ -4751,16 +5301,26 @@ GS_API_DECL gs_handle(gs_graphics_pipeline_t)       gs_graphics_pipeline_create(
 
 /* Resource Destruction */
 GS_API_DECL void gs_graphics_texture_destroy(gs_handle(gs_graphics_texture_t) hndl);
+GS_API_DECL void gs_graphics_vertex_buffer_destroy(gs_handle(gs_graphics_vertex_buffer_t) hndl);
+GS_API_DECL void gs_graphics_index_buffer_destroy(gs_handle(gs_graphics_index_buffer_t) hndl);
 GS_API_DECL void gs_graphics_shader_destroy(gs_handle(gs_graphics_shader_t) hndl);
 GS_API_DECL void gs_graphics_render_pass_destroy(gs_handle(gs_graphics_render_pass_t) hndl);
 GS_API_DECL void gs_graphics_pipeline_destroy(gs_handle(gs_graphics_pipeline_t) hndl);
 
+/* Resource Residency */
+// Makes levels from base_level down resident, uploading newly resident levels from levels->data/mip_data and releasing evicted ones
+GS_API_DECL void gs_graphics_texture_set_base_level(gs_handle(gs_graphics_texture_t) hndl, uint32_t base_level, const gs_graphics_texture_desc_t* levels);
+
 /* Resource In-Flight Update*/
 GS_API_DECL void gs_graphics_texture_request_update(gs_command_buffer_t* cb, gs_handle(gs_graphics_texture_t) hndl, gs_graphics_texture_desc_t* desc);
 GS_API_DECL void gs_graphics_vertex_buffer_request_update(gs_command_buffer_t* cb, gs_handle(gs_graphics_vertex_buffer_t) hndl, gs_graphics_vertex_buffer_desc_t* desc);
 GS_API_DECL void gs_graphics_index_buffer_request_update(gs_command_buffer_t* cb, gs_handle(gs_graphics_index_buffer_t) hndl, gs_graphics_index_buffer_desc_t* desc);
 GS_API_DECL void gs_graphics_uniform_buffer_request_update(gs_command_buffer_t* cb, gs_handle(gs_graphics_uniform_buffer_t) hndl, gs_graphics_uniform_buffer_desc_t* desc);
 
+/* Texture Format Util */
+GS_API_DECL bool32_t gs_graphics_texture_format_is_compressed(gs_graphics_texture_format_type format);
+GS_API_DECL size_t   gs_graphics_texture_level_size(gs_graphics_texture_format_type format, uint32_t width, uint32_t height);   // Bytes of one mip level
+
 /* Pipeline / Pass / Bind / Draw */
 GS_API_DECL void gs_graphics_begin_render_pass(gs_command_buffer_t* cb, gs_handle(gs_graphics_render_pass_t) hndl);
 GS_API_DECL void gs_graphics_end_render_pass(gs_command_buffer_t* cb);
@@ -4797,6 +5357,61 @@ typedef struct gs_asset_texture_t
 
 GS_API_DECL void gs_asset_texture_load_from_file(const char* path, void* out, gs_graphics_texture_desc_t* desc, bool32_t flip_on_load, bool32_t keep_data);
 
+/*
+    Staged loading (used by async asset loads): 
+        * decode_from_file reads and decodes on any thread, makes no graphics calls
+        * upload finishes the asset on the main thread, consuming the staging data from decode
+*/
+
+/*
+    Mip chains are built on the cpu (rgba8) at decode/cook time, so the driver thread never runs glGenerateMipmap 
+    for imported textures
+*/
+
+gs_enum_decl(gs_asset_texture_mip_filter_type,
+    GS_ASSET_TEXTURE_MIP_FILTER_BOX,    // 2x2 average
+    GS_ASSET_TEXTURE_MIP_FILTER_KAISER  // Kaiser windowed sinc, keeps minified detail sharper without aliasing
+);
+
+typedef struct gs_asset_texture_mip_desc_t
+{
+    gs_asset_texture_mip_filter_type filter;    // Default box
+    bool32_t srgb;                              // Color is srgb encoded, filtered in linear space (alpha is always linear)
+} gs_asset_texture_mip_desc_t;
+
+// Builds levels 1..num_mips (clamped to full chain and GS_GRAPHICS_TEXTURE_MAX_MIPS) into mip_data, returns number of levels built.
+// All levels share one allocation owned by mip_data[0] (release with gs_free(mip_data[0])).
+GS_API_DECL uint32_t gs_asset_texture_generate_mips(const void* rgba8, uint32_t width, uint32_t height, uint32_t num_mips, const gs_asset_texture_mip_desc_t* desc, void** mip_data);
+
+typedef struct gs_asset_texture_load_opts_t
+{
+    gs_graphics_texture_desc_t desc;    // Used as is (rgba8 and nearest filtering are both 0)
+    bool32_t default_desc;              // Ignore desc for rgba8, linear filtering, repeat wrapping, as with NULL opts
+    bool32_t flip_on_load;
+    bool32_t keep_data;
+    gs_asset_texture_mip_desc_t mips;   // Used when desc.num_mips is set
+} gs_asset_texture_load_opts_t;
+
+GS_API_DECL bool32_t gs_asset_texture_decode_from_file(const char* path, void* out, const gs_asset_texture_load_opts_t* opts, void** staging);
+GS_API_DECL void     gs_asset_texture_upload(void* out, const gs_asset_texture_load_opts_t* opts, void* staging);
+GS_API_DECL void     gs_asset_texture_discard(void* out, const gs_asset_texture_load_opts_t* opts, void* staging);  // Releases a decode that won't be uploaded
+GS_API_DECL void     gs_asset_texture_free(gs_asset_texture_t* t);  // Destroys the gpu texture, data kept on load is left to the caller
+
+/*
+    Cooked textures: block compressed offline into a .dds with its full mip chain, 
+    loaded by the importer as is (no decode, no mip generation at runtime)
+*/
+
+typedef struct gs_asset_texture_cook_desc_t
+{
+    gs_graphics_texture_format_type format; // BC1, BC3, BC5 or RGBA8 (default BC3)
+    bool32_t flip_on_load;
+    bool32_t no_mips;                       // Write level 0 only
+    gs_asset_texture_mip_desc_t mips;
+} gs_asset_texture_cook_desc_t;
+
+GS_API_DECL gs_result gs_asset_texture_cook(const char* src_path, const char* out_path, const gs_asset_texture_cook_desc_t* desc);
+
 // Font
 typedef struct gs_baked_char_t
 {
@@ -4813,6 +5428,82 @@ typedef struct gs_asset_font_t
 
 GS_API_DECL void gs_asset_font_load_from_file(const char* path, void* out, uint32_t point_size);
 
+typedef struct gs_asset_font_load_opts_t
+{
+    uint32_t point_size;
+} gs_asset_font_load_opts_t;
+
+GS_API_DECL bool32_t gs_asset_font_decode_from_file(const char* path, void* out, const gs_asset_font_load_opts_t* opts, void** staging);
+GS_API_DECL void     gs_asset_font_upload(void* out, const gs_asset_font_load_opts_t* opts, void* staging);
+GS_API_DECL void     gs_asset_font_discard(void* out, const gs_asset_font_load_opts_t* opts, void* staging);
+GS_API_DECL void     gs_asset_font_free(gs_asset_font_t* f);
+
+// SDF Font (distance fields rendered on demand into a paged atlas, any codepoint, any scale)
+#ifndef GS_SDF_FONT_BASE_SIZE
+    #define GS_SDF_FONT_BASE_SIZE 32.f  // Pixel height glyph fields are rendered at
+#endif
+
+#ifndef GS_SDF_FONT_PADDING
+    #define GS_SDF_FONT_PADDING 4       // Field range in pixels around each glyph
+#endif
+
+#ifndef GS_SDF_FONT_PAGE_SIZE
+    #define GS_SDF_FONT_PAGE_SIZE 512
+#endif
+
+#ifndef GS_SDF_FONT_MAX_PAGES
+    #define GS_SDF_FONT_MAX_PAGES 4
+#endif
+
+typedef struct gs_sdf_glyph_t
+{
+    u16 x0, y0, x1, y1;         // Atlas rect in pixels (empty for blank glyphs)
+    f32 xoff, yoff, xadvance;   // In pixels at base size
+    u16 page;
+    u16 generation;             // Page generation glyph was packed in, stale once page is evicted
+    b32 valid;                  // Metrics loaded
+} gs_sdf_glyph_t;
+
+typedef struct gs_sdf_font_shelf_t
+{
+    u16 x, y, h;
+} gs_sdf_font_shelf_t;
+
+typedef struct gs_sdf_font_page_t
+{
+    gs_handle(gs_graphics_texture_t) texture;
+    gs_dyn_array(gs_sdf_font_shelf_t) shelves;
+    u32 top;                    // First row not covered by a shelf
+    u64 tick;                   // Last use, for LRU eviction
+    u16 generation;
+} gs_sdf_font_page_t;
+
+typedef struct gs_asset_sdf_font_t
+{
+    void* font_info;
+    void* ttf;
+    f32 base_size;
+    f32 scale;                  // Font units to pixels at base size
+    f32 ascent, descent, line_gap;
+    u32 padding;
+    u32 page_size;
+    u32 max_pages;
+    u64 tick;
+    gs_dyn_array(gs_sdf_font_page_t) pages;
+    gs_sdf_glyph_t ascii[128];
+    gs_hash_table(u32, gs_sdf_glyph_t) glyphs;
+} gs_asset_sdf_font_t;
+
+GS_API_DECL void gs_asset_sdf_font_load_from_file(const char* path, void* out);
+GS_API_DECL bool32_t gs_asset_sdf_font_decode_from_file(const char* path, void* out, const void* opts, void** staging);
+GS_API_DECL void gs_asset_sdf_font_upload(void* out, const void* opts, void* staging);
+GS_API_DECL void gs_asset_sdf_font_discard(void* out, const void* opts, void* staging);
+GS_API_DECL void gs_asset_sdf_font_free(gs_asset_sdf_font_t* f);
+// Returns glyph if resident in atlas (NULL otherwise). Pointer is valid until next cache call.
+GS_API_DECL const gs_sdf_glyph_t* gs_asset_sdf_font_find_glyph(gs_asset_sdf_font_t* f, uint32_t codepoint);
+// Makes glyph resident, queueing its atlas upload into cb. May evict least recently used page (main thread only).
+GS_API_DECL const gs_sdf_glyph_t* gs_asset_sdf_font_cache_glyph(gs_asset_sdf_font_t* f, gs_command_buffer_t* cb, uint32_t codepoint);
+
 // Audio
 typedef struct gs_asset_audio_t
 {
@@ -4820,6 +5511,9 @@ typedef struct gs_asset_audio_t
 } gs_asset_audio_t;
 
 GS_API_DECL void gs_asset_audio_load_from_file(const char* path, void* out);
+GS_API_DECL bool32_t gs_asset_audio_decode_from_file(const char* path, void* out, const void* opts, void** staging);
+GS_API_DECL void gs_asset_audio_upload(void* out, const void* opts, void* staging);
+GS_API_DECL void gs_asset_audio_discard(void* out, const void* opts, void* staging);
 
 // Mesh
 gs_enum_decl(gs_asset_mesh_attribute_type,
@@ -4837,18 +5531,73 @@ typedef struct gs_asset_mesh_layout_t {
     uint32_t idx;                          // Optional index (for joint/weight/texcoord/color)
 } gs_asset_mesh_layout_t;
 
+/* Mesh optimization passes, run in order: weld -> vertex cache -> overdraw -> vertex fetch */
+gs_enum_decl(gs_asset_mesh_optimize_flag,
+    GS_ASSET_MESH_OPTIMIZE_WELD = 0x01,             // Merge bitwise identical vertices
+    GS_ASSET_MESH_OPTIMIZE_VERTEX_CACHE = 0x02,     // Reorder triangles for the post transform vertex cache (Tipsify)
+    GS_ASSET_MESH_OPTIMIZE_OVERDRAW = 0x04,         // Sort vertex cache clusters outside in (needs position attribute)
+    GS_ASSET_MESH_OPTIMIZE_VERTEX_FETCH = 0x08      // Reorder vertices by first use, drop unreferenced vertices
+);
+
+#define GS_ASSET_MESH_OPTIMIZE_ALL\
+    (GS_ASSET_MESH_OPTIMIZE_WELD | GS_ASSET_MESH_OPTIMIZE_VERTEX_CACHE | GS_ASSET_MESH_OPTIMIZE_OVERDRAW | GS_ASSET_MESH_OPTIMIZE_VERTEX_FETCH)
+
+#ifndef GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE
+    #define GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE 16    // Post transform cache entries targeted by vertex cache pass
+#endif
+
 typedef struct gs_asset_mesh_decl_t
 {
     gs_asset_mesh_layout_t* layout;        // Mesh attribute layout array
     size_t layout_size;                    // Size of mesh attribute layout array in bytes
     size_t index_buffer_element_size;      // Size of index data size in bytes
+    uint32_t optimize;                     // gs_asset_mesh_optimize_flag mask, applied on load and cook (requires layout)
+    uint32_t lod_count;                    // Simplified levels generated past full detail, on load and cook (requires layout)
+    float lod_ratio;                       // Fraction of triangles kept per level (default 0.5)
+    bool32_t quantize;                     // Compact vertex formats on load and cook, see gs_asset_mesh_attribute_format (requires layout)
 } gs_asset_mesh_decl_t;
 
+// Quantized position = a_position.xyz * scale + offset, identity for float positions
+typedef struct gs_asset_mesh_dequant_t
+{
+    gs_vec3 offset;
+    gs_vec3 scale;
+} gs_asset_mesh_dequant_t;
+
+#ifndef GS_ASSET_MESH_MAX_STREAMS
+    #define GS_ASSET_MESH_MAX_STREAMS 8
+#endif
+
+#ifndef GS_ASSET_MESH_MAX_LODS
+    #define GS_ASSET_MESH_MAX_LODS 6
+#endif
+
+// Max projected simplification error in pixels before selecting a finer level
+#ifndef GS_ASSET_MESH_LOD_PIXEL_ERROR
+    #define GS_ASSET_MESH_LOD_PIXEL_ERROR 1.f
+#endif
+
+// All levels of a primitive share its vbo and live back to back in its ibo
+typedef struct gs_asset_mesh_lod_t
+{
+    uint32_t start;     // Byte offset of first index in ibo (draw desc start)
+    uint32_t count;     // Index count
+    float error;        // Simplification error, relative to primitive bounding radius
+} gs_asset_mesh_lod_t;
+
 typedef struct gs_asset_mesh_primitive_t
 {
     gs_handle(gs_graphics_vertex_buffer_t) vbo;
     gs_handle(gs_graphics_index_buffer_t) ibo;
     uint32_t count; 
+    uint32_t vertex_count;
+    // Non interleaved (cooked soa) data: byte offset of each layout attribute's stream in vbo, 
+    // bind each with GS_GRAPHICS_VERTEX_DATA_NONINTERLEAVED at its offset. Zero streams for interleaved data.
+    uint32_t stream_count;
+    size_t stream_offsets[GS_ASSET_MESH_MAX_STREAMS];
+    uint32_t lod_count;                                 // Always >= 1, lods[0] is full detail
+    gs_asset_mesh_lod_t lods[GS_ASSET_MESH_MAX_LODS];
+    gs_asset_mesh_dequant_t dequant;
 } gs_asset_mesh_primitive_t;
 
 typedef struct gs_asset_mesh_t
@@ -4864,10 +5613,111 @@ typedef struct gs_asset_mesh_raw_data_t
     size_t* index_sizes;
     void** vertices;
     void** indices;
+    uint32_t* lod_counts;           // Per primitive level count, NULL until lods generated
+    gs_asset_mesh_lod_t* lods;      // prim_count * GS_ASSET_MESH_MAX_LODS, index data appended to indices
+    gs_asset_mesh_dequant_t* dequant;   // Per primitive, NULL until quantized
 } gs_asset_mesh_raw_data_t;
 
 GS_API_DECL void gs_asset_mesh_load_from_file(const char* path, void* out, gs_asset_mesh_decl_t* decl, void* data_out, size_t data_size);
 
+typedef struct gs_asset_mesh_load_opts_t
+{
+    gs_asset_mesh_decl_t decl;  // Layout array is referenced, not copied, so must outlive the load
+} gs_asset_mesh_load_opts_t;
+
+GS_API_DECL bool32_t gs_asset_mesh_decode_from_file(const char* path, void* out, const gs_asset_mesh_load_opts_t* opts, void** staging);
+GS_API_DECL void     gs_asset_mesh_upload(void* out, const gs_asset_mesh_load_opts_t* opts, void* staging);
+GS_API_DECL void     gs_asset_mesh_discard(void* out, const gs_asset_mesh_load_opts_t* opts, void* staging);
+GS_API_DECL void     gs_asset_mesh_free(gs_asset_mesh_t* mesh);
+
+/*
+    Cooked meshes (.gsm): vertex/index data baked offline for one mesh decl, loaded by gs_asset_mesh_load_from_file
+    straight from a file map (no parsing or conversion, the upload is the only copy).
+
+        header | layout | primitive table | blobs (each aligned to GS_ASSET_MESH_COOK_ALIGNMENT)
+*/
+
+#define GS_ASSET_MESH_COOK_MAGIC        0x4d534747  // 'GGSM'
+#define GS_ASSET_MESH_COOK_VERSION      3
+#define GS_ASSET_MESH_COOK_ALIGNMENT    16
+
+typedef struct gs_asset_mesh_cook_desc_t
+{
+    gs_asset_mesh_decl_t decl;  // Layout to bake (required) and index element size (2 or 4, default 2)
+    bool32_t non_interleaved;   // Write one stream per layout attribute (soa) instead of interleaved vertices
+} gs_asset_mesh_cook_desc_t;
+
+typedef struct gs_asset_mesh_cook_header_t
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t non_interleaved;
+    uint32_t index_element_size;
+    uint32_t prim_count;
+    uint32_t layout_count;      // Followed by layout_count gs_asset_mesh_layout_t
+    uint32_t quantized;
+} gs_asset_mesh_cook_header_t;
+
+typedef struct gs_asset_mesh_cook_primitive_t
+{
+    uint64_t vertex_offset;
+    uint64_t vertex_size;
+    uint64_t index_offset;
+    uint64_t index_size;
+    uint32_t vertex_count;
+    uint32_t index_count;       // Full detail index count
+    uint32_t lod_count;
+    gs_asset_mesh_lod_t lods[GS_ASSET_MESH_MAX_LODS];
+    gs_asset_mesh_dequant_t dequant;
+} gs_asset_mesh_cook_primitive_t;
+
+GS_API_DECL gs_result gs_asset_mesh_cook(const char* src_path, const char* out_path, const gs_asset_mesh_cook_desc_t* desc);
+GS_API_DECL void      gs_asset_mesh_optimize(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count, const gs_asset_mesh_decl_t* decl, uint32_t flags);
+GS_API_DECL void      gs_asset_mesh_generate_lods(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count, const gs_asset_mesh_decl_t* decl);
+
+typedef struct gs_asset_mesh_lod_select_t
+{
+    uint32_t lod;       // Level to draw
+    uint32_t fade_lod;  // Coarser level to cross fade to when fade > 0
+    float fade;         // [0, 1], share of fade_lod, split pixels with GS_ASSET_MESH_LOD_DITHER_GLSL
+} gs_asset_mesh_lod_select_t;
+
+// Pick coarsest level whose error projects under GS_ASSET_MESH_LOD_PIXEL_ERROR for a world space bounding sphere.
+// fade_band > 0 starts cross fading once the next level's error is within fade_band * threshold of it.
+GS_API_DECL gs_asset_mesh_lod_select_t gs_asset_mesh_lod_select(const gs_asset_mesh_primitive_t* prim, gs_camera_t* cam, 
+    gs_vec3 center, float radius, int32_t view_height, float fade_band);
+
+/*
+    Dithered cross fade: draw sel.lod with gs_lod_dither_discard(1.0 - sel.fade, false) and sel.fade_lod with 
+    gs_lod_dither_discard(1.0 - sel.fade, true), both draws cover complementary pixels of a 4x4 pattern.
+*/
+#define GS_ASSET_MESH_LOD_DITHER_GLSL\
+    "bool gs_lod_dither_discard(float keep, bool complement)\n"\
+    "{\n"\
+    "    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);\n"\
+    "    ivec2 p = ivec2(gl_FragCoord.xy) & 3;\n"\
+    "    bool in_keep = (bayer[p.y * 4 + p.x] + 0.5) / 16.0 < keep;\n"\
+    "    return complement ? in_keep : !in_keep;\n"\
+    "}\n"
+GS_API_DECL size_t    gs_asset_mesh_attribute_size(gs_asset_mesh_attribute_type type, bool32_t quantized);  // Bytes per vertex as written by mesh loader
+GS_API_DECL gs_graphics_vertex_attribute_type gs_asset_mesh_attribute_format(gs_asset_mesh_attribute_type type, bool32_t quantized);
+
+/*
+    Quantized formats: position SHORT4N (dequant per primitive), normal SHORT2N octahedral (decode with 
+    GS_ASSET_MESH_OCT_DECODE_GLSL), tangent INT_10_10_10_2N, texcoord HALF2, color BYTE4. 
+    Runs after optimization and lod generation, which work on float data.
+*/
+GS_API_DECL void      gs_asset_mesh_quantize(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count, const gs_asset_mesh_decl_t* decl);
+
+#define GS_ASSET_MESH_OCT_DECODE_GLSL\
+    "vec3 gs_oct_decode(vec2 e)\n"\
+    "{\n"\
+    "    vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));\n"\
+    "    float t = max(-n.z, 0.0);\n"\
+    "    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);\n"\
+    "    return normalize(n);\n"\
+    "}\n"
+
 GS_API_DECL void gs_util_load_gltf_data_from_file(const char* path, gs_asset_mesh_decl_t* decl, gs_asset_mesh_raw_data_t** out, uint32_t* mesh_count);
 
 /*
@@ -4897,11 +5747,14 @@ typedef struct gs_app_desc_t
     void (* init)();
     void (* update)();
     void (* shutdown)();
+    void (* fixed_update)();    // Called at fixed_rate, zero or more times per frame, before update
     const char* window_title;
     uint32_t window_width;
     uint32_t window_height;
     uint32_t window_flags;
     float frame_rate;
+    float fixed_rate;           // Simulation rate in hz for fixed_update (default 60)
+    uint32_t max_fixed_steps;   // Cap on fixed steps per frame, excess time is dropped (default 8)
     bool32 enable_vsync;
     bool32 is_running;
     void* user_data;
@@ -5280,6 +6133,10 @@ void gs_camera_offset_orientation(gs_camera_t* cam, f32 yaw, f32 pitch)
     #define STB_IMAGE_WRITE_IMPLEMENTATION
 #endif
 
+#ifndef GS_NO_STB_DXT
+    #define STB_DXT_IMPLEMENTATION
+#endif
+
 #ifndef GS_NO_CGLTF
     #define CGLTF_IMPLEMENTATION
 #endif
@@ -5290,479 +6147,2957 @@ void gs_camera_offset_orientation(gs_camera_t* cam, f32 yaw, f32 pitch)
 #include "external/stb/stb_truetype.h"
 #include "external/stb/stb_image.h"
 
+// stb__CompressAlphaBlock takes a mode it never reads
+#if (defined __GNUC__ || defined __clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#endif
+#include "external/stb/stb_dxt.h"
+#if (defined __GNUC__ || defined __clang__)
+#pragma GCC diagnostic pop
+#endif
+
 // CGLTF
 #include "external/cgltf/cgltf.h"
 
 bool32_t gs_util_load_texture_data_from_file(const char* file_path, int32_t* width, int32_t* height, uint32_t* num_comps, void** data, bool32_t flip_vertically_on_load)
 {
-    // Load texture data
-    stbi_set_flip_vertically_on_load(flip_vertically_on_load);
-
-    // NOTE(john): For now, this data will always have 4 components, since STBI_rgb_alpha is being passed in as required components param. Could optimize this later.
-    *data = stbi_load(file_path, (s32*)width, (s32*)height, (s32*)num_comps, STBI_rgb_alpha);
+    // Read through file view so textures packed into mounted paks decode straight from the map
+    gs_platform_file_view_t view = gs_default_val();
+    *data = NULL;
+    if (gs_platform_file_view_open(file_path, &view)) {
+        // NOTE(john): For now, this data will always have 4 components, since STBI_rgb_alpha is being passed in as required components param. Could optimize this later.
+        *data = stbi_load_from_memory((const stbi_uc*)view.data, (int)view.size, (s32*)width, (s32*)height, (s32*)num_comps, STBI_rgb_alpha);
+        gs_platform_file_view_close(&view);
+    }
 
     if (!*data) {
         gs_println("Warning: could not load texture: %s", file_path);
         return false;
     }
 
+    // Flip rows here rather than through stbi's global flip flag, so loads can run on multiple threads
+    if (flip_vertically_on_load)
+    {
+        const size_t row = (size_t)(*width) * 4;
+        u8* pixels = (u8*)(*data);
+        u8* tmp = (u8*)gs_malloc(row);
+        for (int32_t y = 0; y < *height / 2; ++y)
+        {
+            u8* top = pixels + (size_t)y * row;
+            u8* bot = pixels + (size_t)(*height - 1 - y) * row;
+            memcpy(tmp, top, row);
+            memcpy(top, bot, row);
+            memcpy(bot, tmp, row);
+        }
+        gs_free(tmp);
+    }
+
     return true;
 }
 
 /*=============================
-// GS_PLATFORM
+// GS_PAK
 =============================*/
 
-#ifndef GS_PLATFORM_IMPL_CUSTOM
-    #define GS_PLATFORM_IMPL_GLFW
-    #include "impl/gs_platform_impl.h"
-#endif
+#define __gs_pak_align(N) (((N) + (GS_PAK_ALIGNMENT - 1)) & ~((uint64_t)GS_PAK_ALIGNMENT - 1))
 
-/*=============================
-// GS_GRAPHICS
-=============================*/
+// Normalize separators and strip leading "./" so "./assets/a.png" and "assets\a.png" match
+void __gs_pak_normalize_path(const char* path, char* buffer, size_t buffer_size)
+{
+    while (path[0] == '.' && (path[1] == '/' || path[1] == '\\')) path += 2;
+    size_t i = 0;
+    for (; path[i] && i < buffer_size - 1; ++i) {
+        buffer[i] = path[i] == '\\' ? '/' : path[i];
+    }
+    buffer[i] = '\0';
+}
 
-#ifndef GS_GRAPHICS_IMPL_CUSTOM
-    #define GS_GRAPHICS_IMPL_OPENGL
-    #include "impl/gs_graphics_impl.h"
-#endif
+uint64_t gs_pak_hash_path(const char* path)
+{
+    char buffer[1024];
+    __gs_pak_normalize_path(path, buffer, sizeof(buffer));
+    return gs_hash_str64(buffer);
+}
 
-/*=============================
-// GS_AUDIO
-=============================*/
+bool32_t gs_pak_open(gs_pak_t* pak, const char* path)
+{
+    memset(pak, 0, sizeof(gs_pak_t));
 
-#ifndef GS_AUDIO_IMPL_CUSTOM
-    #define GS_AUDIO_IMPL_MINIAUDIO
-    #include "impl/gs_audio_impl.h"
-#endif
+    size_t sz = 0;
+    const uint8_t* data = (const uint8_t*)gs_platform_file_map(path, &sz);
+    if (!data) {
+        gs_println("Warning: could not open pak: %s", path);
+        return false;
+    }
 
-/*==========================
-// GS_ASSET_TYPES
-==========================*/
+    // Everything read later is bounds checked here once, written so corrupt values can't overflow the checks
+    const gs_pak_header_t* hdr = (const gs_pak_header_t*)data;
+    bool32_t valid = sz >= sizeof(gs_pak_header_t) && hdr->magic == GS_PAK_MAGIC && hdr->version == GS_PAK_VERSION &&
+        hdr->names_offset <= sz && hdr->index_offset <= hdr->names_offset && hdr->index_offset % sizeof(uint64_t) == 0 &&
+        (uint64_t)hdr->entry_count <= (hdr->names_offset - hdr->index_offset) / sizeof(gs_pak_entry_t);
 
-void gs_asset_texture_load_from_file(const char* path, void* out, gs_graphics_texture_desc_t* desc, bool32_t flip_on_load, bool32_t keep_data)
+    const gs_pak_entry_t* entries = (const gs_pak_entry_t*)(data + (valid ? hdr->index_offset : 0));
+    const uint64_t names_size = valid ? sz - hdr->names_offset : 0;
+    for (uint32_t i = 0; valid && i < hdr->entry_count; ++i)
+    {
+        const gs_pak_entry_t* e = &entries[i];
+        valid = e->offset <= sz && e->size <= sz - e->offset && 
+            e->name_offset < names_size && memchr(data + hdr->names_offset + e->name_offset, 0, (size_t)(names_size - e->name_offset));
+
+        // Compressed sizes go through the int32 lz4 interface, and decompression adds a terminator
+        if (e->compression == GS_PAK_COMPRESSION_LZ4) {
+            valid = valid && e->size <= INT32_MAX && e->raw_size < INT32_MAX;
+        } else {
+            valid = valid && e->compression == GS_PAK_COMPRESSION_NONE;
+        }
+    }
+
+    if (!valid) {
+        gs_println("Warning: invalid pak: %s", path);
+        gs_platform_file_unmap((void*)data, sz);
+        return false;
+    }
+
+    pak->data = data;
+    pak->size = sz;
+    pak->header = hdr;
+    pak->entries = (const gs_pak_entry_t*)(data + hdr->index_offset);
+    pak->names = (const char*)(data + hdr->names_offset);
+
+    return true;
+}
+
+void gs_pak_close(gs_pak_t* pak)
 {
-    gs_asset_texture_t* t = (gs_asset_texture_t*)out; 
+    if (pak->data) gs_platform_file_unmap((void*)pak->data, pak->size);
+    memset(pak, 0, sizeof(gs_pak_t));
+}
 
-    memset(&t->desc, 0, sizeof(gs_graphics_texture_desc_t));
+const gs_pak_entry_t* gs_pak_find(const gs_pak_t* pak, const char* path)
+{
+    if (!pak->data) return NULL;
 
-    if (desc) {
-        t->desc = *desc;
-    } else {
-        t->desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
-        t->desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
-        t->desc.mag_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR; 
-        t->desc.wrap_s = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
-        t->desc.wrap_t = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
-    }
+    char name[1024];
+    __gs_pak_normalize_path(path, name, sizeof(name));
+    uint64_t hash = gs_hash_str64(name);
 
-    // Load texture data
-    int32_t num_comps = 0;
-    bool32_t loaded = gs_util_load_texture_data_from_file(path, (int32_t*)&t->desc.width, 
-        (int32_t*)&t->desc.height, (uint32_t*)&num_comps, (void**)&t->desc.data, flip_on_load);
+    // Lower bound on hash, then compare names across any collisions
+    uint32_t lo = 0, hi = pak->header->entry_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (pak->entries[mid].hash < hash) lo = mid + 1;
+        else hi = mid;
+    }
 
-    if (!loaded) {
-        gs_println("Warning: could not load texture: %s", path);
-        return;
+    for (; lo < pak->header->entry_count && pak->entries[lo].hash == hash; ++lo) {
+        if (gs_string_compare_equal((char*)(pak->names + pak->entries[lo].name_offset), name)) {
+            return &pak->entries[lo];
+        }
     }
 
-    t->hndl = gs_graphics_texture_create(&t->desc);
+    return NULL;
+}
 
-    if (!keep_data) {
-        gs_free(t->desc.data);
-        t->desc.data = NULL;
+bool32_t gs_pak_read(const gs_pak_t* pak, const gs_pak_entry_t* entry, gs_platform_file_view_t* view)
+{
+    memset(view, 0, sizeof(gs_platform_file_view_t));
+    if (entry->offset > pak->size || entry->size > pak->size - entry->offset) return false;
+
+    const uint8_t* blob = pak->data + entry->offset;
+
+    switch (entry->compression)
+    {
+        case GS_PAK_COMPRESSION_LZ4:
+        {
+            // Extra null byte so text assets can be treated as strings
+            if (entry->size > INT32_MAX || entry->raw_size > INT32_MAX) return false;
+            uint8_t* buffer = (uint8_t*)gs_malloc((size_t)entry->raw_size + 1);
+            int32_t n = gs_lz4_decompress(blob, (int32_t)entry->size, buffer, (int32_t)entry->raw_size);
+            if (n != (int32_t)entry->raw_size) {
+                gs_free(buffer);
+                return false;
+            }
+            buffer[entry->raw_size] = 0;
+            view->data = buffer;
+            view->alloc = buffer;
+            view->size = (size_t)entry->raw_size;
+        } break;
+
+        default:
+        {
+            // Paks not built with the null after each blob get a terminated copy instead
+            view->size = (size_t)entry->size;
+            if (entry->size < pak->size - entry->offset && !blob[entry->size]) {
+                view->data = blob;
+            } else {
+                uint8_t* buffer = (uint8_t*)gs_malloc(view->size + 1);
+                memcpy(buffer, blob, view->size);
+                buffer[view->size] = 0;
+                view->data = buffer;
+                view->alloc = buffer;
+            }
+        } break;
     }
+
+    return true;
 }
 
-void gs_asset_font_load_from_file(const char* path, void* out, uint32_t point_size)
-{ 
-    gs_asset_font_t* f = (gs_asset_font_t*)out;
+typedef struct __gs_pak_build_entry_t
+{
+    gs_pak_entry_t entry;
+    char name[1024];
+    uint8_t* data;
+} __gs_pak_build_entry_t;
 
-    if (!point_size) {
-        gs_println("Warning: Font: %s: Point size not declared. Setting to default 16.", path);
-        point_size = 16;
-    }
+int32_t __gs_pak_build_entry_cmp(const void* a, const void* b)
+{
+    uint64_t ha = ((const __gs_pak_build_entry_t*)a)->entry.hash;
+    uint64_t hb = ((const __gs_pak_build_entry_t*)b)->entry.hash;
+    return ha < hb ? -1 : ha > hb ? 1 : 0;
+}
 
-    stbtt_fontinfo font = gs_default_val();
-    char* ttf = gs_read_file_contents_into_string_null_term(path, "rb", NULL);
-    const u32 w = 512;
-    const u32 h = 512;
-    const u32 num_comps = 4;
-    u8* alpha_bitmap = (u8*)gs_malloc(w * h);
-    u8* flipmap = (u8*)gs_malloc(w * h * num_comps);
-    memset(alpha_bitmap, 0, w * h);
-    memset(flipmap, 0, w * h * num_comps);
-    s32 v = stbtt_BakeFontBitmap((u8*)ttf, 0, (float)point_size, alpha_bitmap, w, h, 32, 96, (stbtt_bakedchar*)f->glyphs); // no guarantee this fits!
+gs_result gs_pak_build(const char* out_path, const char** file_paths, const char** names, uint32_t count, bool32_t compress)
+{
+    __gs_pak_build_entry_t* entries = (__gs_pak_build_entry_t*)gs_malloc(sizeof(__gs_pak_build_entry_t) * gs_max(count, 1));
+    memset(entries, 0, sizeof(__gs_pak_build_entry_t) * gs_max(count, 1));
+    gs_result res = GS_RESULT_SUCCESS;
+    uint32_t ct = 0;
 
-    // Flip texture
-    u32 r = h - 1;
-    for (u32 i = 0; i < h; ++i)
+    // Read (and optionally compress) all files
+    for (uint32_t i = 0; i < count; ++i)
     {
-        for (u32 j = 0; j < w; ++j)
+        __gs_pak_build_entry_t* e = &entries[ct];
+        __gs_pak_normalize_path(names ? names[i] : file_paths[i], e->name, sizeof(e->name));
+
+        int32_t sz = 0;
+        e->data = (uint8_t*)gs_platform_read_file_contents(file_paths[i], "rb", &sz);
+        if (!e->data) {
+            gs_println("Warning: pak build could not read: %s", file_paths[i]);
+            res = GS_RESULT_FAILURE;
+            break;
+        }
+
+        e->entry.hash = gs_hash_str64(e->name);
+        e->entry.size = (uint64_t)sz;
+        e->entry.raw_size = (uint64_t)sz;
+        e->entry.compression = GS_PAK_COMPRESSION_NONE;
+
+        // Keep compressed only when it pays for the decompress on load (already compressed formats usually don't)
+        if (compress && sz > 64)
         {
-            u32 i0 = i * w + j;
-            u32 i1 = i * w * num_comps + j * num_comps;
-            u8 a = alpha_bitmap[i0];
-            flipmap[i1 + 0] = 255;
-            flipmap[i1 + 1] = 255;
-            flipmap[i1 + 2] = 255;
-            flipmap[i1 + 3] = a;
+            int32_t cap = gs_lz4_compress_bound(sz);
+            uint8_t* cdata = (uint8_t*)gs_malloc(cap);
+            int32_t csz = gs_lz4_compress(e->data, sz, cdata, cap);
+            if (csz > 0 && csz < sz - sz / 8) {
+                gs_free(e->data);
+                e->data = cdata;
+                e->entry.size = (uint64_t)csz;
+                e->entry.compression = GS_PAK_COMPRESSION_LZ4;
+            } else {
+                gs_free(cdata);
+            }
         }
-        r--;
+
+        ct++;
     }
 
-    gs_graphics_texture_desc_t desc = gs_default_val();
-    desc.width = w;
-    desc.height = h;
-    desc.data = flipmap;
-    desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
-    desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+    if (res == GS_RESULT_SUCCESS)
+    {
+        qsort(entries, ct, sizeof(__gs_pak_build_entry_t), __gs_pak_build_entry_cmp);
 
-    // Generate atlas texture for bitmap with bitmap data
-    f->texture.hndl = gs_graphics_texture_create(&desc);
-    f->texture.desc = desc;
-    f->texture.desc.data = NULL;
+        for (uint32_t i = 0; i + 1 < ct; ++i) {
+            if (entries[i].entry.hash == entries[i + 1].entry.hash && gs_string_compare_equal(entries[i].name, entries[i + 1].name)) {
+                gs_println("Warning: pak build duplicate path: %s", entries[i].name);
+                res = GS_RESULT_FAILURE;
+            }
+        }
+    }
 
-    if (v == 0) {
-        gs_println("Font Failed to Load: %s, %d", path, v);
+    FILE* fp = res == GS_RESULT_SUCCESS ? fopen(out_path, "wb") : NULL;
+    if (fp)
+    {
+        // Lay out index, names, then aligned blobs
+        gs_pak_header_t hdr = gs_default_val();
+        hdr.magic = GS_PAK_MAGIC;
+        hdr.version = GS_PAK_VERSION;
+        hdr.entry_count = ct;
+        hdr.index_offset = sizeof(gs_pak_header_t);
+        hdr.names_offset = hdr.index_offset + (uint64_t)ct * sizeof(gs_pak_entry_t);
+
+        uint64_t names_size = 0;
+        for (uint32_t i = 0; i < ct; ++i) {
+            entries[i].entry.name_offset = (uint32_t)names_size;
+            names_size += gs_string_length(entries[i].name) + 1;
+        }
+
+        uint64_t offset = __gs_pak_align(hdr.names_offset + names_size);
+        for (uint32_t i = 0; i < ct; ++i) {
+            entries[i].entry.offset = offset;
+            offset = __gs_pak_align(offset + entries[i].entry.size + 1);
+        }
+
+        fwrite(&hdr, sizeof(hdr), 1, fp);
+        for (uint32_t i = 0; i < ct; ++i) {
+            fwrite(&entries[i].entry, sizeof(gs_pak_entry_t), 1, fp);
+        }
+        for (uint32_t i = 0; i < ct; ++i) {
+            fwrite(entries[i].name, 1, gs_string_length(entries[i].name) + 1, fp);
+        }
+
+        const uint8_t pad[GS_PAK_ALIGNMENT] = gs_default_val();
+        uint64_t at = hdr.names_offset + names_size;
+        for (uint32_t i = 0; i < ct; ++i) {
+            fwrite(pad, 1, (size_t)(entries[i].entry.offset - at), fp);
+            fwrite(entries[i].data, 1, (size_t)entries[i].entry.size, fp);
+            at = entries[i].entry.offset + entries[i].entry.size;
+        }
+        fwrite(pad, 1, (size_t)(offset - at), fp);
+
+        if (ferror(fp)) res = GS_RESULT_FAILURE;
+        fclose(fp);
     }
-    else {
-        gs_println("Font Successfully Load: %s, %d", path, v);
+    else if (res == GS_RESULT_SUCCESS)
+    {
+        gs_println("Warning: pak build could not open for writing: %s", out_path);
+        res = GS_RESULT_FAILURE;
     }
 
-    gs_free(ttf);
-    gs_free(alpha_bitmap);
-    gs_free(flipmap);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (entries[i].data) gs_free(entries[i].data);
+    }
+    gs_free(entries);
+
+    return res;
 }
 
-// Audio
-void gs_asset_audio_load_from_file(const char* path, void* out)
+/*== LZ4 (block format) ==*/
+
+#define GS_LZ4_HASH_BITS 12
+
+int32_t gs_lz4_compress_bound(int32_t src_size)
 {
-    gs_asset_audio_t* a = (gs_asset_audio_t*)out;
-    a->hndl = gs_audio_load_from_file(path);
+    return src_size + src_size / 255 + 16;
 }
 
-// Mesh
-void gs_util_load_gltf_data_from_file(const char* path, gs_asset_mesh_decl_t* decl, gs_asset_mesh_raw_data_t** out, uint32_t* mesh_count)
+int32_t __gs_lz4_write_length(uint8_t* dst, int32_t op, int32_t cap, int32_t len)
 {
-    // Use cgltf like a boss
-    cgltf_options options = gs_default_val();
-    cgltf_data* data = NULL;
-    cgltf_result result = cgltf_parse_file(&options, path, &data);
-
-    if (result != cgltf_result_success)
-    {
-        gs_println("Mesh:LoadFromFile:Failed load gltf: %s", path);
-        return;
+    for (; len >= 255; len -= 255) {
+        if (op >= cap) return -1;
+        dst[op++] = 255;
     }
+    if (op >= cap) return -1;
+    dst[op++] = (uint8_t)len;
+    return op;
+}
 
-    // Load buffers as well
-    result = cgltf_load_buffers(&options, data, path);
-    if (result != cgltf_result_success)
+// Greedy single probe compressor, favors speed and a trivial decoder over ratio
+int32_t gs_lz4_compress(const uint8_t* src, int32_t src_size, uint8_t* dst, int32_t dst_capacity)
+{
+    int32_t table[1 << GS_LZ4_HASH_BITS];
+    memset(table, 0xff, sizeof(table));
+
+    // Spec: last match starts at least 12 bytes before the end, last 5 bytes are literals
+    const int32_t mflimit = src_size - 12;
+    const int32_t matchlimit = src_size - 5;
+    int32_t ip = 0, anchor = 0, op = 0;
+
+    while (ip < mflimit)
     {
-        cgltf_free(data);
-        gs_println("Mesh:LoadFromFile:Failed to load buffers: %s", path);
-        return;
-    }
+        uint32_t seq = 0, ref_seq = 0;
+        memcpy(&seq, src + ip, 4);
+        uint32_t h = (seq * 2654435761u) >> (32 - GS_LZ4_HASH_BITS);
+        int32_t ref = table[h];
+        table[h] = ip;
+
+        if (ref >= 0) memcpy(&ref_seq, src + ref, 4);
+        if (ref < 0 || ip - ref > 0xffff || ref_seq != seq) {
+            ip++;
+            continue;
+        }
 
-    // Type of index data
-    size_t index_element_size = decl ? decl->index_buffer_element_size : 0;
+        int32_t len = 4;
+        while (ip + len < matchlimit && src[ref + len] == src[ip + len]) len++;
 
-    // Temporary structures
-    gs_dyn_array(gs_vec3) positions = NULL;
-    gs_dyn_array(gs_vec3) normals = NULL;
-    gs_dyn_array(gs_vec3) tangents = NULL;
-    gs_dyn_array(gs_color_t) colors = NULL;
-    gs_dyn_array(gs_vec2) uvs = NULL;
-    gs_dyn_array(gs_asset_mesh_layout_t) layouts = NULL;
-    gs_byte_buffer_t v_data = gs_byte_buffer_new();
-    gs_byte_buffer_t i_data = gs_byte_buffer_new();
+        int32_t lit = ip - anchor;
+        int32_t ml = len - 4;
+        if (op + 1 + lit + 2 > dst_capacity) return 0;
 
-    // Allocate memory for buffers
-    *mesh_count = data->meshes_count;
-    *out = (gs_asset_mesh_raw_data_t*)gs_malloc(data->meshes_count * sizeof(gs_asset_mesh_raw_data_t));
-    memset(*out, 0, sizeof(gs_asset_mesh_raw_data_t) * data->meshes_count);
+        uint8_t* token = dst + op++;
+        *token = (uint8_t)((lit >= 15 ? 15 : lit) << 4);
+        if (lit >= 15 && (op = __gs_lz4_write_length(dst, op, dst_capacity, lit - 15)) < 0) return 0;
+        if (op + lit + 2 > dst_capacity) return 0;
+        memcpy(dst + op, src + anchor, lit);
+        op += lit;
 
-    // Iterate through meshes in data
-    for (uint32_t i = 0; i < data->meshes_count; ++i)
-    {
-        // Initialize mesh data
-        gs_asset_mesh_raw_data_t* mesh = out[i];
-        mesh->prim_count = data->meshes[i].primitives_count;
-        mesh->vertex_sizes = (size_t*)gs_malloc(sizeof(size_t) * mesh->prim_count);
-        mesh->index_sizes = (size_t*)gs_malloc(sizeof(size_t) * mesh->prim_count);
-        mesh->vertices = (void**)gs_malloc(sizeof(size_t) * mesh->prim_count);
-        mesh->indices = (void**)gs_malloc(sizeof(size_t) * mesh->prim_count);
+        dst[op++] = (uint8_t)((ip - ref) & 0xff);
+        dst[op++] = (uint8_t)((ip - ref) >> 8);
 
-        // For each primitive in mesh 
-        for (uint32_t p = 0; p < data->meshes[i].primitives_count; ++p)
-        {
-            // Clear temp data from previous use
-            gs_dyn_array_clear(positions);
-            gs_dyn_array_clear(normals);
-            gs_dyn_array_clear(tangents);
-            gs_dyn_array_clear(uvs);
-            gs_dyn_array_clear(colors);
-            gs_dyn_array_clear(layouts);
-            gs_byte_buffer_clear(&v_data);
-            gs_byte_buffer_clear(&i_data);
+        *token |= (uint8_t)(ml >= 15 ? 15 : ml);
+        if (ml >= 15 && (op = __gs_lz4_write_length(dst, op, dst_capacity, ml - 15)) < 0) return 0;
 
-            #define __GLTF_PUSH_ATTR(ATTR, TYPE, COUNT, ARR, ARR_TYPE, LAYOUTS, LAYOUT_TYPE)\
-                do {\
-                    int32_t N = 0;\
-                    TYPE* BUF = (TYPE*)ATTR->buffer_view->buffer->data + ATTR->buffer_view->offset/sizeof(TYPE) + ATTR->offset/sizeof(TYPE);\
-                    gs_assert(BUF);\
-                    TYPE V[COUNT] = gs_default_val();\
-                    /* For each vertex */\
-                    for (uint32_t k = 0; k < ATTR->count; k++)\
-                    {\
-                        /* For each element */\
-                        for (int l = 0; l < COUNT; l++) {\
-                            V[l] = BUF[N + l];\
-                        }\
-                        N += (int32_t)(ATTR->stride/sizeof(TYPE));\
-                        /* Add to temp data array */\
-                        ARR_TYPE ELEM = gs_default_val();\
-                        memcpy((void*)&ELEM, (void*)V, sizeof(ARR_TYPE));\
-                        gs_dyn_array_push(ARR, ELEM);\
-                    }\
-                    /* Push into layout */\
-                    gs_asset_mesh_layout_t LAYOUT = gs_default_val();\
-                    LAYOUT.type = LAYOUT_TYPE;\
-                    gs_dyn_array_push(LAYOUTS, LAYOUT);\
-                } while (0)
+        ip += len;
+        anchor = ip;
+    }
 
-            // For each attribute in primitive
-            for (uint32_t a = 0; a < data->meshes[i].primitives[p].attributes_count; ++a)
-            {
-                // Accessor for attribute data
-                cgltf_accessor* attr = data->meshes[i].primitives[p].attributes[a].data;
+    // Trailing literals
+    int32_t lit = src_size - anchor;
+    if (op + 1 > dst_capacity) return 0;
+    dst[op++] = (uint8_t)((lit >= 15 ? 15 : lit) << 4);
+    if (lit >= 15 && (op = __gs_lz4_write_length(dst, op, dst_capacity, lit - 15)) < 0) return 0;
+    if (op + lit > dst_capacity) return 0;
+    memcpy(dst + op, src + anchor, lit);
+    op += lit;
 
-                // Switch on type for reading data
-                switch (data->meshes[i].primitives[p].attributes[a].type)
-                {
-                    case cgltf_attribute_type_position: {
-                        __GLTF_PUSH_ATTR(attr, float, 3, positions, gs_vec3, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION);
-                    } break;
+    return op;
+}
 
-                    case cgltf_attribute_type_normal: {
-                        __GLTF_PUSH_ATTR(attr, float, 3, normals, gs_vec3, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL);
-                    } break;
+// Returns decompressed size, or -1 on malformed input
+int32_t gs_lz4_decompress(const uint8_t* src, int32_t src_size, uint8_t* dst, int32_t dst_size)
+{
+    int32_t ip = 0, op = 0;
 
-                    case cgltf_attribute_type_tangent: {
-                        __GLTF_PUSH_ATTR(attr, float, 3, tangents, gs_vec3, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT);
-                    } break;
+    while (ip < src_size)
+    {
+        uint8_t token = src[ip++];
+
+        int32_t lit = token >> 4;
+        if (lit == 15) {
+            uint8_t b = 0;
+            do {
+                if (ip >= src_size) return -1;
+                b = src[ip++];
+                if (b > src_size - ip - lit) return -1;
+                lit += b;
+            } while (b == 255);
+        }
+        if (lit > src_size - ip || lit > dst_size - op) return -1;
+        memcpy(dst + op, src + ip, lit);
+        ip += lit;
+        op += lit;
+
+        // Last sequence has no match
+        if (ip >= src_size) break;
+
+        if (ip + 2 > src_size) return -1;
+        int32_t offset = src[ip] | (src[ip + 1] << 8);
+        ip += 2;
+        if (!offset || offset > op) return -1;
+
+        int32_t ml = token & 15;
+        if (ml == 15) {
+            uint8_t b = 0;
+            do {
+                if (ip >= src_size) return -1;
+                b = src[ip++];
+                if (b > dst_size - op - ml) return -1;
+                ml += b;
+            } while (b == 255);
+        }
+        ml += 4;
+        if (ml > dst_size - op) return -1;
 
-                    case cgltf_attribute_type_texcoord: {
-                        __GLTF_PUSH_ATTR(attr, float, 2, uvs, gs_vec2, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD);
-                    } break;
+        // Byte copy, matches may overlap their own output
+        const uint8_t* match = dst + op - offset;
+        for (int32_t i = 0; i < ml; ++i) dst[op + i] = match[i];
+        op += ml;
+    }
+
+    return op;
+}
+
+/*=============================
+// GS_PLATFORM
+=============================*/
+
+#ifndef GS_PLATFORM_IMPL_CUSTOM
+    #define GS_PLATFORM_IMPL_GLFW
+    #include "impl/gs_platform_impl.h"
+#endif
+
+/*=============================
+// GS_GRAPHICS
+=============================*/
+
+#ifndef GS_GRAPHICS_IMPL_CUSTOM
+    #define GS_GRAPHICS_IMPL_OPENGL
+    #include "impl/gs_graphics_impl.h"
+#endif
+
+/*=============================
+// GS_AUDIO
+=============================*/
+
+#ifndef GS_AUDIO_IMPL_CUSTOM
+    #define GS_AUDIO_IMPL_MINIAUDIO
+    #include "impl/gs_audio_impl.h"
+#endif
+
+/*==========================
+// GS_ASSET_TYPES
+==========================*/
+
+void gs_asset_texture_load_from_file(const char* path, void* out, gs_graphics_texture_desc_t* desc, bool32_t flip_on_load, bool32_t keep_data)
+{
+    gs_asset_texture_load_opts_t opts = gs_default_val();
+    if (desc) opts.desc = *desc;
+    opts.default_desc = !desc;
+    opts.flip_on_load = flip_on_load;
+    opts.keep_data = keep_data;
+
+    void* staging = NULL;
+    if (gs_asset_texture_decode_from_file(path, out, &opts, &staging)) {
+        gs_asset_texture_upload(out, &opts, staging);
+    }
+}
+
+#define __GS_DDS_MAGIC              0x20534444  // 'DDS '
+#define __GS_DDS_FOURCC(A, B, C, D) ((uint32_t)(A) | ((uint32_t)(B) << 8) | ((uint32_t)(C) << 16) | ((uint32_t)(D) << 24))
+
+typedef struct __gs_dds_header_t
+{
+    uint32_t magic;
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitch_or_linear_size;
+    uint32_t depth;
+    uint32_t mip_count;
+    uint32_t reserved1[11];
+    uint32_t pf_size;
+    uint32_t pf_flags;
+    uint32_t pf_fourcc;
+    uint32_t pf_rgb_bit_count;
+    uint32_t pf_masks[4];
+    uint32_t caps[4];
+    uint32_t reserved2;
+} __gs_dds_header_t;
+
+typedef struct __gs_dds_header_dx10_t
+{
+    uint32_t dxgi_format;
+    uint32_t dimension;
+    uint32_t misc_flags;
+    uint32_t array_size;
+    uint32_t misc_flags2;
+} __gs_dds_header_dx10_t;
+
+// Cooked texture levels point straight into the mapped file until upload
+typedef struct gs_asset_texture_staging_t
+{
+    gs_platform_file_view_t view;
+} gs_asset_texture_staging_t;
+
+static bool32_t __gs_dds_format(const gs_platform_file_view_t* view, gs_graphics_texture_format_type* format, size_t* data_offset)
+{
+    const __gs_dds_header_t* hdr = (const __gs_dds_header_t*)view->data;
+    *data_offset = sizeof(__gs_dds_header_t);
+
+    if (hdr->pf_flags & 0x4)
+    {
+        switch (hdr->pf_fourcc)
+        {
+            case __GS_DDS_FOURCC('D', 'X', 'T', '1'): *format = GS_GRAPHICS_TEXTURE_FORMAT_BC1; return true;
+            case __GS_DDS_FOURCC('D', 'X', 'T', '5'): *format = GS_GRAPHICS_TEXTURE_FORMAT_BC3; return true;
+            case __GS_DDS_FOURCC('A', 'T', 'I', '2'): 
+            case __GS_DDS_FOURCC('B', 'C', '5', 'U'): *format = GS_GRAPHICS_TEXTURE_FORMAT_BC5; return true;
+            case __GS_DDS_FOURCC('D', 'X', '1', '0'): 
+            {
+                if (view->size < sizeof(__gs_dds_header_t) + sizeof(__gs_dds_header_dx10_t)) break;
+                const __gs_dds_header_dx10_t* dx10 = (const __gs_dds_header_dx10_t*)(hdr + 1);
+                *data_offset += sizeof(__gs_dds_header_dx10_t);
+
+                // No srgb texture formats yet, so those are sampled as unorm and come out too bright
+                if (dx10->dxgi_format == 29 || dx10->dxgi_format == 72 || dx10->dxgi_format == 78 || dx10->dxgi_format == 99) {
+                    gs_println("Warning:TextureLoadFromFile:dds srgb format %u loaded as unorm", dx10->dxgi_format);
+                }
+
+                switch (dx10->dxgi_format)
+                {
+                    case 28: case 29: *format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8; return true;
+                    case 71: case 72: *format = GS_GRAPHICS_TEXTURE_FORMAT_BC1; return true;
+                    case 77: case 78: *format = GS_GRAPHICS_TEXTURE_FORMAT_BC3; return true;
+                    case 83:          *format = GS_GRAPHICS_TEXTURE_FORMAT_BC5; return true;
+                    case 98: case 99: *format = GS_GRAPHICS_TEXTURE_FORMAT_BC7; return true;
+                    default: break;
+                }
+            } break;
+            default: break;
+        }
+    }
+    // Uncompressed rgba8, r in low byte
+    else if ((hdr->pf_flags & 0x40) && hdr->pf_rgb_bit_count == 32 && hdr->pf_masks[0] == 0x000000ff)
+    {
+        *format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8; return true;
+    }
+
+    return false;
+}
+
+static bool32_t __gs_asset_texture_decode_dds(const char* path, gs_asset_texture_t* t, void** staging)
+{
+    gs_platform_file_view_t view = gs_default_val();
+    if (!gs_platform_file_view_open_mapped(path, &view)) {
+        gs_println("Warning:TextureLoadFromFile:Could not open: %s", path);
+        return false;
+    }
+
+    const __gs_dds_header_t* hdr = (const __gs_dds_header_t*)view.data;
+    size_t offset = 0;
+    gs_graphics_texture_format_type format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+    bool32_t valid = view.size >= sizeof(__gs_dds_header_t) && hdr->magic == __GS_DDS_MAGIC && 
+        hdr->width && hdr->height && __gs_dds_format(&view, &format, &offset);
+
+    if (!valid) {
+        gs_println("Warning:TextureLoadFromFile:Unsupported dds: %s", path);
+        gs_platform_file_view_close(&view);
+        return false;
+    }
+
+    const uint8_t* base = (const uint8_t*)view.data;
+    const uint32_t mip_count = (hdr->flags & 0x20000) && hdr->mip_count ? hdr->mip_count : 1;
+    const uint32_t level_count = gs_min(mip_count, GS_GRAPHICS_TEXTURE_MAX_MIPS + 1);
+    t->desc.format = format;
+    t->desc.width = hdr->width;
+    t->desc.height = hdr->height;
+
+    // Levels are stored back to back, largest first. A truncated chain keeps the levels that fit.
+    for (uint32_t i = 0; i < level_count; ++i) {
+        size_t sz = gs_graphics_texture_level_size(format, gs_max(hdr->width >> i, 1), gs_max(hdr->height >> i, 1));
+        if (offset + sz > view.size) break;
+        if (i) t->desc.mip_data[i - 1] = (void*)(base + offset);
+        else t->desc.data = (void*)(base + offset);
+        t->desc.num_mips = i;
+        offset += sz;
+    }
+
+    if (!t->desc.data) {
+        gs_println("Warning:TextureLoadFromFile:Truncated dds: %s", path);
+        gs_platform_file_view_close(&view);
+        return false;
+    }
+
+    gs_asset_texture_staging_t* st = gs_malloc_init(gs_asset_texture_staging_t);
+    st->view = view;
+    *staging = st;
+    return true;
+}
+
+bool32_t gs_asset_texture_decode_from_file(const char* path, void* out, const gs_asset_texture_load_opts_t* opts, void** staging)
+{
+    gs_asset_texture_t* t = (gs_asset_texture_t*)out; 
+
+    memset(&t->desc, 0, sizeof(gs_graphics_texture_desc_t));
+
+    if (opts && !opts->default_desc) {
+        t->desc = opts->desc;
+    } else {
+        t->desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+        t->desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+        t->desc.mag_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR; 
+        t->desc.wrap_s = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
+        t->desc.wrap_t = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
+    }
+    memset(t->desc.mip_data, 0, sizeof(t->desc.mip_data));
+
+    // Cooked texture, format and mips come from the file (sampler state from opts)
+    gs_transient_buffer(file_ext, 32);
+    gs_platform_file_extension(file_ext, 32, path);
+    if (gs_string_compare_equal(file_ext, "dds")) {
+        return __gs_asset_texture_decode_dds(path, t, staging);
+    }
+
+    // Load texture data
+    int32_t num_comps = 0;
+    bool32_t loaded = gs_util_load_texture_data_from_file(path, (int32_t*)&t->desc.width, 
+        (int32_t*)&t->desc.height, (uint32_t*)&num_comps, (void**)&t->desc.data, opts ? opts->flip_on_load : false);
+
+    if (!loaded) {
+        gs_println("Warning: could not load texture: %s", path);
+        return false;
+    }
+
+    // Build requested chain here (off the driver thread), uploaded as prebuilt levels
+    if (t->desc.num_mips && t->desc.format == GS_GRAPHICS_TEXTURE_FORMAT_RGBA8) {
+        t->desc.num_mips = gs_asset_texture_generate_mips(t->desc.data, t->desc.width, t->desc.height, 
+            t->desc.num_mips, opts ? &opts->mips : NULL, t->desc.mip_data);
+    }
+
+    return true;
+}
+
+void gs_asset_texture_upload(void* out, const gs_asset_texture_load_opts_t* opts, void* staging)
+{
+    gs_asset_texture_t* t = (gs_asset_texture_t*)out; 
+
+    t->hndl = gs_graphics_texture_create(&t->desc);
+
+    // Cooked levels belong to the mapping, only level 0 is copied out when kept
+    if (staging) {
+        gs_asset_texture_staging_t* st = (gs_asset_texture_staging_t*)staging;
+        void* kept = NULL;
+        if (opts && opts->keep_data) {
+            size_t sz = gs_graphics_texture_level_size(t->desc.format, t->desc.width, t->desc.height);
+            kept = gs_malloc(sz);
+            memcpy(kept, t->desc.data, sz);
+        }
+        t->desc.data = kept;
+        memset(t->desc.mip_data, 0, sizeof(t->desc.mip_data));
+        gs_platform_file_view_close(&st->view);
+        gs_free(st);
+        return;
+    }
+
+    if (t->desc.mip_data[0]) {
+        gs_free(t->desc.mip_data[0]);
+        memset(t->desc.mip_data, 0, sizeof(t->desc.mip_data));
+    }
+
+    if (!opts || !opts->keep_data) {
+        gs_free(t->desc.data);
+        t->desc.data = NULL;
+    }
+}
+
+void gs_asset_texture_discard(void* out, const gs_asset_texture_load_opts_t* opts, void* staging)
+{
+    (void)opts;
+    gs_asset_texture_t* t = (gs_asset_texture_t*)out; 
+    if (staging) {
+        gs_platform_file_view_close(&((gs_asset_texture_staging_t*)staging)->view);
+        gs_free(staging);
+    } else {
+        if (t->desc.mip_data[0]) gs_free(t->desc.mip_data[0]);
+        if (t->desc.data) gs_free(t->desc.data);
+    }
+    memset(&t->desc, 0, sizeof(gs_graphics_texture_desc_t));
+}
+
+void gs_asset_texture_free(gs_asset_texture_t* t)
+{
+    gs_graphics_texture_destroy(t->hndl);
+    t->hndl = gs_handle_invalid(gs_graphics_texture_t);
+}
+
+static float __gs_mip_srgb_to_linear(float c)
+{
+    return c <= 0.04045f ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+}
+
+static float __gs_mip_linear_to_srgb(float c)
+{
+    return c <= 0.0031308f ? c * 12.92f : 1.055f * powf(c, 1.f / 2.4f) - 0.055f;
+}
+
+// Zeroth order modified bessel function (series), for the kaiser window
+static float __gs_mip_bessel_i0(float x)
+{
+    float sum = 1.f, term = 1.f, q = x * x * 0.25f;
+    for (uint32_t k = 1; k < 16; ++k) {
+        term *= q / (float)(k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+#define __GS_MIP_KAISER_ALPHA   4.f
+#define __GS_MIP_KAISER_LOBES   2.f
+#define __GS_MIP_MAX_TAPS       32
+
+// Kaiser windowed sinc, t in destination texels
+static float __gs_mip_kaiser(float t)
+{
+    const float x = t / __GS_MIP_KAISER_LOBES;
+    if (fabsf(x) >= 1.f) return 0.f;
+    const float sinc = fabsf(t) < 1e-5f ? 1.f : sinf(GS_PI * t) / (GS_PI * t);
+    return sinc * __gs_mip_bessel_i0(__GS_MIP_KAISER_ALPHA * sqrtf(1.f - x * x)) / __gs_mip_bessel_i0(__GS_MIP_KAISER_ALPHA);
+}
+
+// Normalized filter taps for one destination texel along an axis (clamped at the edges)
+static uint32_t __gs_mip_taps(uint32_t d, uint32_t src_len, uint32_t dst_len, gs_asset_texture_mip_filter_type filter, uint32_t* idx, float* w)
+{
+    const float scale = (float)src_len / (float)dst_len;
+    const float center = ((float)d + 0.5f) * scale;
+    const float support = filter == GS_ASSET_TEXTURE_MIP_FILTER_KAISER ? __GS_MIP_KAISER_LOBES * scale : 0.5f * scale;
+    const int32_t first = (int32_t)floorf(center - support);
+    const int32_t last = (int32_t)ceilf(center + support);
+
+    uint32_t n = 0;
+    float sum = 0.f;
+    for (int32_t i = first; i < last && n < __GS_MIP_MAX_TAPS; ++i) {
+        float wt = 0.f;
+        if (filter == GS_ASSET_TEXTURE_MIP_FILTER_KAISER) {
+            wt = __gs_mip_kaiser(((float)i + 0.5f - center) / scale);
+        } else {
+            wt = gs_min((float)(i + 1), center + support) - gs_max((float)i, center - support);
+        }
+        if (wt == 0.f) continue;
+        idx[n] = (uint32_t)gs_clamp(i, 0, (int32_t)src_len - 1);
+        w[n] = wt;
+        sum += wt;
+        n++;
+    }
+    for (uint32_t k = 0; k < n; ++k) w[k] /= sum;
+    return n;
+}
+
+uint32_t gs_asset_texture_generate_mips(const void* rgba8, uint32_t width, uint32_t height, uint32_t num_mips, const gs_asset_texture_mip_desc_t* desc, void** mip_data)
+{
+    uint32_t levels = 0;
+    while (levels < num_mips && levels < GS_GRAPHICS_TEXTURE_MAX_MIPS && ((width >> (levels + 1)) || (height >> (levels + 1)))) {
+        levels++;
+    }
+    if (!rgba8 || !levels) return 0;
+
+    const gs_asset_texture_mip_filter_type filter = desc ? desc->filter : GS_ASSET_TEXTURE_MIP_FILTER_BOX;
+    const bool32_t srgb = desc ? desc->srgb : false;
+
+    // One allocation for every level, each level tightly packed
+    size_t total = 0;
+    for (uint32_t i = 1; i <= levels; ++i) {
+        total += (size_t)gs_max(width >> i, 1) * gs_max(height >> i, 1) * 4;
+    }
+    uint8_t* block = (uint8_t*)gs_malloc(total);
+
+    float to_linear[256];
+    for (uint32_t i = 0; i < 256; ++i) {
+        to_linear[i] = srgb ? __gs_mip_srgb_to_linear((float)i / 255.f) : (float)i / 255.f;
+    }
+
+    // Filter in float from the previous level, separable (horizontal then vertical)
+    float* cur = (float*)gs_malloc((size_t)width * height * 4 * sizeof(float));
+    float* next = (float*)gs_malloc((size_t)gs_max(width >> 1, 1) * gs_max(height >> 1, 1) * 4 * sizeof(float));
+    float* tmp = (float*)gs_malloc((size_t)gs_max(width >> 1, 1) * height * 4 * sizeof(float));
+    const uint8_t* src = (const uint8_t*)rgba8;
+    for (size_t i = 0; i < (size_t)width * height * 4; ++i) {
+        cur[i] = (i & 3) == 3 ? (float)src[i] / 255.f : to_linear[src[i]];
+    }
+
+    uint32_t idx[__GS_MIP_MAX_TAPS];
+    float w[__GS_MIP_MAX_TAPS];
+    uint32_t sw = width, sh = height;
+    uint8_t* dst = block;
+    for (uint32_t l = 0; l < levels; ++l) {
+        const uint32_t dw = gs_max(sw >> 1, 1), dh = gs_max(sh >> 1, 1);
+
+        for (uint32_t x = 0; x < dw; ++x) {
+            uint32_t n = __gs_mip_taps(x, sw, dw, filter, idx, w);
+            for (uint32_t y = 0; y < sh; ++y) {
+                float acc[4] = {0};
+                for (uint32_t k = 0; k < n; ++k) {
+                    const float* p = &cur[((size_t)y * sw + idx[k]) * 4];
+                    for (uint32_t c = 0; c < 4; ++c) acc[c] += p[c] * w[k];
+                }
+                memcpy(&tmp[((size_t)y * dw + x) * 4], acc, sizeof(acc));
+            }
+        }
+
+        for (uint32_t y = 0; y < dh; ++y) {
+            uint32_t n = __gs_mip_taps(y, sh, dh, filter, idx, w);
+            for (uint32_t x = 0; x < dw; ++x) {
+                float acc[4] = {0};
+                for (uint32_t k = 0; k < n; ++k) {
+                    const float* p = &tmp[((size_t)idx[k] * dw + x) * 4];
+                    for (uint32_t c = 0; c < 4; ++c) acc[c] += p[c] * w[k];
+                }
+                float* o = &next[((size_t)y * dw + x) * 4];
+                for (uint32_t c = 0; c < 4; ++c) {
+                    o[c] = gs_clamp(acc[c], 0.f, 1.f);
+                    const float e = (c < 3 && srgb) ? __gs_mip_linear_to_srgb(o[c]) : o[c];
+                    dst[((size_t)y * dw + x) * 4 + c] = (uint8_t)(e * 255.f + 0.5f);
+                }
+            }
+        }
+
+        mip_data[l] = dst;
+        dst += (size_t)dw * dh * 4;
+        float* swap = cur; cur = next; next = swap;
+        sw = dw;
+        sh = dh;
+    }
+
+    gs_free(cur);
+    gs_free(next);
+    gs_free(tmp);
+    return levels;
+}
+
+#undef __GS_MIP_KAISER_ALPHA
+#undef __GS_MIP_KAISER_LOBES
+#undef __GS_MIP_MAX_TAPS
+
+// Fetch rgba8 texel, clamped to edges (pads partial blocks)
+#define __GS_TEX_COOK_TEXEL(DATA, W, H, X, Y) ((DATA) + 4 * ((size_t)gs_min((uint32_t)(Y), (H) - 1) * (W) + gs_min((uint32_t)(X), (W) - 1)))
+
+static void __gs_asset_texture_cook_level(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t h, gs_graphics_texture_format_type format)
+{
+    if (format == GS_GRAPHICS_TEXTURE_FORMAT_RGBA8) {
+        memcpy(dst, src, (size_t)w * h * 4);
+        return;
+    }
+
+    const size_t block_sz = format == GS_GRAPHICS_TEXTURE_FORMAT_BC1 ? 8 : 16;
+    for (uint32_t by = 0; by < h; by += 4) {
+        for (uint32_t bx = 0; bx < w; bx += 4) {
+            uint8_t rgba[64];
+            uint8_t rg[32];
+            for (uint32_t p = 0; p < 16; ++p) {
+                const uint8_t* px = __GS_TEX_COOK_TEXEL(src, w, h, bx + (p & 3), by + (p >> 2));
+                memcpy(&rgba[p * 4], px, 4);
+                rg[p * 2] = px[0];
+                rg[p * 2 + 1] = px[1];
+            }
+            switch (format) {
+                case GS_GRAPHICS_TEXTURE_FORMAT_BC1: stb_compress_dxt_block(dst, rgba, 0, STB_DXT_HIGHQUAL); break;
+                case GS_GRAPHICS_TEXTURE_FORMAT_BC3: stb_compress_dxt_block(dst, rgba, 1, STB_DXT_HIGHQUAL); break;
+                case GS_GRAPHICS_TEXTURE_FORMAT_BC5: stb_compress_bc5_block(dst, rg); break;
+                default: break;
+            }
+            dst += block_sz;
+        }
+    }
+}
+
+gs_result gs_asset_texture_cook(const char* src_path, const char* out_path, const gs_asset_texture_cook_desc_t* desc)
+{
+    gs_graphics_texture_format_type format = (desc && desc->format) ? desc->format : GS_GRAPHICS_TEXTURE_FORMAT_BC3;
+    switch (format) {
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC1:
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC3:
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC5:
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA8: break;
+        default: {
+            gs_println("Warning:TextureCook:Format not supported by cooker (BC1, BC3, BC5, RGBA8): %s", src_path);
+            return GS_RESULT_FAILURE;
+        }
+    }
+
+    int32_t w = 0, h = 0;
+    uint32_t num_comps = 0;
+    void* pixels = NULL;
+    if (!gs_util_load_texture_data_from_file(src_path, &w, &h, &num_comps, &pixels, desc ? desc->flip_on_load : false)) {
+        gs_println("Warning:TextureCook:Could not load texture: %s", src_path);
+        return GS_RESULT_FAILURE;
+    }
+
+    // Full chain down to 1x1, capped by what the importer can upload
+    void* mips[GS_GRAPHICS_TEXTURE_MAX_MIPS] = gs_default_val();
+    uint32_t level_count = 1;
+    if (!desc || !desc->no_mips) {
+        level_count += gs_asset_texture_generate_mips(pixels, w, h, UINT32_MAX, desc ? &desc->mips : NULL, mips);
+    }
+
+    const bool32_t compressed = gs_graphics_texture_format_is_compressed(format);
+    __gs_dds_header_t hdr = gs_default_val();
+    hdr.magic = __GS_DDS_MAGIC;
+    hdr.size = sizeof(__gs_dds_header_t) - sizeof(uint32_t);
+    hdr.flags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | (compressed ? 0x80000 : 0x8);
+    hdr.width = (uint32_t)w;
+    hdr.height = (uint32_t)h;
+    hdr.pitch_or_linear_size = compressed ? (uint32_t)gs_graphics_texture_level_size(format, w, h) : (uint32_t)w * 4;
+    hdr.mip_count = level_count;
+    hdr.pf_size = 32;
+    if (compressed) {
+        hdr.pf_flags = 0x4;
+        hdr.pf_fourcc = format == GS_GRAPHICS_TEXTURE_FORMAT_BC1 ? __GS_DDS_FOURCC('D', 'X', 'T', '1') : 
+                        format == GS_GRAPHICS_TEXTURE_FORMAT_BC3 ? __GS_DDS_FOURCC('D', 'X', 'T', '5') : 
+                                                                   __GS_DDS_FOURCC('A', 'T', 'I', '2');
+    } else {
+        hdr.pf_flags = 0x40 | 0x1;
+        hdr.pf_rgb_bit_count = 32;
+        hdr.pf_masks[0] = 0x000000ff;
+        hdr.pf_masks[1] = 0x0000ff00;
+        hdr.pf_masks[2] = 0x00ff0000;
+        hdr.pf_masks[3] = 0xff000000;
+    }
+    hdr.caps[0] = 0x1000 | (level_count > 1 ? (0x400000 | 0x8) : 0);
+
+    FILE* fp = fopen(out_path, "wb");
+    if (!fp) {
+        gs_println("Warning:TextureCook:Could not open for writing: %s", out_path);
+        if (mips[0]) gs_free(mips[0]);
+        gs_free(pixels);
+        return GS_RESULT_FAILURE;
+    }
+    fwrite(&hdr, sizeof(hdr), 1, fp);
+
+    uint8_t* enc = (uint8_t*)gs_malloc(gs_max(gs_graphics_texture_level_size(format, w, h), (size_t)16));
+    for (uint32_t i = 0; i < level_count; ++i) {
+        const uint32_t lw = gs_max((uint32_t)w >> i, 1), lh = gs_max((uint32_t)h >> i, 1);
+        __gs_asset_texture_cook_level(enc, i ? (const uint8_t*)mips[i - 1] : (const uint8_t*)pixels, lw, lh, format);
+        fwrite(enc, 1, gs_graphics_texture_level_size(format, lw, lh), fp);
+    }
+
+    gs_result res = ferror(fp) ? GS_RESULT_FAILURE : GS_RESULT_SUCCESS;
+    fclose(fp);
+
+    if (mips[0]) gs_free(mips[0]);
+    gs_free(pixels);
+    gs_free(enc);
+    return res;
+}
+
+#undef __GS_TEX_COOK_TEXEL
+
+void gs_asset_font_load_from_file(const char* path, void* out, uint32_t point_size)
+{ 
+    gs_asset_font_load_opts_t opts = gs_default_val();
+    opts.point_size = point_size;
+
+    void* staging = NULL;
+    if (gs_asset_font_decode_from_file(path, out, &opts, &staging)) {
+        gs_asset_font_upload(out, &opts, staging);
+    }
+}
+
+bool32_t gs_asset_font_decode_from_file(const char* path, void* out, const gs_asset_font_load_opts_t* opts, void** staging)
+{ 
+    (void)staging;
+    gs_asset_font_t* f = (gs_asset_font_t*)out;
+    uint32_t point_size = opts ? opts->point_size : 0;
+
+    if (!point_size) {
+        gs_println("Warning: Font: %s: Point size not declared. Setting to default 16.", path);
+        point_size = 16;
+    }
+
+    stbtt_fontinfo font = gs_default_val();
+    gs_platform_file_view_t ttf = gs_default_val();
+    if (!gs_platform_file_view_open(path, &ttf)) {
+        gs_println("Font Failed to Load: %s", path);
+        return false;
+    }
+
+    const u32 w = 512;
+    const u32 h = 512;
+    const u32 num_comps = 4;
+    u8* alpha_bitmap = (u8*)gs_malloc(w * h);
+    u8* flipmap = (u8*)gs_malloc(w * h * num_comps);
+    memset(alpha_bitmap, 0, w * h);
+    memset(flipmap, 0, w * h * num_comps);
+    s32 v = stbtt_BakeFontBitmap((const u8*)ttf.data, 0, (float)point_size, alpha_bitmap, w, h, 32, 96, (stbtt_bakedchar*)f->glyphs); // no guarantee this fits!
+
+    // Flip texture
+    u32 r = h - 1;
+    for (u32 i = 0; i < h; ++i)
+    {
+        for (u32 j = 0; j < w; ++j)
+        {
+            u32 i0 = i * w + j;
+            u32 i1 = i * w * num_comps + j * num_comps;
+            u8 a = alpha_bitmap[i0];
+            flipmap[i1 + 0] = 255;
+            flipmap[i1 + 1] = 255;
+            flipmap[i1 + 2] = 255;
+            flipmap[i1 + 3] = a;
+        }
+        r--;
+    }
+
+    gs_graphics_texture_desc_t desc = gs_default_val();
+    desc.width = w;
+    desc.height = h;
+    desc.data = flipmap;
+    desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+    desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+
+    // Atlas bitmap is kept in the texture desc until upload
+    f->texture.desc = desc;
+
+    if (v == 0) {
+        gs_println("Font Failed to Load: %s, %d", path, v);
+    }
+    else {
+        gs_println("Font Successfully Load: %s, %d", path, v);
+    }
+
+    gs_platform_file_view_close(&ttf);
+    gs_free(alpha_bitmap);
+
+    return true;
+}
+
+void gs_asset_font_upload(void* out, const gs_asset_font_load_opts_t* opts, void* staging)
+{
+    (void)opts; (void)staging;
+    gs_asset_font_t* f = (gs_asset_font_t*)out;
+
+    // Generate atlas texture for bitmap with bitmap data
+    f->texture.hndl = gs_graphics_texture_create(&f->texture.desc);
+    gs_free(f->texture.desc.data);
+    f->texture.desc.data = NULL;
+}
+
+void gs_asset_font_discard(void* out, const gs_asset_font_load_opts_t* opts, void* staging)
+{
+    (void)opts; (void)staging;
+    gs_asset_font_t* f = (gs_asset_font_t*)out;
+    if (f->texture.desc.data) gs_free(f->texture.desc.data);
+    f->texture.desc.data = NULL;
+}
+
+void gs_asset_font_free(gs_asset_font_t* f)
+{
+    gs_asset_font_discard(f, NULL, NULL);
+    gs_asset_texture_free(&f->texture);
+}
+
+// SDF Font
+void gs_sdf_font_page_new(gs_asset_sdf_font_t* f)
+{
+    gs_sdf_font_page_t page = gs_default_val();
+
+    // Zero is the far outside of the field, so unused texels and glyph borders read as empty
+    u8* zeros = (u8*)gs_malloc(f->page_size * f->page_size);
+    memset(zeros, 0, f->page_size * f->page_size);
+
+    gs_graphics_texture_desc_t desc = gs_default_val();
+    desc.width = f->page_size;
+    desc.height = f->page_size;
+    desc.format = GS_GRAPHICS_TEXTURE_FORMAT_R8;
+    desc.wrap_s = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE;
+    desc.wrap_t = GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE;
+    desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+    desc.mag_filter = GS_GRAPHICS_TEXTURE_FILTER_LINEAR;
+    desc.data = zeros;
+    page.texture = gs_graphics_texture_create(&desc);
+    page.tick = f->tick;
+    gs_free(zeros);
+
+    gs_dyn_array_push(f->pages, page);
+}
+
+void gs_asset_sdf_font_load_from_file(const char* path, void* out)
+{
+    if (gs_asset_sdf_font_decode_from_file(path, out, NULL, NULL)) {
+        gs_asset_sdf_font_upload(out, NULL, NULL);
+    }
+}
+
+bool32_t gs_asset_sdf_font_decode_from_file(const char* path, void* out, const void* opts, void** staging)
+{
+    (void)opts; (void)staging;
+    gs_asset_sdf_font_t* f = (gs_asset_sdf_font_t*)out;
+    memset(f, 0, sizeof(gs_asset_sdf_font_t));
+
+    // Glyphs are rendered from the ttf on demand for the life of the font, so keep an owned copy
+    gs_platform_file_view_t view = gs_default_val();
+    if (!gs_platform_file_view_open(path, &view)) {
+        gs_println("Font Failed to Load: %s", path);
+        return false;
+    }
+    if (view.alloc) {
+        f->ttf = view.alloc;
+    } else {
+        f->ttf = gs_malloc(view.size);
+        memcpy(f->ttf, view.data, view.size);
+    }
+
+    stbtt_fontinfo* info = (stbtt_fontinfo*)gs_malloc(sizeof(stbtt_fontinfo));
+    f->font_info = info;
+    if (!stbtt_InitFont(info, (u8*)f->ttf, stbtt_GetFontOffsetForIndex((u8*)f->ttf, 0))) {
+        gs_println("Font Failed to Load: %s", path);
+        gs_free(f->ttf);
+        gs_free(f->font_info);
+        f->ttf = NULL;
+        f->font_info = NULL;
+        return false;
+    }
+
+    f->base_size = GS_SDF_FONT_BASE_SIZE;
+    f->padding = GS_SDF_FONT_PADDING;
+    f->page_size = GS_SDF_FONT_PAGE_SIZE;
+    f->max_pages = GS_SDF_FONT_MAX_PAGES;
+    f->scale = stbtt_ScaleForPixelHeight(info, f->base_size);
+
+    s32 ascent = 0, descent = 0, line_gap = 0;
+    stbtt_GetFontVMetrics(info, &ascent, &descent, &line_gap);
+    f->ascent = (f32)ascent * f->scale;
+    f->descent = (f32)descent * f->scale;
+    f->line_gap = (f32)line_gap * f->scale;
+
+    gs_println("Font Successfully Load: %s", path);
+
+    return true;
+}
+
+void gs_asset_sdf_font_upload(void* out, const void* opts, void* staging)
+{
+    (void)opts; (void)staging;
+    // First page up front, the rest are added on demand up to max_pages
+    gs_sdf_font_page_new((gs_asset_sdf_font_t*)out);
+}
+
+void gs_asset_sdf_font_discard(void* out, const void* opts, void* staging)
+{
+    (void)opts; (void)staging;
+    // Nothing on the gpu yet, only the ttf copy and font info
+    gs_asset_sdf_font_t* f = (gs_asset_sdf_font_t*)out;
+    if (f->ttf) gs_free(f->ttf);
+    if (f->font_info) gs_free(f->font_info);
+    memset(f, 0, sizeof(gs_asset_sdf_font_t));
+}
+
+void gs_asset_sdf_font_free(gs_asset_sdf_font_t* f)
+{
+    for (uint32_t i = 0; i < gs_dyn_array_size(f->pages); ++i) {
+        gs_graphics_texture_destroy(f->pages[i].texture);
+        gs_dyn_array_free(f->pages[i].shelves);
+    }
+    gs_dyn_array_free(f->pages);
+    gs_hash_table_free(f->glyphs);
+    if (f->ttf) gs_free(f->ttf);
+    if (f->font_info) gs_free(f->font_info);
+    memset(f, 0, sizeof(gs_asset_sdf_font_t));
+}
+
+gs_sdf_glyph_t* gs_sdf_font_glyph_slot(gs_asset_sdf_font_t* f, uint32_t codepoint)
+{
+    if (codepoint < 128) {
+        return &f->ascii[codepoint];
+    }
+    if (!f->glyphs || !gs_hash_table_key_exists(f->glyphs, codepoint)) {
+        return NULL;
+    }
+    return gs_hash_table_getp(f->glyphs, codepoint);
+}
+
+bool32_t gs_sdf_font_glyph_resident(gs_asset_sdf_font_t* f, const gs_sdf_glyph_t* g)
+{
+    return g && g->valid && (g->x0 == g->x1 || g->generation == f->pages[g->page].generation);
+}
+
+const gs_sdf_glyph_t* gs_asset_sdf_font_find_glyph(gs_asset_sdf_font_t* f, uint32_t codepoint)
+{
+    gs_sdf_glyph_t* g = gs_sdf_font_glyph_slot(f, codepoint);
+    if (!gs_sdf_font_glyph_resident(f, g)) {
+        return NULL;
+    }
+    if (g->x0 != g->x1) {
+        f->pages[g->page].tick = ++f->tick;
+    }
+    return g;
+}
+
+// Shelf packing: place in the shortest shelf that fits, otherwise open a new shelf
+bool32_t gs_sdf_font_page_pack(gs_asset_sdf_font_t* f, gs_sdf_font_page_t* page, u32 w, u32 h, u16* x, u16* y)
+{
+    gs_sdf_font_shelf_t* best = NULL;
+    for (uint32_t i = 0; i < gs_dyn_array_size(page->shelves); ++i) {
+        gs_sdf_font_shelf_t* s = &page->shelves[i];
+        if (s->h >= h && s->x + w <= f->page_size && (!best || s->h < best->h)) {
+            best = s;
+        }
+    }
+
+    if (!best) {
+        if (page->top + h > f->page_size) {
+            return false;
+        }
+        gs_sdf_font_shelf_t s = gs_default_val();
+        s.y = (u16)page->top;
+        s.h = (u16)h;
+        page->top += h;
+        gs_dyn_array_push(page->shelves, s);
+        best = &gs_dyn_array_back(page->shelves);
+    }
+
+    *x = best->x;
+    *y = best->y;
+    best->x += (u16)w;
+    return true;
+}
+
+const gs_sdf_glyph_t* gs_asset_sdf_font_cache_glyph(gs_asset_sdf_font_t* f, gs_command_buffer_t* cb, uint32_t codepoint)
+{
+    const gs_sdf_glyph_t* found = gs_asset_sdf_font_find_glyph(f, codepoint);
+    if (found) {
+        return found;
+    }
+
+    stbtt_fontinfo* info = (stbtt_fontinfo*)f->font_info;
+    gs_sdf_glyph_t g = gs_default_val();
+    g.valid = true;
+
+    s32 advance = 0, lsb = 0;
+    stbtt_GetCodepointHMetrics(info, (s32)codepoint, &advance, &lsb);
+    g.xadvance = (f32)advance * f->scale;
+
+    s32 w = 0, h = 0, xoff = 0, yoff = 0;
+    u8* field = stbtt_GetCodepointSDF(info, f->scale, (s32)codepoint, (s32)f->padding, 128, 128.f / (f32)f->padding, &w, &h, &xoff, &yoff);
+    g.xoff = (f32)xoff;
+    g.yoff = (f32)yoff;
+
+    if (field) 
+    {
+        // Glyphs are packed with an empty 1 pixel border on every side so filtering never reads a neighbour
+        const u32 pw = (u32)w + 2, ph = (u32)h + 2;
+        gs_assert(pw <= f->page_size && ph <= f->page_size);
+
+        // Try pages most recently used first
+        u16 x = 0, y = 0;
+        s32 page = -1;
+        for (uint32_t i = 0; i < gs_dyn_array_size(f->pages) && page < 0; ++i) {
+            if (gs_sdf_font_page_pack(f, &f->pages[i], pw, ph, &x, &y)) page = (s32)i;
+        }
+
+        // Grow, or evict least recently used page
+        if (page < 0 && gs_dyn_array_size(f->pages) < f->max_pages) {
+            gs_sdf_font_page_new(f);
+            page = (s32)gs_dyn_array_size(f->pages) - 1;
+            gs_sdf_font_page_pack(f, &f->pages[page], pw, ph, &x, &y);
+        }
+        else if (page < 0) {
+            page = 0;
+            for (uint32_t i = 1; i < gs_dyn_array_size(f->pages); ++i) {
+                if (f->pages[i].tick < f->pages[page].tick) page = (s32)i;
+            }
+            gs_sdf_font_page_t* p = &f->pages[page];
+            p->generation++;
+            p->top = 0;
+            gs_dyn_array_clear(p->shelves);
+            gs_sdf_font_page_pack(f, p, pw, ph, &x, &y);
+
+            // Clear out the evicted glyphs before the page is reused
+            gs_graphics_texture_desc_t clear = gs_default_val();
+            clear.width = f->page_size;
+            clear.height = f->page_size;
+            clear.format = GS_GRAPHICS_TEXTURE_FORMAT_R8;
+            clear.data = gs_malloc(f->page_size * f->page_size);
+            memset(clear.data, 0, f->page_size * f->page_size);
+            gs_graphics_texture_request_update(cb, p->texture, &clear);
+            gs_free(clear.data);
+        }
+
+        gs_sdf_font_page_t* p = &f->pages[page];
+        p->tick = ++f->tick;
+        g.page = (u16)page;
+        g.generation = p->generation;
+        g.x0 = x + 1;
+        g.y0 = y + 1;
+        g.x1 = g.x0 + (u16)w;
+        g.y1 = g.y0 + (u16)h;
+
+        // Queue upload of glyph region and its border only
+        u8* cell = (u8*)gs_malloc(pw * ph);
+        memset(cell, 0, pw * ph);
+        for (s32 r = 0; r < h; ++r) {
+            memcpy(cell + (r + 1) * pw + 1, field + r * w, (size_t)w);
+        }
+
+        gs_graphics_texture_desc_t desc = gs_default_val();
+        desc.width = f->page_size;
+        desc.height = f->page_size;
+        desc.format = GS_GRAPHICS_TEXTURE_FORMAT_R8;
+        desc.data = cell;
+        desc.update.x = x;
+        desc.update.y = y;
+        desc.update.width = pw;
+        desc.update.height = ph;
+        gs_graphics_texture_request_update(cb, p->texture, &desc);
+
+        gs_free(cell);
+        stbtt_FreeSDF(field, NULL);
+    }
+
+    // Re-cached glyphs keep their slot
+    gs_sdf_glyph_t* slot = gs_sdf_font_glyph_slot(f, codepoint);
+    if (slot) {
+        *slot = g;
+        return slot;
+    }
+    gs_hash_table_insert(f->glyphs, codepoint, g);
+    return gs_hash_table_getp(f->glyphs, codepoint);
+}
+
+// Audio
+void gs_asset_audio_load_from_file(const char* path, void* out)
+{
+    gs_asset_audio_t* a = (gs_asset_audio_t*)out;
+    a->hndl = gs_audio_load_from_file(path);
+}
+
+bool32_t gs_asset_audio_decode_from_file(const char* path, void* out, const void* opts, void** staging)
+{
+    (void)out; (void)opts;
+    // Decoded samples are staged until upload, since the source cache is shared with the mixer
+    gs_audio_source_t* src = gs_malloc_init(gs_audio_source_t);
+    if (!gs_audio_load_source_data_from_file(path, src)) {
+        gs_free(src);
+        return false;
+    }
+
+    *staging = src;
+    return true;
+}
+
+void gs_asset_audio_upload(void* out, const void* opts, void* staging)
+{
+    (void)opts;
+    gs_asset_audio_t* a = (gs_asset_audio_t*)out;
+    a->hndl = gs_audio_source_create((gs_audio_source_t*)staging);
+    gs_free(staging);
+}
+
+void gs_asset_audio_discard(void* out, const void* opts, void* staging)
+{
+    (void)out; (void)opts;
+    gs_audio_source_t* src = (gs_audio_source_t*)staging;
+    if (src->samples) gs_free(src->samples);
+    gs_free(src);
+}
+
+// Mesh
+cgltf_result __gs_cgltf_file_read(const struct cgltf_memory_options* mem, const struct cgltf_file_options* file, const char* path, cgltf_size* size, void** data)
+{
+    (void)mem; (void)file;
+    gs_platform_file_view_t view = gs_default_val();
+    if (!gs_platform_file_view_open(path, &view)) {
+        return cgltf_result_file_not_found;
+    }
+
+    // Mapped pak data is handed over as is, cgltf only reads it
+    *data = view.alloc ? view.alloc : (void*)view.data;
+    *size = view.size;
+    return cgltf_result_success;
+}
+
+void* __gs_cgltf_alloc(void* user_data, cgltf_size size)
+{
+    (void)user_data;
+    return gs_malloc(size);
+}
+
+// File data can point into a mounted pak, which is never freed
+void __gs_cgltf_free(void* user_data, void* ptr)
+{
+    (void)user_data;
+    gs_platform_i* platform = gs_engine_instance() ? gs_engine_subsystem(platform) : NULL;
+    bool32_t in_pak = false;
+    if (platform)
+    {
+        gs_platform_mutex_lock(platform->pak_lock);
+        for (uint32_t i = 0; i < gs_dyn_array_size(platform->paks) && !in_pak; ++i) {
+            const gs_pak_t* pak = &platform->paks[i];
+            in_pak = (const uint8_t*)ptr >= pak->data && (const uint8_t*)ptr < pak->data + pak->size;
+        }
+        gs_platform_mutex_unlock(platform->pak_lock);
+    }
+    if (ptr && !in_pak) gs_free(ptr);
+}
+
+void gs_util_load_gltf_data_from_file(const char* path, gs_asset_mesh_decl_t* decl, gs_asset_mesh_raw_data_t** out, uint32_t* mesh_count)
+{
+    // Use cgltf like a boss
+    cgltf_options options = gs_default_val();
+    options.file.read = __gs_cgltf_file_read;
+    options.memory.alloc = __gs_cgltf_alloc;
+    options.memory.free = __gs_cgltf_free;
+    cgltf_data* data = NULL;
+    cgltf_result result = cgltf_parse_file(&options, path, &data);
+
+    if (result != cgltf_result_success)
+    {
+        gs_println("Mesh:LoadFromFile:Failed load gltf: %s", path);
+        return;
+    }
+
+    // Load buffers as well
+    result = cgltf_load_buffers(&options, data, path);
+    if (result != cgltf_result_success)
+    {
+        cgltf_free(data);
+        gs_println("Mesh:LoadFromFile:Failed to load buffers: %s", path);
+        return;
+    }
+
+    // Type of index data
+    size_t index_element_size = decl ? decl->index_buffer_element_size : 0;
+
+    // Temporary structures
+    gs_dyn_array(gs_vec3) positions = NULL;
+    gs_dyn_array(gs_vec3) normals = NULL;
+    gs_dyn_array(gs_vec3) tangents = NULL;
+    gs_dyn_array(gs_color_t) colors = NULL;
+    gs_dyn_array(gs_vec2) uvs = NULL;
+    gs_dyn_array(gs_asset_mesh_layout_t) layouts = NULL;
+    gs_byte_buffer_t v_data = gs_byte_buffer_new();
+    gs_byte_buffer_t i_data = gs_byte_buffer_new();
+
+    // Allocate memory for buffers
+    *mesh_count = data->meshes_count;
+    *out = (gs_asset_mesh_raw_data_t*)gs_malloc(data->meshes_count * sizeof(gs_asset_mesh_raw_data_t));
+    memset(*out, 0, sizeof(gs_asset_mesh_raw_data_t) * data->meshes_count);
+
+    // Iterate through meshes in data
+    for (uint32_t i = 0; i < data->meshes_count; ++i)
+    {
+        // Initialize mesh data
+        gs_asset_mesh_raw_data_t* mesh = &(*out)[i];
+        mesh->prim_count = data->meshes[i].primitives_count;
+        mesh->vertex_sizes = (size_t*)gs_malloc(sizeof(size_t) * mesh->prim_count);
+        mesh->index_sizes = (size_t*)gs_malloc(sizeof(size_t) * mesh->prim_count);
+        mesh->vertices = (void**)gs_malloc(sizeof(size_t) * mesh->prim_count);
+        mesh->indices = (void**)gs_malloc(sizeof(size_t) * mesh->prim_count);
+
+        // For each primitive in mesh 
+        for (uint32_t p = 0; p < data->meshes[i].primitives_count; ++p)
+        {
+            // Clear temp data from previous use
+            gs_dyn_array_clear(positions);
+            gs_dyn_array_clear(normals);
+            gs_dyn_array_clear(tangents);
+            gs_dyn_array_clear(uvs);
+            gs_dyn_array_clear(colors);
+            gs_dyn_array_clear(layouts);
+            gs_byte_buffer_clear(&v_data);
+            gs_byte_buffer_clear(&i_data);
+
+            #define __GLTF_PUSH_ATTR(ATTR, TYPE, COUNT, ARR, ARR_TYPE, LAYOUTS, LAYOUT_TYPE)\
+                do {\
+                    int32_t N = 0;\
+                    TYPE* BUF = (TYPE*)ATTR->buffer_view->buffer->data + ATTR->buffer_view->offset/sizeof(TYPE) + ATTR->offset/sizeof(TYPE);\
+                    gs_assert(BUF);\
+                    TYPE V[COUNT] = gs_default_val();\
+                    /* For each vertex */\
+                    for (uint32_t k = 0; k < ATTR->count; k++)\
+                    {\
+                        /* For each element */\
+                        for (int l = 0; l < COUNT; l++) {\
+                            V[l] = BUF[N + l];\
+                        }\
+                        N += (int32_t)(ATTR->stride/sizeof(TYPE));\
+                        /* Add to temp data array */\
+                        ARR_TYPE ELEM = gs_default_val();\
+                        memcpy((void*)&ELEM, (void*)V, sizeof(ARR_TYPE));\
+                        gs_dyn_array_push(ARR, ELEM);\
+                    }\
+                    /* Push into layout */\
+                    gs_asset_mesh_layout_t LAYOUT = gs_default_val();\
+                    LAYOUT.type = LAYOUT_TYPE;\
+                    gs_dyn_array_push(LAYOUTS, LAYOUT);\
+                } while (0)
+
+            // For each attribute in primitive
+            for (uint32_t a = 0; a < data->meshes[i].primitives[p].attributes_count; ++a)
+            {
+                // Accessor for attribute data
+                cgltf_accessor* attr = data->meshes[i].primitives[p].attributes[a].data;
+
+                // Switch on type for reading data
+                switch (data->meshes[i].primitives[p].attributes[a].type)
+                {
+                    case cgltf_attribute_type_position: {
+                        __GLTF_PUSH_ATTR(attr, float, 3, positions, gs_vec3, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION);
+                    } break;
+
+                    case cgltf_attribute_type_normal: {
+                        __GLTF_PUSH_ATTR(attr, float, 3, normals, gs_vec3, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL);
+                    } break;
+
+                    case cgltf_attribute_type_tangent: {
+                        __GLTF_PUSH_ATTR(attr, float, 3, tangents, gs_vec3, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT);
+                    } break;
+
+                    case cgltf_attribute_type_texcoord: {
+                        __GLTF_PUSH_ATTR(attr, float, 2, uvs, gs_vec2, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD);
+                    } break;
 
                     case cgltf_attribute_type_color: {
                         __GLTF_PUSH_ATTR(attr, uint8_t, 4, colors, gs_color_t, layouts, GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR);
                     } break;
 
-                    // Not sure what to do with these for now
-                    case cgltf_attribute_type_joints: 
-                    {
-                        // Push into layout
-                        gs_asset_mesh_layout_t layout = gs_default_val();
-                        layout.type = GS_ASSET_MESH_ATTRIBUTE_TYPE_JOINT;
-                        gs_dyn_array_push(layouts, layout);
-                    } break;
+                    // Not sure what to do with these for now
+                    case cgltf_attribute_type_joints: 
+                    {
+                        // Push into layout
+                        gs_asset_mesh_layout_t layout = gs_default_val();
+                        layout.type = GS_ASSET_MESH_ATTRIBUTE_TYPE_JOINT;
+                        gs_dyn_array_push(layouts, layout);
+                    } break;
+
+                    case cgltf_attribute_type_weights:
+                    {
+                        // Push into layout
+                        gs_asset_mesh_layout_t layout = gs_default_val();
+                        layout.type = GS_ASSET_MESH_ATTRIBUTE_TYPE_WEIGHT;
+                        gs_dyn_array_push(layouts, layout);
+                    } break;
+
+                    // Shouldn't hit here...   
+                    default: 
+                    {
+                    } break;
+                }
+            }
+
+            // Indices for primitive
+            cgltf_accessor* acc = data->meshes[i].primitives[p].indices;
+
+            #define __GLTF_PUSH_IDX(BB, ACC, TYPE)\
+                do {\
+                    int32_t n = 0;\
+                    TYPE* buf = (TYPE*)acc->buffer_view->buffer->data + acc->buffer_view->offset/sizeof(TYPE) + acc->offset/sizeof(TYPE);\
+                    gs_assert(buf);\
+                    TYPE v = 0;\
+                    /* For each index */\
+                    for (uint32_t k = 0; k < acc->count; k++) {\
+                        /* For each element */\
+                        for (int l = 0; l < 1; l++) {\
+                            v = buf[n + l];\
+                        }\
+                        n += (int32_t)(acc->stride/sizeof(TYPE));\
+                        /* Add to temp positions array */\
+                        switch (index_element_size) {\
+                            case 0: gs_byte_buffer_write(BB, uint16_t, (uint16_t)v); break;\
+                            case 2: gs_byte_buffer_write(BB, uint16_t, (uint16_t)v); break;\
+                            case 4: gs_byte_buffer_write(BB, uint32_t, (uint32_t)v); break;\
+                        }\
+                    }\
+                } while (0)
+
+            // If indices are available
+            if (acc) 
+            {
+                switch (acc->component_type) 
+                {
+                    case cgltf_component_type_r_8:   __GLTF_PUSH_IDX(&i_data, acc, int8_t);   break;
+                    case cgltf_component_type_r_8u:  __GLTF_PUSH_IDX(&i_data, acc, uint8_t);  break;
+                    case cgltf_component_type_r_16:  __GLTF_PUSH_IDX(&i_data, acc, int16_t);  break;
+                    case cgltf_component_type_r_16u: __GLTF_PUSH_IDX(&i_data, acc, uint16_t); break;
+                    case cgltf_component_type_r_32u: __GLTF_PUSH_IDX(&i_data, acc, uint32_t); break;
+                    case cgltf_component_type_r_32f: __GLTF_PUSH_IDX(&i_data, acc, float);    break;
+
+                    // Shouldn't hit here
+                    default: {
+                    } break;
+                }
+            }
+            else 
+            {
+                // Iterate over positions size, then just push back indices
+                for (uint32_t i = 0; i < gs_dyn_array_size(positions); ++i) 
+                {
+                    switch (index_element_size)
+                    {
+                        default:
+                        case 0: gs_byte_buffer_write(&i_data, uint16_t, (uint16_t)i); break;
+                        case 2: gs_byte_buffer_write(&i_data, uint16_t, (uint16_t)i); break;
+                        case 4: gs_byte_buffer_write(&i_data, uint32_t, (uint32_t)i); break;
+                    }
+                }
+            }
+
+            bool warnings[gs_enum_count(gs_asset_mesh_attribute_type)] = gs_default_val();
+
+            // Grab mesh layout pointer to use
+            gs_asset_mesh_layout_t* layoutp = decl ? decl->layout : layouts;
+            uint32_t layout_ct = decl ? decl->layout_size / sizeof(gs_asset_mesh_layout_t) : gs_dyn_array_size(layouts);
+
+            // Iterate layout to fill data buffers according to provided layout
+            {
+                uint32_t vct = 0; 
+                vct = gs_max(vct, gs_dyn_array_size(positions)); 
+                vct = gs_max(vct, gs_dyn_array_size(colors)); 
+                vct = gs_max(vct, gs_dyn_array_size(uvs));
+                vct = gs_max(vct, gs_dyn_array_size(normals));
+                vct = gs_max(vct, gs_dyn_array_size(tangents));
+
+                #define __GLTF_WRITE_DATA(IT, VDATA, ARR, ARR_TYPE, ARR_DEF_VAL, LAYOUT_TYPE)\
+                    do {\
+                        /* Grab data at index, if available */\
+                        if (IT < gs_dyn_array_size(ARR)) {\
+                            gs_byte_buffer_write(&(VDATA), ARR_TYPE, ARR[IT]);\
+                        }\
+                        else {\
+                            /* Write default value and give warning.*/\
+                            gs_byte_buffer_write(&(VDATA), ARR_TYPE, ARR_DEF_VAL);\
+                            if (!warnings[LAYOUT_TYPE]) {\
+                                gs_println("Warning:Mesh:LoadFromFile:%s:Index out of range.", #LAYOUT_TYPE);\
+                                warnings[LAYOUT_TYPE] = true;\
+                            }\
+                        }\
+                    } while (0)
+
+                for (uint32_t it = 0; it < vct; ++it)
+                {
+                    // For each attribute in layout
+                    for (uint32_t l = 0; l < layout_ct; ++l)
+                    {
+                        switch (layoutp[l].type)
+                        {
+                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION: {
+                                __GLTF_WRITE_DATA(it, v_data, positions, gs_vec3, gs_v3(0.f, 0.f, 0.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION); 
+                            } break;
+
+                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD: {
+                                __GLTF_WRITE_DATA(it, v_data, uvs, gs_vec2, gs_v2(0.f, 0.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD); 
+                            } break;
+
+                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR: {
+                                __GLTF_WRITE_DATA(it, v_data, colors, gs_color_t, GS_COLOR_WHITE, GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR); 
+                            } break;
+
+                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL: {
+                                __GLTF_WRITE_DATA(it, v_data, normals, gs_vec3, gs_v3(0.f, 0.f, 1.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL); 
+                            } break;
+
+                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT: {
+                                __GLTF_WRITE_DATA(it, v_data, tangents, gs_vec3, gs_v3(0.f, 1.f, 0.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT); 
+                            } break;
+
+                            default:
+                            {
+                            } break;
+                        }
+                    }
+                }
+            }
+
+            // Add to out data
+            mesh->vertices[p] = gs_malloc(v_data.size);
+            mesh->indices[p] = gs_malloc(i_data.size);
+            mesh->vertex_sizes[p] = v_data.size;
+            mesh->index_sizes[p] = i_data.size;
+
+            // Copy data
+            memcpy(mesh->vertices[p], v_data.data, v_data.size);
+            memcpy(mesh->indices[p], i_data.data, i_data.size);
+        }
+    }
+
+    // Free all data at the end
+    cgltf_free(data);
+    gs_dyn_array_free(positions);
+    gs_dyn_array_free(normals);
+    gs_dyn_array_free(tangents);
+    gs_dyn_array_free(colors);
+    gs_dyn_array_free(uvs);
+    gs_dyn_array_free(layouts);
+    gs_byte_buffer_free(&v_data);
+    gs_byte_buffer_free(&i_data);
+}
+
+typedef struct gs_asset_mesh_staging_t
+{
+    uint32_t mesh_count;
+    gs_asset_mesh_raw_data_t* meshes;
+    gs_platform_file_view_t cooked;     // Mapped .gsm, uploaded in place
+} gs_asset_mesh_staging_t;
+
+size_t gs_asset_mesh_attribute_size(gs_asset_mesh_attribute_type type, bool32_t quantized)
+{
+    switch (type)
+    {
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION: return quantized ? sizeof(int16_t) * 4 : sizeof(gs_vec3);
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL:   return quantized ? sizeof(int16_t) * 2 : sizeof(gs_vec3);
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT:  return quantized ? sizeof(uint32_t) : sizeof(gs_vec3);
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD: return quantized ? sizeof(uint16_t) * 2 : sizeof(gs_vec2);
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR:    return sizeof(gs_color_t);
+        default:                                    return 0;   // Not written by loader
+    }
+}
 
-                    case cgltf_attribute_type_weights:
-                    {
-                        // Push into layout
-                        gs_asset_mesh_layout_t layout = gs_default_val();
-                        layout.type = GS_ASSET_MESH_ATTRIBUTE_TYPE_WEIGHT;
-                        gs_dyn_array_push(layouts, layout);
-                    } break;
+gs_graphics_vertex_attribute_type gs_asset_mesh_attribute_format(gs_asset_mesh_attribute_type type, bool32_t quantized)
+{
+    switch (type)
+    {
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION: return quantized ? GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT4N : GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT3;
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL:   return quantized ? GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT2N : GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT3;
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT:  return quantized ? GS_GRAPHICS_VERTEX_ATTRIBUTE_INT_10_10_10_2N : GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT3;
+        case GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD: return quantized ? GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF2 : GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT2;
+        default:                                    return GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE4;
+    }
+}
 
-                    // Shouldn't hit here...   
-                    default: 
-                    {
-                    } break;
+void gs_asset_mesh_raw_data_free(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count)
+{
+    if (!meshes) return;
+
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* m = &meshes[i];
+        for (uint32_t p = 0; p < m->prim_count; ++p) {
+            gs_free(m->vertices[p]);
+            gs_free(m->indices[p]);
+        }
+        gs_free(m->vertex_sizes);
+        gs_free(m->index_sizes);
+        gs_free(m->vertices);
+        gs_free(m->indices);
+        if (m->lod_counts) gs_free(m->lod_counts);
+        if (m->lods) gs_free(m->lods);
+        if (m->dequant) gs_free(m->dequant);
+    }
+
+    gs_free(meshes);
+}
+
+/*== Mesh Optimization ==*/
+
+// Merge bitwise identical vertices in place, returns unique vertex count
+static uint32_t __gs_mesh_opt_weld(uint8_t* verts, uint32_t vcount, size_t stride, uint32_t* indices, uint32_t icount)
+{
+    // Open addressing table of (vertex + 1), zero is empty
+    uint32_t cap = 1;
+    while (cap < vcount * 2) cap <<= 1;
+    uint32_t* table = (uint32_t*)gs_malloc(cap * sizeof(uint32_t));
+    uint32_t* remap = (uint32_t*)gs_malloc(vcount * sizeof(uint32_t));
+    memset(table, 0, cap * sizeof(uint32_t));
+
+    uint32_t unique = 0;
+    for (uint32_t v = 0; v < vcount; ++v)
+    {
+        uint8_t* vp = verts + v * stride;
+        size_t h = gs_hash_bytes(vp, stride, 0) & (cap - 1);
+        for (;;)
+        {
+            uint32_t e = table[h];
+            if (!e) {
+                if (unique != v) memcpy(verts + unique * stride, vp, stride);
+                table[h] = unique + 1;
+                remap[v] = unique++;
+                break;
+            }
+            if (memcmp(verts + (e - 1) * stride, vp, stride) == 0) {
+                remap[v] = e - 1;
+                break;
+            }
+            h = (h + 1) & (cap - 1);
+        }
+    }
+
+    for (uint32_t i = 0; i < icount; ++i) indices[i] = remap[indices[i]];
+
+    gs_free(table);
+    gs_free(remap);
+    return unique;
+}
+
+/*
+    Tipsify (Sander, Nehab, Barczak 2007): fan around the most recently cached vertex that will still 
+    be in cache, falling back to the dead end stack. Each fallback starts a new cluster, clusters is 
+    filled with their start triangles (tri_count + 1 entries), returns the cluster count.
+*/
+static uint32_t __gs_mesh_opt_tipsify(const uint32_t* in, uint32_t* out, uint32_t tri_count, uint32_t vcount, uint32_t cache_size, uint32_t* clusters)
+{
+    const uint32_t icount = tri_count * 3;
+    uint32_t* adj_offsets = (uint32_t*)gs_malloc((vcount + 1) * sizeof(uint32_t));
+    uint32_t* adj = (uint32_t*)gs_malloc(icount * sizeof(uint32_t));
+    uint32_t* live = (uint32_t*)gs_malloc(vcount * sizeof(uint32_t));
+    uint32_t* stamp = (uint32_t*)gs_malloc(vcount * sizeof(uint32_t));
+    uint32_t* dead_end = (uint32_t*)gs_malloc(icount * sizeof(uint32_t));
+    uint32_t* cand = (uint32_t*)gs_malloc(icount * sizeof(uint32_t));
+    uint8_t* emitted = (uint8_t*)gs_malloc(gs_max(tri_count, 1));
+    memset(live, 0, vcount * sizeof(uint32_t));
+    memset(stamp, 0, vcount * sizeof(uint32_t));
+    memset(emitted, 0, gs_max(tri_count, 1));
+
+    // Vertex -> triangle adjacency
+    for (uint32_t i = 0; i < icount; ++i) live[in[i]]++;
+    adj_offsets[0] = 0;
+    for (uint32_t v = 0; v < vcount; ++v) adj_offsets[v + 1] = adj_offsets[v] + live[v];
+    for (uint32_t i = 0; i < icount; ++i) adj[adj_offsets[in[i]]++] = i / 3;
+    for (uint32_t v = vcount; v > 0; --v) adj_offsets[v] = adj_offsets[v - 1];
+    adj_offsets[0] = 0;
+
+    uint32_t time = cache_size + 1, cursor = 0, dead_ct = 0, out_tris = 0, cluster_ct = 0;
+    uint32_t f = 0;
+    clusters[cluster_ct++] = 0;
+
+    while (f != UINT32_MAX)
+    {
+        // Emit all remaining triangles around fanning vertex
+        uint32_t cand_ct = 0;
+        for (uint32_t k = adj_offsets[f]; k < adj_offsets[f + 1]; ++k)
+        {
+            uint32_t t = adj[k];
+            if (emitted[t]) continue;
+            for (uint32_t c = 0; c < 3; ++c)
+            {
+                uint32_t v = in[t * 3 + c];
+                out[out_tris * 3 + c] = v;
+                dead_end[dead_ct++] = v;
+                cand[cand_ct++] = v;
+                live[v]--;
+                if (time - stamp[v] > cache_size) stamp[v] = time++;
+            }
+            emitted[t] = 1;
+            out_tris++;
+        }
+
+        // Next fanning vertex, prefer oldest candidate that stays in cache while its fan is emitted
+        uint32_t n = UINT32_MAX;
+        int64_t best = -1;
+        for (uint32_t c = 0; c < cand_ct; ++c)
+        {
+            uint32_t v = cand[c];
+            if (!live[v]) continue;
+            int64_t p = 0;
+            if (time - stamp[v] + 2 * live[v] <= cache_size) p = time - stamp[v];
+            if (p > best) {best = p; n = v;}
+        }
+
+        // Dead end, pop recently used vertices, then scan for any live vertex
+        if (n == UINT32_MAX)
+        {
+            while (dead_ct && n == UINT32_MAX) {
+                uint32_t v = dead_end[--dead_ct];
+                if (live[v]) n = v;
+            }
+            for (; cursor < vcount && n == UINT32_MAX; ++cursor) {
+                if (live[cursor]) n = cursor;
+            }
+            if (n != UINT32_MAX && out_tris > clusters[cluster_ct - 1]) {
+                clusters[cluster_ct++] = out_tris;
+            }
+        }
+
+        f = n;
+    }
+
+    clusters[cluster_ct] = out_tris;
+
+    gs_free(adj_offsets);
+    gs_free(adj);
+    gs_free(live);
+    gs_free(stamp);
+    gs_free(dead_end);
+    gs_free(cand);
+    gs_free(emitted);
+    return cluster_ct;
+}
+
+typedef struct __gs_mesh_opt_cluster_t
+{
+    float key;
+    uint32_t start;
+    uint32_t count;
+} __gs_mesh_opt_cluster_t;
+
+static int __gs_mesh_opt_cluster_cmp(const void* a, const void* b)
+{
+    float ka = ((const __gs_mesh_opt_cluster_t*)a)->key;
+    float kb = ((const __gs_mesh_opt_cluster_t*)b)->key;
+    return ka < kb ? 1 : ka > kb ? -1 : 0;
+}
+
+// Draw clusters facing away from the mesh center first, they tend to occlude the rest (Sander et al.)
+static void __gs_mesh_opt_overdraw(uint32_t* indices, uint32_t tri_count, const uint8_t* verts, size_t stride, size_t pos_offset, const uint32_t* clusters, uint32_t cluster_ct)
+{
+    #define __GS_MESH_OPT_POS(I) (*(const gs_vec3*)(verts + (I) * stride + pos_offset))
+
+    __gs_mesh_opt_cluster_t* cl = (__gs_mesh_opt_cluster_t*)gs_malloc(cluster_ct * sizeof(__gs_mesh_opt_cluster_t));
+    gs_vec3* centroids = (gs_vec3*)gs_malloc(cluster_ct * sizeof(gs_vec3));
+    gs_vec3* normals = (gs_vec3*)gs_malloc(cluster_ct * sizeof(gs_vec3));
+
+    // Area weighted cluster centroids/normals
+    gs_vec3 center = gs_v3(0.f, 0.f, 0.f);
+    float total_area = 0.f;
+    for (uint32_t c = 0; c < cluster_ct; ++c)
+    {
+        gs_vec3 cc = gs_v3(0.f, 0.f, 0.f), cn = gs_v3(0.f, 0.f, 0.f);
+        float area = 0.f;
+        for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t)
+        {
+            gs_vec3 p0 = __GS_MESH_OPT_POS(indices[t * 3 + 0]);
+            gs_vec3 p1 = __GS_MESH_OPT_POS(indices[t * 3 + 1]);
+            gs_vec3 p2 = __GS_MESH_OPT_POS(indices[t * 3 + 2]);
+            gs_vec3 n = gs_vec3_cross(gs_vec3_sub(p1, p0), gs_vec3_sub(p2, p0));
+            float a = gs_vec3_len(n) * 0.5f;
+            gs_vec3 tc = gs_vec3_scale(gs_vec3_add(gs_vec3_add(p0, p1), p2), 1.f / 3.f);
+            cc = gs_vec3_add(cc, gs_vec3_scale(tc, a));
+            cn = gs_vec3_add(cn, n);
+            area += a;
+        }
+        center = gs_vec3_add(center, cc);
+        total_area += area;
+        centroids[c] = area > 0.f ? gs_vec3_scale(cc, 1.f / area) : __GS_MESH_OPT_POS(indices[clusters[c] * 3]);
+        normals[c] = gs_vec3_norm(cn);
+    }
+    if (total_area > 0.f) center = gs_vec3_scale(center, 1.f / total_area);
+
+    for (uint32_t c = 0; c < cluster_ct; ++c)
+    {
+        cl[c].key = gs_vec3_dot(gs_vec3_sub(centroids[c], center), normals[c]);
+        cl[c].start = clusters[c];
+        cl[c].count = clusters[c + 1] - clusters[c];
+    }
+    qsort(cl, cluster_ct, sizeof(__gs_mesh_opt_cluster_t), __gs_mesh_opt_cluster_cmp);
+
+    uint32_t* sorted = (uint32_t*)gs_malloc(tri_count * 3 * sizeof(uint32_t));
+    uint32_t at = 0;
+    for (uint32_t c = 0; c < cluster_ct; ++c) {
+        memcpy(sorted + at * 3, indices + cl[c].start * 3, cl[c].count * 3 * sizeof(uint32_t));
+        at += cl[c].count;
+    }
+    memcpy(indices, sorted, tri_count * 3 * sizeof(uint32_t));
+
+    #undef __GS_MESH_OPT_POS
+
+    gs_free(sorted);
+    gs_free(cl);
+    gs_free(centroids);
+    gs_free(normals);
+}
+
+// Reorder vertices by first use in index stream, returns referenced vertex count
+static uint32_t __gs_mesh_opt_fetch(uint8_t* verts, uint32_t vcount, size_t stride, uint32_t* indices, uint32_t icount)
+{
+    uint32_t* remap = (uint32_t*)gs_malloc(vcount * sizeof(uint32_t));
+    uint8_t* tmp = (uint8_t*)gs_malloc(vcount * stride);
+    memset(remap, 0xff, vcount * sizeof(uint32_t));
+
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < icount; ++i)
+    {
+        uint32_t v = indices[i];
+        if (remap[v] == UINT32_MAX) {
+            memcpy(tmp + next * stride, verts + v * stride, stride);
+            remap[v] = next++;
+        }
+        indices[i] = remap[v];
+    }
+    memcpy(verts, tmp, next * stride);
+
+    gs_free(remap);
+    gs_free(tmp);
+    return next;
+}
+
+void gs_asset_mesh_optimize(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count, const gs_asset_mesh_decl_t* decl, uint32_t flags)
+{
+    if (!meshes || !flags) return;
+    if (!decl || !decl->layout) {
+        gs_println("Warning:MeshOptimize:Layout required to optimize");
+        return;
+    }
+
+    // Vertex stride and position offset from layout
+    const uint32_t layout_ct = (uint32_t)(decl->layout_size / sizeof(gs_asset_mesh_layout_t));
+    size_t stride = 0, pos_offset = SIZE_MAX;
+    for (uint32_t l = 0; l < layout_ct; ++l) {
+        if (decl->layout[l].type == GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION && pos_offset == SIZE_MAX) pos_offset = stride;
+        stride += gs_asset_mesh_attribute_size(decl->layout[l].type, false);
+    }
+    const size_t isz = decl->index_buffer_element_size == 4 ? 4 : 2;
+    if (!stride) return;
+
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* m = &meshes[i];
+        for (uint32_t p = 0; p < m->prim_count; ++p)
+        {
+            uint8_t* verts = (uint8_t*)m->vertices[p];
+            uint32_t vcount = (uint32_t)(m->vertex_sizes[p] / stride);
+            uint32_t tri_count = (uint32_t)(m->index_sizes[p] / isz / 3);
+            uint32_t icount = tri_count * 3;
+            if (!vcount || !tri_count) continue;
+
+            // Widen indices for processing
+            uint32_t* idx = (uint32_t*)gs_malloc(icount * sizeof(uint32_t));
+            bool32_t valid = true;
+            for (uint32_t k = 0; k < icount; ++k) {
+                idx[k] = isz == 4 ? ((uint32_t*)m->indices[p])[k] : ((uint16_t*)m->indices[p])[k];
+                valid &= idx[k] < vcount;
+            }
+            if (!valid) {
+                gs_println("Warning:MeshOptimize:Index out of range, skipping primitive: %u", p);
+                gs_free(idx);
+                continue;
+            }
+
+            if (flags & GS_ASSET_MESH_OPTIMIZE_WELD) {
+                vcount = __gs_mesh_opt_weld(verts, vcount, stride, idx, icount);
+            }
+
+            // Overdraw sorts the clusters found by the vertex cache pass
+            if (flags & (GS_ASSET_MESH_OPTIMIZE_VERTEX_CACHE | GS_ASSET_MESH_OPTIMIZE_OVERDRAW))
+            {
+                uint32_t* ordered = (uint32_t*)gs_malloc(icount * sizeof(uint32_t));
+                uint32_t* clusters = (uint32_t*)gs_malloc((tri_count + 1) * sizeof(uint32_t));
+                uint32_t cluster_ct = __gs_mesh_opt_tipsify(idx, ordered, tri_count, vcount, GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE, clusters);
+                if ((flags & GS_ASSET_MESH_OPTIMIZE_OVERDRAW) && pos_offset != SIZE_MAX && cluster_ct > 1) {
+                    __gs_mesh_opt_overdraw(ordered, tri_count, verts, stride, pos_offset, clusters, cluster_ct);
                 }
+                gs_free(idx);
+                gs_free(clusters);
+                idx = ordered;
             }
 
-            // Indices for primitive
-            cgltf_accessor* acc = data->meshes[i].primitives[p].indices;
+            if (flags & GS_ASSET_MESH_OPTIMIZE_VERTEX_FETCH) {
+                vcount = __gs_mesh_opt_fetch(verts, vcount, stride, idx, icount);
+            }
 
-            #define __GLTF_PUSH_IDX(BB, ACC, TYPE)\
-                do {\
-                    int32_t n = 0;\
-                    TYPE* buf = (TYPE*)acc->buffer_view->buffer->data + acc->buffer_view->offset/sizeof(TYPE) + acc->offset/sizeof(TYPE);\
-                    gs_assert(buf);\
-                    TYPE v = 0;\
-                    /* For each index */\
-                    for (uint32_t k = 0; k < acc->count; k++) {\
-                        /* For each element */\
-                        for (int l = 0; l < 1; l++) {\
-                            v = buf[n + l];\
-                        }\
-                        n += (int32_t)(acc->stride/sizeof(TYPE));\
-                        /* Add to temp positions array */\
-                        switch (index_element_size) {\
-                            case 0: gs_byte_buffer_write(BB, uint16_t, (uint16_t)v); break;\
-                            case 2: gs_byte_buffer_write(BB, uint16_t, (uint16_t)v); break;\
-                            case 4: gs_byte_buffer_write(BB, uint32_t, (uint32_t)v); break;\
-                        }\
-                    }\
-                } while (0)
+            // Narrow back, vertex buffer keeps its allocation
+            for (uint32_t k = 0; k < icount; ++k) {
+                if (isz == 4) ((uint32_t*)m->indices[p])[k] = idx[k];
+                else          ((uint16_t*)m->indices[p])[k] = (uint16_t)idx[k];
+            }
+            m->vertex_sizes[p] = vcount * stride;
+            gs_free(idx);
+        }
+    }
+}
+
+/*== Mesh Simplification ==*/
+
+// Symmetric 4x4 plane quadric, unweighted so the error is the sum of squared distances to every accumulated plane,
+// whose square root bounds the distance to the farthest one
+typedef struct __gs_mesh_quadric_t
+{
+    double a2, b2, c2, ab, ac, bc, ad, bd, cd, d2;
+} __gs_mesh_quadric_t;
+
+static void __gs_mesh_quadric_add(__gs_mesh_quadric_t* q, const __gs_mesh_quadric_t* o)
+{
+    q->a2 += o->a2; q->b2 += o->b2; q->c2 += o->c2; q->ab += o->ab; q->ac += o->ac; q->bc += o->bc;
+    q->ad += o->ad; q->bd += o->bd; q->cd += o->cd; q->d2 += o->d2;
+}
+
+static double __gs_mesh_quadric_error(const __gs_mesh_quadric_t* q, gs_vec3 p)
+{
+    double x = p.x, y = p.y, z = p.z;
+    double e = q->a2 * x * x + q->b2 * y * y + q->c2 * z * z + 
+        2.0 * (q->ab * x * y + q->ac * x * z + q->bc * y * z) + 
+        2.0 * (q->ad * x + q->bd * y + q->cd * z) + q->d2;
+    return gs_max(e, 0.0);
+}
+
+typedef struct __gs_mesh_collapse_t
+{
+    double cost;
+    uint32_t v0;    // Collapsed vertex
+    uint32_t v1;    // Target vertex
+} __gs_mesh_collapse_t;
+
+static int __gs_mesh_collapse_cmp(const void* a, const void* b)
+{
+    double ca = ((const __gs_mesh_collapse_t*)a)->cost;
+    double cb = ((const __gs_mesh_collapse_t*)b)->cost;
+    return ca < cb ? -1 : ca > cb ? 1 : 0;
+}
+
+/*
+    Greedy half edge collapse (Garland, Heckbert 1997) onto existing vertices, so the vertex buffer is shared 
+    by all levels. Attribute seams and open borders are locked. Each pass collapses cheapest independent edges 
+    until target_icount is met or nothing collapses. Returns new index count, out_error bounds how far the result
+    strays from the input surface.
+*/
+static uint32_t __gs_mesh_opt_simplify(uint32_t* indices, uint32_t icount, const uint8_t* verts, uint32_t vcount, 
+    size_t stride, size_t pos_offset, uint32_t target_icount, float* out_error)
+{
+    #define __GS_MESH_OPT_POS(I) (*(const gs_vec3*)(verts + (I) * stride + pos_offset))
+
+    uint32_t* canon = (uint32_t*)gs_malloc(vcount * sizeof(uint32_t));
+    uint8_t* locked = (uint8_t*)gs_malloc(vcount);
+    uint8_t* dirty = (uint8_t*)gs_malloc(vcount);
+    uint32_t* remap = (uint32_t*)gs_malloc(vcount * sizeof(uint32_t));
+    uint32_t* adj_offsets = (uint32_t*)gs_malloc((vcount + 1) * sizeof(uint32_t));
+    uint32_t* adj = (uint32_t*)gs_malloc(gs_max(icount, 1) * sizeof(uint32_t));
+    __gs_mesh_quadric_t* quadrics = (__gs_mesh_quadric_t*)gs_malloc(vcount * sizeof(__gs_mesh_quadric_t));
+    __gs_mesh_collapse_t* collapses = (__gs_mesh_collapse_t*)gs_malloc(gs_max(icount * 2, 1) * sizeof(__gs_mesh_collapse_t));
+    memset(locked, 0, vcount);
+    memset(quadrics, 0, vcount * sizeof(__gs_mesh_quadric_t));
+
+    // Group vertices by position, groups with several vertices are attribute seams
+    {
+        uint32_t cap = 1;
+        while (cap < vcount * 2) cap <<= 1;
+        uint32_t* table = (uint32_t*)gs_malloc(cap * sizeof(uint32_t));
+        memset(table, 0, cap * sizeof(uint32_t));
+        for (uint32_t v = 0; v < vcount; ++v)
+        {
+            gs_vec3 p = __GS_MESH_OPT_POS(v);
+            size_t h = gs_hash_bytes(&p, sizeof(p), 0) & (cap - 1);
+            for (;;) {
+                uint32_t e = table[h];
+                if (!e) {table[h] = v + 1; canon[v] = v; break;}
+                gs_vec3 q = __GS_MESH_OPT_POS(e - 1);
+                if (memcmp(&p, &q, sizeof(p)) == 0) {canon[v] = e - 1; locked[v] = locked[e - 1] = 1; break;}
+                h = (h + 1) & (cap - 1);
+            }
+        }
+        gs_free(table);
+    }
+
+    // Lock open borders: position space edges used by a single triangle
+    {
+        uint32_t cap = 1;
+        while (cap < icount * 2) cap <<= 1;
+        uint64_t* keys = (uint64_t*)gs_malloc(cap * sizeof(uint64_t));
+        uint32_t* counts = (uint32_t*)gs_malloc(cap * sizeof(uint32_t));
+        memset(counts, 0, cap * sizeof(uint32_t));
+        for (uint32_t i = 0; i < icount; ++i)
+        {
+            uint32_t a = canon[indices[i]], b = canon[indices[i - i % 3 + (i + 1) % 3]];
+            uint64_t key = a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+            size_t h = gs_hash_bytes(&key, sizeof(key), 0) & (cap - 1);
+            while (counts[h] && keys[h] != key) h = (h + 1) & (cap - 1);
+            keys[h] = key;
+            counts[h]++;
+        }
+        for (uint32_t h = 0; h < cap; ++h) {
+            if (counts[h] == 1) {
+                locked[(uint32_t)(keys[h] >> 32)] = 1;
+                locked[(uint32_t)(keys[h] & 0xffffffff)] = 1;
+            }
+        }
+        for (uint32_t v = 0; v < vcount; ++v) locked[v] |= locked[canon[v]];
+        gs_free(keys);
+        gs_free(counts);
+    }
+
+    // Face quadrics
+    for (uint32_t t = 0; t < icount / 3; ++t)
+    {
+        gs_vec3 p0 = __GS_MESH_OPT_POS(indices[t * 3 + 0]);
+        gs_vec3 p1 = __GS_MESH_OPT_POS(indices[t * 3 + 1]);
+        gs_vec3 p2 = __GS_MESH_OPT_POS(indices[t * 3 + 2]);
+        gs_vec3 n = gs_vec3_cross(gs_vec3_sub(p1, p0), gs_vec3_sub(p2, p0));
+        if (gs_vec3_len(n) <= 0.f) continue;
+        n = gs_vec3_norm(n);
+        double a = n.x, b = n.y, c = n.z, d = -gs_vec3_dot(n, p0);
+        __gs_mesh_quadric_t q = {a * a, b * b, c * c, a * b, a * c, b * c, a * d, b * d, c * d, d * d};
+        for (uint32_t c = 0; c < 3; ++c) __gs_mesh_quadric_add(&quadrics[indices[t * 3 + c]], &q);
+    }
+
+    double max_cost = 0.0;
+    for (uint32_t pass = 0; pass < 64 && icount > target_icount; ++pass)
+    {
+        // Vertex -> triangle adjacency
+        memset(adj_offsets, 0, (vcount + 1) * sizeof(uint32_t));
+        for (uint32_t i = 0; i < icount; ++i) adj_offsets[indices[i] + 1]++;
+        for (uint32_t v = 0; v < vcount; ++v) adj_offsets[v + 1] += adj_offsets[v];
+        for (uint32_t i = 0; i < icount; ++i) adj[adj_offsets[indices[i]]++] = i / 3;
+        for (uint32_t v = vcount; v > 0; --v) adj_offsets[v] = adj_offsets[v - 1];
+        adj_offsets[0] = 0;
+
+        // Candidate collapses along each triangle edge, both directions
+        uint32_t ct = 0;
+        for (uint32_t i = 0; i < icount; ++i)
+        {
+            uint32_t a = indices[i], b = indices[i - i % 3 + (i + 1) % 3];
+            if (a == b) continue;
+            for (uint32_t k = 0; k < 2; ++k) 
+            {
+                uint32_t v0 = k ? b : a, v1 = k ? a : b;
+                if (locked[v0]) continue;
+                __gs_mesh_quadric_t q = quadrics[v0];
+                __gs_mesh_quadric_add(&q, &quadrics[v1]);
+                collapses[ct].cost = __gs_mesh_quadric_error(&q, __GS_MESH_OPT_POS(v1));
+                collapses[ct].v0 = v0;
+                collapses[ct].v1 = v1;
+                ct++;
+            }
+        }
+        qsort(collapses, ct, sizeof(__gs_mesh_collapse_t), __gs_mesh_collapse_cmp);
+
+        memset(dirty, 0, vcount);
+        for (uint32_t v = 0; v < vcount; ++v) remap[v] = v;
+
+        uint32_t tris = icount / 3, target_tris = target_icount / 3, collapsed = 0;
+        for (uint32_t c = 0; c < ct && tris > target_tris; ++c)
+        {
+            uint32_t a = collapses[c].v0, b = collapses[c].v1;
+            if (dirty[a] || dirty[b]) continue;
+
+            // Reject collapses that flip a face, count faces that degenerate
+            gs_vec3 pb = __GS_MESH_OPT_POS(b);
+            uint32_t removed = 0;
+            bool32_t flips = false;
+            for (uint32_t k = adj_offsets[a]; k < adj_offsets[a + 1] && !flips; ++k)
+            {
+                const uint32_t* tri = &indices[adj[k] * 3];
+                if (tri[0] == b || tri[1] == b || tri[2] == b) {removed++; continue;}
+                gs_vec3 p[3], q[3];
+                for (uint32_t j = 0; j < 3; ++j) {
+                    p[j] = __GS_MESH_OPT_POS(tri[j]);
+                    q[j] = tri[j] == a ? pb : p[j];
+                }
+                gs_vec3 n0 = gs_vec3_cross(gs_vec3_sub(p[1], p[0]), gs_vec3_sub(p[2], p[0]));
+                gs_vec3 n1 = gs_vec3_cross(gs_vec3_sub(q[1], q[0]), gs_vec3_sub(q[2], q[0]));
+                flips = gs_vec3_dot(n0, n1) <= 0.f;
+            }
+            if (flips) continue;
+
+            remap[a] = b;
+            __gs_mesh_quadric_add(&quadrics[b], &quadrics[a]);
+            max_cost = gs_max(max_cost, collapses[c].cost);
+            tris -= gs_min(removed, tris);
+            collapsed++;
+
+            // Neighborhood is frozen for the rest of the pass, keeps flip tests valid
+            for (uint32_t k = adj_offsets[a]; k < adj_offsets[a + 1]; ++k) {
+                const uint32_t* tri = &indices[adj[k] * 3];
+                dirty[tri[0]] = dirty[tri[1]] = dirty[tri[2]] = 1;
+            }
+        }
+
+        if (!collapsed) break;
+
+        // Apply remap, drop degenerate faces
+        uint32_t w = 0;
+        for (uint32_t t = 0; t < icount / 3; ++t)
+        {
+            uint32_t i0 = remap[indices[t * 3 + 0]], i1 = remap[indices[t * 3 + 1]], i2 = remap[indices[t * 3 + 2]];
+            if (i0 == i1 || i1 == i2 || i0 == i2) continue;
+            indices[w++] = i0; indices[w++] = i1; indices[w++] = i2;
+        }
+        icount = w;
+    }
+
+    *out_error = (float)sqrt(max_cost);
+
+    #undef __GS_MESH_OPT_POS
+
+    gs_free(canon);
+    gs_free(locked);
+    gs_free(dirty);
+    gs_free(remap);
+    gs_free(adj_offsets);
+    gs_free(adj);
+    gs_free(quadrics);
+    gs_free(collapses);
+    return icount;
+}
+
+void gs_asset_mesh_generate_lods(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count, const gs_asset_mesh_decl_t* decl)
+{
+    if (!meshes || !decl || !decl->lod_count) return;
+
+    const uint32_t layout_ct = (uint32_t)(decl->layout_size / sizeof(gs_asset_mesh_layout_t));
+    size_t stride = 0, pos_offset = SIZE_MAX;
+    for (uint32_t l = 0; decl->layout && l < layout_ct; ++l) {
+        if (decl->layout[l].type == GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION && pos_offset == SIZE_MAX) pos_offset = stride;
+        stride += gs_asset_mesh_attribute_size(decl->layout[l].type, false);
+    }
+    if (pos_offset == SIZE_MAX) {
+        gs_println("Warning:MeshLods:Layout with position attribute required to generate lods");
+        return;
+    }
+
+    const size_t isz = decl->index_buffer_element_size == 4 ? 4 : 2;
+    const uint32_t lod_count = gs_min(decl->lod_count, GS_ASSET_MESH_MAX_LODS - 1);
+    const float ratio = (decl->lod_ratio > 0.f && decl->lod_ratio < 1.f) ? decl->lod_ratio : 0.5f;
+    const bool32_t reorder = decl->optimize & GS_ASSET_MESH_OPTIMIZE_VERTEX_CACHE;
+
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* m = &meshes[i];
+        if (!m->prim_count || m->lod_counts) continue;
+        m->lod_counts = (uint32_t*)gs_malloc(m->prim_count * sizeof(uint32_t));
+        m->lods = (gs_asset_mesh_lod_t*)gs_malloc(m->prim_count * GS_ASSET_MESH_MAX_LODS * sizeof(gs_asset_mesh_lod_t));
+        memset(m->lods, 0, m->prim_count * GS_ASSET_MESH_MAX_LODS * sizeof(gs_asset_mesh_lod_t));
+
+        for (uint32_t p = 0; p < m->prim_count; ++p)
+        {
+            const uint8_t* verts = (const uint8_t*)m->vertices[p];
+            const uint32_t vcount = (uint32_t)(m->vertex_sizes[p] / stride);
+            const uint32_t icount = (uint32_t)(m->index_sizes[p] / isz);
+            gs_asset_mesh_lod_t* lods = &m->lods[p * GS_ASSET_MESH_MAX_LODS];
+            lods[0].count = icount;
+            m->lod_counts[p] = 1;
+            if (!vcount || icount < 3 || icount % 3) continue;
+
+            // Widen indices, levels are appended after full detail
+            uint32_t* all = (uint32_t*)gs_malloc(icount * (lod_count + 1) * sizeof(uint32_t));
+            bool32_t valid = true;
+            for (uint32_t k = 0; k < icount; ++k) {
+                all[k] = isz == 4 ? ((uint32_t*)m->indices[p])[k] : ((uint16_t*)m->indices[p])[k];
+                valid &= all[k] < vcount;
+            }
+            if (!valid) {
+                gs_println("Warning:MeshLods:Index out of range, skipping primitive: %u", p);
+                gs_free(all);
+                continue;
+            }
+
+            // Bounding radius, level errors are stored relative to it
+            gs_vec3 mn = *(const gs_vec3*)(verts + pos_offset), mx = mn;
+            for (uint32_t v = 1; v < vcount; ++v) {
+                gs_vec3 pv = *(const gs_vec3*)(verts + v * stride + pos_offset);
+                mn = gs_v3(gs_min(mn.x, pv.x), gs_min(mn.y, pv.y), gs_min(mn.z, pv.z));
+                mx = gs_v3(gs_max(mx.x, pv.x), gs_max(mx.y, pv.y), gs_max(mx.z, pv.z));
+            }
+            float radius = gs_vec3_len(gs_vec3_sub(mx, mn)) * 0.5f;
+
+            uint32_t total = icount, prev = 0, prev_count = icount;
+            for (uint32_t l = 1; l <= lod_count; ++l)
+            {
+                uint32_t* cur = all + total;
+                memcpy(cur, all + prev, prev_count * sizeof(uint32_t));
+                uint32_t target = (uint32_t)(prev_count / 3 * ratio) * 3;
+                float err = 0.f;
+                uint32_t ct = __gs_mesh_opt_simplify(cur, prev_count, verts, vcount, stride, pos_offset, target, &err);
+
+                // Stop once simplification stalls (locked borders, seams)
+                if (!ct || ct > prev_count - prev_count / 10) break;
+
+                if (reorder) {
+                    uint32_t* tmp = (uint32_t*)gs_malloc(ct * sizeof(uint32_t));
+                    uint32_t* clusters = (uint32_t*)gs_malloc((ct / 3 + 1) * sizeof(uint32_t));
+                    __gs_mesh_opt_tipsify(cur, tmp, ct / 3, vcount, GS_ASSET_MESH_OPTIMIZE_CACHE_SIZE, clusters);
+                    memcpy(cur, tmp, ct * sizeof(uint32_t));
+                    gs_free(tmp);
+                    gs_free(clusters);
+                }
+
+                lods[l].start = (uint32_t)(total * isz);
+                lods[l].count = ct;
+                // Each level is simplified from the previous one, so deviations from full detail add up
+                lods[l].error = lods[l - 1].error + (radius > 0.f ? err / radius : 0.f);
+                m->lod_counts[p]++;
+                prev = total;
+                prev_count = ct;
+                total += ct;
+            }
+
+            // Narrow all levels back into primitive index data
+            if (total > icount)
+            {
+                void* indices = gs_malloc(total * isz);
+                for (uint32_t k = 0; k < total; ++k) {
+                    if (isz == 4) ((uint32_t*)indices)[k] = all[k];
+                    else          ((uint16_t*)indices)[k] = (uint16_t)all[k];
+                }
+                gs_free(m->indices[p]);
+                m->indices[p] = indices;
+                m->index_sizes[p] = total * isz;
+            }
+            gs_free(all);
+        }
+    }
+}
+
+/*== Mesh Quantization ==*/
+
+static uint16_t __gs_mesh_f32_to_f16(float f)
+{
+    uint32_t x;
+    memcpy(&x, &f, sizeof(x));
+    uint32_t sign = (x >> 16) & 0x8000, mant = x & 0x7fffff;
+    int32_t exp = (int32_t)((x >> 23) & 0xff) - 127 + 15;
+
+    if (((x >> 23) & 0xff) == 0xff) return (uint16_t)(sign | 0x7c00 | (mant ? 0x200 : 0));
+    if (exp >= 31) return (uint16_t)(sign | 0x7c00);
+
+    // Denormal, round to nearest
+    if (exp <= 0) {
+        if (exp < -10) return (uint16_t)sign;
+        mant |= 0x800000;
+        uint32_t shift = (uint32_t)(14 - exp);
+        uint32_t h = mant >> shift;
+        if ((mant >> (shift - 1)) & 1) h++;
+        return (uint16_t)(sign | h);
+    }
+
+    // Round to nearest, mantissa carry correctly bumps exponent
+    uint32_t h = sign | ((uint32_t)exp << 10) | (mant >> 13);
+    if (mant & 0x1000) h++;
+    return (uint16_t)h;
+}
+
+static int16_t __gs_mesh_snorm16(float v)
+{
+    v = gs_clamp(v, -1.f, 1.f);
+    return (int16_t)(v * 32767.f + (v >= 0.f ? 0.5f : -0.5f));
+}
+
+static int32_t __gs_mesh_snorm10(float v)
+{
+    v = gs_clamp(v, -1.f, 1.f);
+    return (int32_t)(v * 511.f + (v >= 0.f ? 0.5f : -0.5f));
+}
+
+// Octahedral unit vector mapping (Cigolle et al. 2014) into [-1, 1]^2
+static gs_vec2 __gs_mesh_oct_encode(gs_vec3 n)
+{
+    float l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+    if (l1 <= 0.f) return gs_v2(0.f, 0.f);
+    float x = n.x / l1, y = n.y / l1;
+    if (n.z < 0.f) {
+        float ox = (1.f - fabsf(y)) * (x >= 0.f ? 1.f : -1.f);
+        float oy = (1.f - fabsf(x)) * (y >= 0.f ? 1.f : -1.f);
+        x = ox; y = oy;
+    }
+    return gs_v2(x, y);
+}
+
+void gs_asset_mesh_quantize(gs_asset_mesh_raw_data_t* meshes, uint32_t mesh_count, const gs_asset_mesh_decl_t* decl)
+{
+    if (!meshes || !decl || !decl->quantize) return;
+    if (!decl->layout) {
+        gs_println("Warning:MeshQuantize:Layout required to quantize");
+        return;
+    }
+
+    const uint32_t layout_ct = (uint32_t)(decl->layout_size / sizeof(gs_asset_mesh_layout_t));
+    size_t stride = 0, qstride = 0, pos_offset = SIZE_MAX;
+    for (uint32_t l = 0; l < layout_ct; ++l) {
+        if (decl->layout[l].type == GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION && pos_offset == SIZE_MAX) pos_offset = stride;
+        stride += gs_asset_mesh_attribute_size(decl->layout[l].type, false);
+        qstride += gs_asset_mesh_attribute_size(decl->layout[l].type, true);
+    }
+    if (!stride) return;
+
+    for (uint32_t i = 0; i < mesh_count; ++i)
+    {
+        gs_asset_mesh_raw_data_t* m = &meshes[i];
+        if (!m->prim_count || m->dequant) continue;
+        m->dequant = (gs_asset_mesh_dequant_t*)gs_malloc(m->prim_count * sizeof(gs_asset_mesh_dequant_t));
 
-            // If indices are available
-            if (acc) 
+        for (uint32_t p = 0; p < m->prim_count; ++p)
+        {
+            const uint8_t* src = (const uint8_t*)m->vertices[p];
+            const uint32_t vcount = (uint32_t)(m->vertex_sizes[p] / stride);
+            gs_asset_mesh_dequant_t* dq = &m->dequant[p];
+            dq->offset = gs_v3(0.f, 0.f, 0.f);
+            dq->scale = gs_v3(1.f, 1.f, 1.f);
+
+            // Positions map bounds onto [-1, 1]
+            if (pos_offset != SIZE_MAX && vcount)
             {
-                switch (acc->component_type) 
-                {
-                    case cgltf_component_type_r_8:   __GLTF_PUSH_IDX(&i_data, acc, int8_t);   break;
-                    case cgltf_component_type_r_8u:  __GLTF_PUSH_IDX(&i_data, acc, uint8_t);  break;
-                    case cgltf_component_type_r_16:  __GLTF_PUSH_IDX(&i_data, acc, int16_t);  break;
-                    case cgltf_component_type_r_16u: __GLTF_PUSH_IDX(&i_data, acc, uint16_t); break;
-                    case cgltf_component_type_r_32u: __GLTF_PUSH_IDX(&i_data, acc, uint32_t); break;
-                    case cgltf_component_type_r_32f: __GLTF_PUSH_IDX(&i_data, acc, float);    break;
-
-                    // Shouldn't hit here
-                    default: {
-                    } break;
+                gs_vec3 mn = *(const gs_vec3*)(src + pos_offset), mx = mn;
+                for (uint32_t v = 1; v < vcount; ++v) {
+                    gs_vec3 pv = *(const gs_vec3*)(src + v * stride + pos_offset);
+                    mn = gs_v3(gs_min(mn.x, pv.x), gs_min(mn.y, pv.y), gs_min(mn.z, pv.z));
+                    mx = gs_v3(gs_max(mx.x, pv.x), gs_max(mx.y, pv.y), gs_max(mx.z, pv.z));
                 }
+                dq->offset = gs_vec3_scale(gs_vec3_add(mn, mx), 0.5f);
+                dq->scale = gs_vec3_scale(gs_vec3_sub(mx, mn), 0.5f);
+                dq->scale = gs_v3(gs_max(dq->scale.x, 1e-8f), gs_max(dq->scale.y, 1e-8f), gs_max(dq->scale.z, 1e-8f));
             }
-            else 
+
+            uint8_t* dst = (uint8_t*)gs_malloc(gs_max(vcount * qstride, 1));
+            for (uint32_t v = 0; v < vcount; ++v)
             {
-                // Iterate over positions size, then just push back indices
-                for (uint32_t i = 0; i < gs_dyn_array_size(positions); ++i) 
+                const uint8_t* s = src + v * stride;
+                uint8_t* d = dst + v * qstride;
+                for (uint32_t l = 0; l < layout_ct; ++l)
                 {
-                    switch (index_element_size)
+                    const gs_asset_mesh_attribute_type type = decl->layout[l].type;
+                    switch (type)
                     {
-                        default:
-                        case 0: gs_byte_buffer_write(&i_data, uint16_t, (uint16_t)i); break;
-                        case 2: gs_byte_buffer_write(&i_data, uint16_t, (uint16_t)i); break;
-                        case 4: gs_byte_buffer_write(&i_data, uint32_t, (uint32_t)i); break;
+                        case GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION: {
+                            gs_vec3 pv = *(const gs_vec3*)s;
+                            int16_t q[4] = {
+                                __gs_mesh_snorm16((pv.x - dq->offset.x) / dq->scale.x),
+                                __gs_mesh_snorm16((pv.y - dq->offset.y) / dq->scale.y),
+                                __gs_mesh_snorm16((pv.z - dq->offset.z) / dq->scale.z),
+                                32767
+                            };
+                            memcpy(d, q, sizeof(q));
+                        } break;
+
+                        case GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL: {
+                            gs_vec2 e = __gs_mesh_oct_encode(*(const gs_vec3*)s);
+                            int16_t q[2] = {__gs_mesh_snorm16(e.x), __gs_mesh_snorm16(e.y)};
+                            memcpy(d, q, sizeof(q));
+                        } break;
+
+                        case GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT: {
+                            gs_vec3 t = gs_vec3_norm(*(const gs_vec3*)s);
+                            uint32_t q = ((uint32_t)__gs_mesh_snorm10(t.x) & 0x3ff) | 
+                                (((uint32_t)__gs_mesh_snorm10(t.y) & 0x3ff) << 10) | 
+                                (((uint32_t)__gs_mesh_snorm10(t.z) & 0x3ff) << 20) | (1u << 30);
+                            memcpy(d, &q, sizeof(q));
+                        } break;
+
+                        case GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD: {
+                            gs_vec2 uv = *(const gs_vec2*)s;
+                            uint16_t q[2] = {__gs_mesh_f32_to_f16(uv.x), __gs_mesh_f32_to_f16(uv.y)};
+                            memcpy(d, q, sizeof(q));
+                        } break;
+
+                        default: {
+                            memcpy(d, s, gs_asset_mesh_attribute_size(type, true));
+                        } break;
                     }
+                    s += gs_asset_mesh_attribute_size(type, false);
+                    d += gs_asset_mesh_attribute_size(type, true);
                 }
             }
 
-            bool warnings[gs_enum_count(gs_asset_mesh_attribute_type)] = gs_default_val();
+            gs_free(m->vertices[p]);
+            m->vertices[p] = dst;
+            m->vertex_sizes[p] = vcount * qstride;
+        }
+    }
+}
 
-            // Grab mesh layout pointer to use
-            gs_asset_mesh_layout_t* layoutp = decl ? decl->layout : layouts;
-            uint32_t layout_ct = decl ? decl->layout_size / sizeof(gs_asset_mesh_layout_t) : gs_dyn_array_size(layouts);
+gs_asset_mesh_lod_select_t gs_asset_mesh_lod_select(const gs_asset_mesh_primitive_t* prim, gs_camera_t* cam, 
+    gs_vec3 center, float radius, int32_t view_height, float fade_band)
+{
+    gs_asset_mesh_lod_select_t sel = gs_default_val();
+    if (!prim || !cam || prim->lod_count <= 1) return sel;
 
-            // Iterate layout to fill data buffers according to provided layout
-            {
-                uint32_t vct = 0; 
-                vct = gs_max(vct, gs_dyn_array_size(positions)); 
-                vct = gs_max(vct, gs_dyn_array_size(colors)); 
-                vct = gs_max(vct, gs_dyn_array_size(uvs));
-                vct = gs_max(vct, gs_dyn_array_size(normals));
-                vct = gs_max(vct, gs_dyn_array_size(tangents));
+    // World units to pixels at sphere distance
+    float px_per_unit = 0.f;
+    switch (cam->proj_type)
+    {
+        case GS_PROJECTION_TYPE_PERSPECTIVE: {
+            float dist = gs_max(gs_vec3_len(gs_vec3_sub(center, cam->transform.position)), cam->near_plane);
+            px_per_unit = (float)view_height / (2.f * dist * (float)tan(gs_deg2rad(0.5f * cam->fov)));
+        } break;
 
-                #define __GLTF_WRITE_DATA(IT, VDATA, ARR, ARR_TYPE, ARR_DEF_VAL, LAYOUT_TYPE)\
-                    do {\
-                        /* Grab data at index, if available */\
-                        if (IT < gs_dyn_array_size(ARR)) {\
-                            gs_byte_buffer_write(&(VDATA), ARR_TYPE, ARR[IT]);\
-                        }\
-                        else {\
-                            /* Write default value and give warning.*/\
-                            gs_byte_buffer_write(&(VDATA), ARR_TYPE, ARR_DEF_VAL);\
-                            if (!warnings[LAYOUT_TYPE]) {\
-                                gs_println("Warning:Mesh:LoadFromFile:%s:Index out of range.", #LAYOUT_TYPE);\
-                                warnings[LAYOUT_TYPE] = true;\
-                            }\
-                        }\
-                    } while (0)
+        default: {
+            px_per_unit = (float)view_height / (2.f * gs_max(cam->ortho_scale, 1e-6f));
+        } break;
+    }
 
-                for (uint32_t it = 0; it < vct; ++it)
-                {
-                    // For each attribute in layout
-                    for (uint32_t l = 0; l < layout_ct; ++l)
-                    {
-                        switch (layoutp[l].type)
-                        {
-                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION: {
-                                __GLTF_WRITE_DATA(it, v_data, positions, gs_vec3, gs_v3(0.f, 0.f, 0.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_POSITION); 
-                            } break;
+    const float px_radius = radius * px_per_unit;
+    const float threshold = GS_ASSET_MESH_LOD_PIXEL_ERROR;
+    for (uint32_t l = 1; l < prim->lod_count; ++l) {
+        if (prim->lods[l].error * px_radius > threshold) break;
+        sel.lod = l;
+    }
 
-                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD: {
-                                __GLTF_WRITE_DATA(it, v_data, uvs, gs_vec2, gs_v2(0.f, 0.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_TEXCOORD); 
-                            } break;
+    // Blend towards next coarser level as its error nears threshold
+    sel.fade_lod = sel.lod;
+    if (fade_band > 0.f && sel.lod + 1 < prim->lod_count) {
+        float next = prim->lods[sel.lod + 1].error * px_radius;
+        sel.fade = gs_clamp(1.f - (next - threshold) / (threshold * fade_band), 0.f, 1.f);
+        if (sel.fade > 0.f) sel.fade_lod = sel.lod + 1;
+    }
 
-                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR: {
-                                __GLTF_WRITE_DATA(it, v_data, colors, gs_color_t, GS_COLOR_WHITE, GS_ASSET_MESH_ATTRIBUTE_TYPE_COLOR); 
-                            } break;
+    return sel;
+}
 
-                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL: {
-                                __GLTF_WRITE_DATA(it, v_data, normals, gs_vec3, gs_v3(0.f, 0.f, 1.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_NORMAL); 
-                            } break;
+gs_result gs_asset_mesh_cook(const char* src_path, const char* out_path, const gs_asset_mesh_cook_desc_t* desc)
+{
+    if (!desc || !desc->decl.layout || !desc->decl.layout_size) {
+        gs_println("Warning:MeshCook:Layout required to cook: %s", src_path);
+        return GS_RESULT_FAILURE;
+    }
 
-                            case GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT: {
-                                __GLTF_WRITE_DATA(it, v_data, tangents, gs_vec3, gs_v3(0.f, 1.f, 0.f), GS_ASSET_MESH_ATTRIBUTE_TYPE_TANGENT); 
-                            } break;
+    gs_asset_mesh_decl_t decl = desc->decl;
+    decl.index_buffer_element_size = decl.index_buffer_element_size == 4 ? 4 : 2;
+    const gs_asset_mesh_layout_t* layout = decl.layout;
+    const uint32_t layout_ct = (uint32_t)(decl.layout_size / sizeof(gs_asset_mesh_layout_t));
 
-                            default:
-                            {
-                            } break;
+    if (desc->non_interleaved && layout_ct > GS_ASSET_MESH_MAX_STREAMS) {
+        gs_println("Warning:MeshCook:Too many attribute streams: %u", layout_ct);
+        return GS_RESULT_FAILURE;
+    }
+
+    size_t attr_offsets[GS_ASSET_MESH_MAX_STREAMS] = gs_default_val();
+    size_t stride = 0;
+    for (uint32_t l = 0; l < layout_ct; ++l) {
+        if (l < GS_ASSET_MESH_MAX_STREAMS) attr_offsets[l] = stride;
+        stride += gs_asset_mesh_attribute_size(layout[l].type, decl.quantize);
+    }
+
+    uint32_t mesh_count = 0;
+    gs_asset_mesh_raw_data_t* meshes = NULL;
+    gs_util_load_gltf_data_from_file(src_path, &decl, &meshes, &mesh_count);
+    if (!meshes || !stride) {
+        gs_asset_mesh_raw_data_free(meshes, mesh_count);
+        return GS_RESULT_FAILURE;
+    }
+    gs_asset_mesh_optimize(meshes, mesh_count, &decl, decl.optimize);
+    gs_asset_mesh_generate_lods(meshes, mesh_count, &decl);
+    gs_asset_mesh_quantize(meshes, mesh_count, &decl);
+
+    // Primitives of all meshes are flattened into one cooked mesh
+    uint32_t prim_count = 0;
+    for (uint32_t i = 0; i < mesh_count; ++i) prim_count += meshes[i].prim_count;
+
+    gs_asset_mesh_cook_header_t hdr = gs_default_val();
+    hdr.magic = GS_ASSET_MESH_COOK_MAGIC;
+    hdr.version = GS_ASSET_MESH_COOK_VERSION;
+    hdr.non_interleaved = desc->non_interleaved ? 1 : 0;
+    hdr.index_element_size = (uint32_t)decl.index_buffer_element_size;
+    hdr.prim_count = prim_count;
+    hdr.layout_count = layout_ct;
+    hdr.quantized = decl.quantize ? 1 : 0;
+
+    #define __GS_MESH_COOK_ALIGN(N) (((N) + (GS_ASSET_MESH_COOK_ALIGNMENT - 1)) & ~((uint64_t)GS_ASSET_MESH_COOK_ALIGNMENT - 1))
+
+    gs_asset_mesh_cook_primitive_t* table = (gs_asset_mesh_cook_primitive_t*)gs_malloc(sizeof(gs_asset_mesh_cook_primitive_t) * gs_max(prim_count, 1));
+    uint64_t offset = __GS_MESH_COOK_ALIGN(sizeof(hdr) + layout_ct * sizeof(gs_asset_mesh_layout_t) + prim_count * sizeof(gs_asset_mesh_cook_primitive_t));
+    uint32_t pi = 0;
+    for (uint32_t i = 0; i < mesh_count; ++i) {
+        for (uint32_t p = 0; p < meshes[i].prim_count; ++p, ++pi) {
+            gs_asset_mesh_cook_primitive_t* cp = &table[pi];
+            cp->vertex_size = meshes[i].vertex_sizes[p];
+            cp->index_size = meshes[i].index_sizes[p];
+            cp->vertex_count = (uint32_t)(cp->vertex_size / stride);
+            cp->index_count = (uint32_t)(cp->index_size / decl.index_buffer_element_size);
+            cp->lod_count = 1;
+            cp->lods[0].count = cp->index_count;
+            cp->dequant.scale = gs_v3(1.f, 1.f, 1.f);
+            if (meshes[i].dequant) cp->dequant = meshes[i].dequant[p];
+            if (meshes[i].lod_counts) {
+                cp->lod_count = meshes[i].lod_counts[p];
+                memcpy(cp->lods, &meshes[i].lods[p * GS_ASSET_MESH_MAX_LODS], sizeof(cp->lods));
+                cp->index_count = cp->lods[0].count;
+            }
+            cp->vertex_offset = offset;
+            offset = __GS_MESH_COOK_ALIGN(offset + cp->vertex_size);
+            cp->index_offset = offset;
+            offset = __GS_MESH_COOK_ALIGN(offset + cp->index_size);
+        }
+    }
+
+    gs_result res = GS_RESULT_FAILURE;
+    FILE* fp = fopen(out_path, "wb");
+    if (fp)
+    {
+        fwrite(&hdr, sizeof(hdr), 1, fp);
+        fwrite(layout, sizeof(gs_asset_mesh_layout_t), layout_ct, fp);
+        fwrite(table, sizeof(gs_asset_mesh_cook_primitive_t), prim_count, fp);
+
+        const uint8_t pad[GS_ASSET_MESH_COOK_ALIGNMENT] = gs_default_val();
+        uint64_t at = sizeof(hdr) + layout_ct * sizeof(gs_asset_mesh_layout_t) + prim_count * sizeof(gs_asset_mesh_cook_primitive_t);
+        pi = 0;
+        for (uint32_t i = 0; i < mesh_count; ++i) {
+            for (uint32_t p = 0; p < meshes[i].prim_count; ++p, ++pi) {
+                const gs_asset_mesh_cook_primitive_t* cp = &table[pi];
+                const uint8_t* verts = (const uint8_t*)meshes[i].vertices[p];
+                uint8_t* soa = NULL;
+
+                // Split interleaved vertices into one contiguous stream per attribute
+                if (desc->non_interleaved) {
+                    soa = (uint8_t*)gs_malloc(gs_max(cp->vertex_size, 1));
+                    size_t stream = 0;
+                    for (uint32_t l = 0; l < layout_ct; ++l) {
+                        size_t sz = gs_asset_mesh_attribute_size(layout[l].type, decl.quantize);
+                        for (uint32_t v = 0; v < cp->vertex_count; ++v) {
+                            memcpy(soa + stream + v * sz, verts + v * stride + attr_offsets[l], sz);
                         }
+                        stream += sz * cp->vertex_count;
                     }
+                    verts = soa;
                 }
-            }
 
-            // Add to out data
-            mesh->vertices[p] = gs_malloc(v_data.size);
-            mesh->indices[p] = gs_malloc(i_data.size);
-            mesh->vertex_sizes[p] = v_data.size;
-            mesh->index_sizes[p] = i_data.size;
+                fwrite(pad, 1, (size_t)(cp->vertex_offset - at), fp);
+                fwrite(verts, 1, (size_t)cp->vertex_size, fp);
+                fwrite(pad, 1, (size_t)(cp->index_offset - (cp->vertex_offset + cp->vertex_size)), fp);
+                fwrite(meshes[i].indices[p], 1, (size_t)cp->index_size, fp);
+                at = cp->index_offset + cp->index_size;
 
-            // Copy data
-            memcpy(mesh->vertices[p], v_data.data, v_data.size);
-            memcpy(mesh->indices[p], i_data.data, i_data.size);
+                if (soa) gs_free(soa);
+            }
         }
+
+        res = ferror(fp) ? GS_RESULT_FAILURE : GS_RESULT_SUCCESS;
+        fclose(fp);
+    }
+    else
+    {
+        gs_println("Warning:MeshCook:Could not open for writing: %s", out_path);
     }
 
-    // Free all data at the end
-    cgltf_free(data);
-    gs_dyn_array_free(positions);
-    gs_dyn_array_free(normals);
-    gs_dyn_array_free(tangents);
-    gs_dyn_array_free(colors);
-    gs_dyn_array_free(uvs);
-    gs_dyn_array_free(layouts);
-    gs_byte_buffer_free(&v_data);
-    gs_byte_buffer_free(&i_data);
+    #undef __GS_MESH_COOK_ALIGN
+
+    gs_free(table);
+    gs_asset_mesh_raw_data_free(meshes, mesh_count);
+    return res;
 }
 
 void gs_asset_mesh_load_from_file(const char* path, void* out, gs_asset_mesh_decl_t* decl, void* data_out, size_t data_size)
 {
-    // Cast mesh data to use
-    gs_asset_mesh_t* mesh = (gs_asset_mesh_t*)out;
+    gs_asset_mesh_load_opts_t opts = gs_default_val();
+    if (decl) opts.decl = *decl;
+
+    void* staging = NULL;
+    if (gs_asset_mesh_decode_from_file(path, out, &opts, &staging)) {
+        gs_asset_mesh_upload(out, &opts, staging);
+    }
+}
+
+// Everything the upload reads straight from the map is checked up front, so a truncated or corrupt file can't
+// drive reads past the end of it. The layout must be the one the caller draws with, when it gives one
+static bool32_t __gs_asset_mesh_cook_validate(const gs_platform_file_view_t* view, const gs_asset_mesh_decl_t* decl)
+{
+    const uint64_t size = view->size;
+    const gs_asset_mesh_cook_header_t* hdr = (const gs_asset_mesh_cook_header_t*)view->data;
+    if (size < sizeof(*hdr) || hdr->magic != GS_ASSET_MESH_COOK_MAGIC || hdr->version != GS_ASSET_MESH_COOK_VERSION) {
+        return false;
+    }
+    if ((hdr->index_element_size != 2 && hdr->index_element_size != 4) || !hdr->layout_count ||
+        (hdr->non_interleaved && hdr->layout_count > GS_ASSET_MESH_MAX_STREAMS)) {
+        return false;
+    }
+
+    // Counts are 32 bit, so these can't overflow 64 bit math
+    uint64_t table_end = sizeof(*hdr) + (uint64_t)hdr->layout_count * sizeof(gs_asset_mesh_layout_t) +
+        (uint64_t)hdr->prim_count * sizeof(gs_asset_mesh_cook_primitive_t);
+    if (table_end > size) return false;
+
+    const gs_asset_mesh_layout_t* layout = (const gs_asset_mesh_layout_t*)(hdr + 1);
+    uint64_t stride = 0;
+    for (uint32_t l = 0; l < hdr->layout_count; ++l) {
+        size_t sz = gs_asset_mesh_attribute_size(layout[l].type, hdr->quantized);
+        if (!sz) return false;
+        stride += sz;
+    }
+
+    if (decl && decl->layout)
+    {
+        const uint32_t ct = (uint32_t)(decl->layout_size / sizeof(gs_asset_mesh_layout_t));
+        if (ct != hdr->layout_count || !decl->quantize != !hdr->quantized) return false;
+        for (uint32_t l = 0; l < ct; ++l) {
+            if (decl->layout[l].type != layout[l].type || decl->layout[l].idx != layout[l].idx) return false;
+        }
+    }
+    if (decl && decl->index_buffer_element_size && decl->index_buffer_element_size != hdr->index_element_size) {
+        return false;
+    }
+
+    const gs_asset_mesh_cook_primitive_t* table = (const gs_asset_mesh_cook_primitive_t*)(layout + hdr->layout_count);
+    for (uint32_t p = 0; p < hdr->prim_count; ++p)
+    {
+        const gs_asset_mesh_cook_primitive_t* cp = &table[p];
+        if (cp->vertex_offset > size || cp->vertex_size > size - cp->vertex_offset ||
+            cp->index_offset > size || cp->index_size > size - cp->index_offset) {
+            return false;
+        }
+        if ((uint64_t)cp->vertex_count * stride > cp->vertex_size ||
+            (uint64_t)cp->index_count * hdr->index_element_size > cp->index_size) {
+            return false;
+        }
+        if (cp->lod_count < 1 || cp->lod_count > GS_ASSET_MESH_MAX_LODS) return false;
+        for (uint32_t l = 0; l < cp->lod_count; ++l) {
+            const gs_asset_mesh_lod_t* lod = &cp->lods[l];
+            if (lod->start % hdr->index_element_size ||
+                (uint64_t)lod->start + (uint64_t)lod->count * hdr->index_element_size > cp->index_size) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
 
+bool32_t gs_asset_mesh_decode_from_file(const char* path, void* out, const gs_asset_mesh_load_opts_t* opts, void** staging)
+{
+    (void)out;
     // Mesh data to fill out
     uint32_t mesh_count = 0;
     gs_asset_mesh_raw_data_t* meshes = NULL;
+    gs_asset_mesh_decl_t* decl = (opts && (opts->decl.layout || opts->decl.index_buffer_element_size)) ? 
+        (gs_asset_mesh_decl_t*)&opts->decl : NULL;
 
     // Get file extension from path
     gs_transient_buffer(file_ext, 32);
     gs_platform_file_extension(file_ext, 32, path);
 
+    // Cooked mesh, mapped as is
+    if (gs_string_compare_equal(file_ext, "gsm"))
+    {
+        gs_platform_file_view_t view = gs_default_val();
+        if (!gs_platform_file_view_open_mapped(path, &view)) {
+            gs_println("Warning:MeshLoadFromFile:Could not open: %s", path);
+            return false;
+        }
+
+        if (!__gs_asset_mesh_cook_validate(&view, decl)) {
+            gs_println("Warning:MeshLoadFromFile:Invalid cooked mesh: %s", path);
+            gs_platform_file_view_close(&view);
+            return false;
+        }
+
+        gs_asset_mesh_staging_t* st = gs_malloc_init(gs_asset_mesh_staging_t);
+        st->cooked = view;
+        *staging = st;
+        return true;
+    }
+
     // GLTF
     if (gs_string_compare_equal(file_ext, "gltf"))
     {
         gs_util_load_gltf_data_from_file(path, decl, &meshes, &mesh_count);
+        if (decl) {
+            gs_asset_mesh_optimize(meshes, mesh_count, decl, decl->optimize);
+            gs_asset_mesh_generate_lods(meshes, mesh_count, decl);
+            gs_asset_mesh_quantize(meshes, mesh_count, decl);
+        }
     }
     else 
     {
         gs_println("Warning:MeshLoadFromFile:File extension not supported: %s, file: %s", file_ext, path);
-        return;
+        return false;
     }
 
     // For now, handle meshes with only single mesh count
     if (mesh_count != 1) {
-        // Error
-        // Free all the memory
+        gs_asset_mesh_raw_data_free(meshes, mesh_count);
+        return false;
+    }
+
+    gs_asset_mesh_staging_t* st = gs_malloc_init(gs_asset_mesh_staging_t);
+    st->mesh_count = mesh_count;
+    st->meshes = meshes;
+    *staging = st;
+
+    return true;
+}
+
+void gs_asset_mesh_upload(void* out, const gs_asset_mesh_load_opts_t* opts, void* staging)
+{
+    // Cast mesh data to use
+    gs_asset_mesh_t* mesh = (gs_asset_mesh_t*)out;
+    gs_asset_mesh_staging_t* st = (gs_asset_mesh_staging_t*)staging;
+    uint32_t mesh_count = st->mesh_count;
+    gs_asset_mesh_raw_data_t* meshes = st->meshes;
+
+    // Cooked data goes straight from the map into buffers
+    if (st->cooked.data)
+    {
+        const uint8_t* base = (const uint8_t*)st->cooked.data;
+        const gs_asset_mesh_cook_header_t* hdr = (const gs_asset_mesh_cook_header_t*)base;
+        const gs_asset_mesh_layout_t* layout = (const gs_asset_mesh_layout_t*)(base + sizeof(*hdr));
+        const gs_asset_mesh_cook_primitive_t* table = (const gs_asset_mesh_cook_primitive_t*)(layout + hdr->layout_count);
+
+        for (uint32_t p = 0; p < hdr->prim_count; ++p)
+        {
+            const gs_asset_mesh_cook_primitive_t* cp = &table[p];
+            gs_asset_mesh_primitive_t prim = gs_default_val();
+            prim.count = cp->index_count;
+            prim.lod_count = cp->lod_count;
+            memcpy(prim.lods, cp->lods, sizeof(prim.lods));
+            prim.dequant = cp->dequant;
+            prim.vertex_count = cp->vertex_count;
+
+            if (hdr->non_interleaved) {
+                size_t stream = 0;
+                prim.stream_count = gs_min(hdr->layout_count, GS_ASSET_MESH_MAX_STREAMS);
+                for (uint32_t l = 0; l < prim.stream_count; ++l) {
+                    prim.stream_offsets[l] = stream;
+                    stream += gs_asset_mesh_attribute_size(layout[l].type, hdr->quantized) * cp->vertex_count;
+                }
+            }
+
+            gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
+            vdesc.data = (void*)(base + cp->vertex_offset);
+            vdesc.size = (size_t)cp->vertex_size;
+            prim.vbo = gs_graphics_vertex_buffer_create(&vdesc);
+
+            gs_graphics_index_buffer_desc_t idesc = gs_default_val();
+            idesc.data = (void*)(base + cp->index_offset);
+            idesc.size = (size_t)cp->index_size;
+            prim.ibo = gs_graphics_index_buffer_create(&idesc);
+
+            gs_dyn_array_push(mesh->primitives, prim);
+        }
+
+        gs_platform_file_view_close(&st->cooked);
+        gs_free(st);
         return;
     }
 
+    // Vertex stride is only known up front with a layout
+    size_t index_size = (opts && opts->decl.index_buffer_element_size == 4) ? 4 : 2;
+    size_t stride = 0;
+    if (opts && opts->decl.layout) {
+        for (uint32_t l = 0; l < opts->decl.layout_size / sizeof(gs_asset_mesh_layout_t); ++l) {
+            stride += gs_asset_mesh_attribute_size(opts->decl.layout[l].type, opts->decl.quantize);
+        }
+    }
+
     // Process all mesh data, add meshes
     for (uint32_t i = 0; i < mesh_count; ++i)
     {
@@ -5772,7 +9107,17 @@ void gs_asset_mesh_load_from_file(const char* path, void* out, gs_asset_mesh_dec
         {
             // Construct primitive
             gs_asset_mesh_primitive_t prim = gs_default_val();
-            prim.count = m->index_sizes[p] / sizeof(uint16_t);
+            prim.count = m->index_sizes[p] / index_size;
+            prim.vertex_count = stride ? (uint32_t)(m->vertex_sizes[p] / stride) : 0;
+            prim.lod_count = 1;
+            prim.lods[0].count = prim.count;
+            prim.dequant.scale = gs_v3(1.f, 1.f, 1.f);
+            if (m->dequant) prim.dequant = m->dequant[p];
+            if (m->lod_counts) {
+                prim.lod_count = m->lod_counts[p];
+                memcpy(prim.lods, &m->lods[p * GS_ASSET_MESH_MAX_LODS], sizeof(prim.lods));
+                prim.count = prim.lods[0].count;
+            }
 
             // Vertex buffer decl
             gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
@@ -5796,6 +9141,30 @@ void gs_asset_mesh_load_from_file(const char* path, void* out, gs_asset_mesh_dec
     }
 
     // Free all mesh data
+    gs_asset_mesh_raw_data_free(meshes, mesh_count);
+    gs_free(st);
+}
+
+void gs_asset_mesh_discard(void* out, const gs_asset_mesh_load_opts_t* opts, void* staging)
+{
+    (void)out; (void)opts;
+    gs_asset_mesh_staging_t* st = (gs_asset_mesh_staging_t*)staging;
+    if (st->cooked.data) {
+        gs_platform_file_view_close(&st->cooked);
+    } else {
+        gs_asset_mesh_raw_data_free(st->meshes, st->mesh_count);
+    }
+    gs_free(st);
+}
+
+void gs_asset_mesh_free(gs_asset_mesh_t* mesh)
+{
+    for (uint32_t i = 0; i < gs_dyn_array_size(mesh->primitives); ++i) {
+        gs_graphics_vertex_buffer_destroy(mesh->primitives[i].vbo);
+        gs_graphics_index_buffer_destroy(mesh->primitives[i].ibo);
+    }
+    gs_dyn_array_free(mesh->primitives);
+    mesh->primitives = NULL;
 }
 
 /*=============================
@@ -5810,6 +9179,50 @@ void gs_default_main_window_close_callback(void* window);
 // Global instance of gunslinger engine (...THERE CAN ONLY BE ONE)
 gs_global gs_engine_t* __g_engine_instance = gs_default_val();
 
+// Whole number of refreshes per frame closest to the requested frame rate
+static int32_t __gs_engine_swap_interval(float frame_rate)
+{
+    float hz = gs_platform_refresh_rate();
+    if (hz <= 0.f) return 1;
+    return gs_max((int32_t)(hz / frame_rate + 0.5f), 1);
+}
+
+// Period in ms frames are expected to take, returns 0 when the swap alone is meant to pace
+static f64 __gs_engine_frame_period(gs_platform_i* platform, f64* pace)
+{
+    const gs_platform_video_settings_t* video = &platform->settings.video;
+    f64 period = 1000.0 / platform->time.max_fps;
+    *pace = period;
+
+    if (video->vsync_enabled)
+    {
+        if (video->refresh_rate > 0.f) period = 1000.0 * (f64)video->vsync_enabled / (f64)video->refresh_rate;
+
+        // Swap blocks on vblank, so the pacer only backstops drivers that ignore the swap interval.
+        // Sleeping to the full period would race the vblank and add a frame of latency.
+        *pace = period * 0.9;
+    }
+
+    return period;
+}
+
+static void __gs_engine_record_frame(gs_platform_frame_stats_t* s, f64 ms, f64 period)
+{
+    s->count++;
+    if (s->count == 1 || ms < s->min) s->min = ms;
+    if (s->count == 1 || ms > s->max) s->max = ms;
+    if (ms > period * 1.5) s->late++;
+
+    // Welford's running variance
+    f64 d = ms - s->mean;
+    s->mean += d / (f64)s->count;
+    s->m2 += d * (ms - s->mean);
+    s->variance = s->m2 / (f64)s->count;
+
+    uint32_t b = (uint32_t)gs_min(ms / GS_PLATFORM_FRAME_HISTOGRAM_BUCKET_MS, (f64)(GS_PLATFORM_FRAME_HISTOGRAM_BUCKETS - 1));
+    s->histogram[b]++;
+}
+
 gs_engine_t* gs_engine_create(gs_app_desc_t app_desc)
 {
     if (gs_engine_instance() == NULL)
@@ -5819,6 +9232,8 @@ gs_engine_t* gs_engine_create(gs_app_desc_t app_desc)
         if (app_desc.window_height == 0)    app_desc.window_height = 600;
         if (app_desc.window_title == 0)     app_desc.window_title = "App";
         if (app_desc.frame_rate <= 0.f)     app_desc.frame_rate = 60.f;
+        if (app_desc.fixed_rate <= 0.f)     app_desc.fixed_rate = 60.f;
+        if (app_desc.max_fixed_steps == 0)  app_desc.max_fixed_steps = 8;
         if (app_desc.update == NULL)        app_desc.update = &gs_default_app_func;
         if (app_desc.shutdown == NULL)      app_desc.shutdown = &gs_default_app_func;
         if (app_desc.init == NULL)          app_desc.init = &gs_default_app_func;
@@ -5841,13 +9256,14 @@ gs_engine_t* gs_engine_create(gs_app_desc_t app_desc)
 
         // Set frame rate for application
         gs_engine_subsystem(platform)->time.max_fps = app_desc.frame_rate;
-
-        // Set vsync for video
-        gs_platform_enable_vsync(app_desc.enable_vsync);
+        gs_engine_subsystem(platform)->time.fixed_delta = 1.0 / (f64)app_desc.fixed_rate;
 
         // Construct main window
         gs_platform_create_window(app_desc.window_title, app_desc.window_width, app_desc.window_height);
 
+        // Set vsync for video (needs a current context), letting the swap chain do the limiting
+        gs_platform_enable_vsync(app_desc.enable_vsync ? __gs_engine_swap_interval(app_desc.frame_rate) : 0);
+
         // Construct graphics api 
         gs_engine_subsystem(graphics) = gs_graphics_create();
 
@@ -5905,6 +9321,31 @@ gs_result gs_engine_run()
             return (gs_engine_instance()->shutdown());
         }
 
+        // Pick up voice state reported by the mixer
+        gs_audio_update(gs_engine_subsystem(audio));
+
+        // Step simulation at fixed rate, consuming last frame's time
+        if (gs_engine_instance()->ctx.app.fixed_update)
+        {
+            gs_app_desc_t* app = &gs_engine_instance()->ctx.app;
+            const f64 step = platform->time.fixed_delta;
+
+            // Clamp backlog so a slow frame can't feed ever longer catch up loops
+            platform->time.accumulator = gs_min(platform->time.accumulator + platform->time.delta, step * (f64)app->max_fixed_steps);
+
+            while (platform->time.accumulator >= step)
+            {
+                app->fixed_update();
+                platform->time.accumulator -= step;
+                if (!app->is_running)
+                {
+                    return (gs_engine_instance()->shutdown());
+                }
+            }
+
+            platform->time.alpha = platform->time.accumulator / step;
+        }
+
         // Process application context
         gs_engine_instance()->ctx.app.update();
         if (!gs_engine_instance()->ctx.app.is_running) 
@@ -5930,20 +9371,29 @@ gs_result gs_engine_run()
         platform->time.render   = platform->time.current - platform->time.previous;
         platform->time.previous = platform->time.current;
         platform->time.frame    = platform->time.update + platform->time.render;            // Total frame time
-        platform->time.delta    = platform->time.frame / 1000.f;
 
-        float target = (1000.f / platform->time.max_fps);
+        f64 pace = 0.0;
+        f64 period = __gs_engine_frame_period(platform, &pace);
 
-        if (platform->time.frame < target)
+        // Deadlines advance by whole periods so wake up error doesn't accumulate, 
+        // but restart from now after an overrun rather than rushing frames to catch up
+        platform->time.deadline += pace;
+        if (platform->time.deadline <= platform->time.current)
         {
-            gs_platform_sleep((float)(target - platform->time.frame));
-            
+            platform->time.deadline = platform->time.current;
+        }
+        else
+        {
+            gs_platform_sleep_until(platform->time.deadline);
+
             platform->time.current = gs_platform_elapsed_time();
             double wait_time = platform->time.current - platform->time.previous;
             platform->time.previous = platform->time.current;
             platform->time.frame += wait_time;
-            platform->time.delta = platform->time.frame / 1000.f;
         }
+
+        platform->time.delta = platform->time.frame / 1000.f;
+        __gs_engine_record_frame(&platform->time.stats, platform->time.frame, period);
     }
 
     // Shouldn't hit here
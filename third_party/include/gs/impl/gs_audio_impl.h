@@ -24,6 +24,644 @@
 #include "../external/dr_libs/dr_wav.h"
 #include "../external/dr_libs/dr_mp3.h"
 
+#ifndef GS_AUDIO_STREAM_CHUNK_FRAMES
+    #define GS_AUDIO_STREAM_CHUNK_FRAMES    4096    // Frames decoded per pass of the stream thread
+#endif
+
+#ifndef GS_AUDIO_STREAM_MP3_SEEK_POINTS
+    #define GS_AUDIO_STREAM_MP3_SEEK_POINTS 256     // Without a seek table dr_mp3 decodes from the start of the file on every seek
+#endif
+
+#ifndef GS_AUDIO_STREAM_POLL_MS
+    #define GS_AUDIO_STREAM_POLL_MS         5.f
+#endif
+
+#ifndef GS_AUDIO_RESAMPLE_TAPS
+    #define GS_AUDIO_RESAMPLE_TAPS          32      // Source frames weighed per output frame by the sinc filter, must be even
+#endif
+
+#ifndef GS_AUDIO_RESAMPLE_PHASES
+    #define GS_AUDIO_RESAMPLE_PHASES        256     // Fractional positions the filter is tabulated at
+#endif
+
+#ifndef GS_AUDIO_RESAMPLE_CUTOFF
+    #define GS_AUDIO_RESAMPLE_CUTOFF        0.9f    // Passband edge relative to the nyquist of the lower of both rates
+#endif
+
+#ifndef GS_AUDIO_RESAMPLE_BANDS
+    #define GS_AUDIO_RESAMPLE_BANDS         8       // Cutoffs tabulated for downsampling, band b scales the source cutoff by (BANDS - b) / BANDS
+#endif
+
+/*
+    Sample rate conversion and channel mapping. Resident sources are converted to the device rate and folded down to 
+    at most stereo once when they're decoded and streams as they're decoded, so the mixer only resamples for pitch. 
+    Both go through a polyphase Blackman windowed sinc, which the mixer also uses for high quality pitched voices. 
+    Downsampling picks a filter whose cutoff is scaled down to the destination nyquist, so content above it is 
+    removed rather than folded back into the audible range.
+*/
+
+#define __GS_AUDIO_RESAMPLE_HALF    (GS_AUDIO_RESAMPLE_TAPS / 2)
+
+static float __gs_audio_resample_table[GS_AUDIO_RESAMPLE_BANDS][GS_AUDIO_RESAMPLE_PHASES][GS_AUDIO_RESAMPLE_TAPS];
+
+static void __gs_audio_resample_init()
+{
+    for (uint32_t b = 0; b < GS_AUDIO_RESAMPLE_BANDS; ++b)
+    {
+        const float cutoff = GS_AUDIO_RESAMPLE_CUTOFF * (float)(GS_AUDIO_RESAMPLE_BANDS - b) / (float)GS_AUDIO_RESAMPLE_BANDS;
+        for (uint32_t p = 0; p < GS_AUDIO_RESAMPLE_PHASES; ++p)
+        {
+            float* row = __gs_audio_resample_table[b][p];
+            float frac = (float)p / (float)GS_AUDIO_RESAMPLE_PHASES;
+            float sum = 0.f;
+            for (uint32_t k = 0; k < GS_AUDIO_RESAMPLE_TAPS; ++k)
+            {
+                // Tap k weighs the frame (half - 1) - k before the integer part of the position
+                float x = (float)k - (float)(__GS_AUDIO_RESAMPLE_HALF - 1) - frac;
+                float t = x * cutoff;
+                float w = x / (float)__GS_AUDIO_RESAMPLE_HALF;
+                float sinc = fabsf(t) < 1e-6f ? 1.f : sinf(GS_PI * t) / (GS_PI * t);
+                float window = fabsf(w) >= 1.f ? 0.f : 0.42f + 0.5f * cosf(GS_PI * w) + 0.08f * cosf(2.f * GS_PI * w);
+                row[k] = sinc * window;
+                sum += row[k];
+            }
+
+            // Unity gain at DC for every phase, otherwise the fractional position would modulate the level
+            for (uint32_t k = 0; k < GS_AUDIO_RESAMPLE_TAPS; ++k) {
+                row[k] /= sum;
+            }
+        }
+    }
+}
+
+// Filter band for a 32.32 source frames per output frame step, the widest one whose cutoff stays below the output nyquist
+static uint32_t __gs_audio_resample_band(uint64_t step)
+{
+    if (step <= ((uint64_t)1 << 32)) return 0;
+    const uint64_t pass = ((uint64_t)GS_AUDIO_RESAMPLE_BANDS << 32) / step;
+    return GS_AUDIO_RESAMPLE_BANDS - (uint32_t)gs_max(pass, 1);
+}
+
+// Stereo frame at 32.32 position p through the given filter band, frames outside [0, frames) read as silence
+static void __gs_audio_resample_frame(const s16* s, uint32_t channels, int64_t frames, uint64_t p, uint32_t band, float* out)
+{
+    const float* w = __gs_audio_resample_table[band][((uint64_t)(uint32_t)p * GS_AUDIO_RESAMPLE_PHASES) >> 32];
+    const int64_t first = (int64_t)(p >> 32) - (__GS_AUDIO_RESAMPLE_HALF - 1);
+    const uint32_t r = channels > 1 ? 1 : 0;
+    float left = 0.f, right = 0.f;
+
+    if (first >= 0 && first + GS_AUDIO_RESAMPLE_TAPS <= frames)
+    {
+        const s16* f = s + first * channels;
+        for (uint32_t k = 0; k < GS_AUDIO_RESAMPLE_TAPS; ++k, f += channels) {
+            left += f[0] * w[k];
+            right += f[r] * w[k];
+        }
+    }
+    else
+    {
+        for (uint32_t k = 0; k < GS_AUDIO_RESAMPLE_TAPS; ++k)
+        {
+            int64_t i = first + k;
+            if (i < 0 || i >= frames) continue;
+            left += s[i * channels] * w[k];
+            right += s[i * channels + r] * w[k];
+        }
+    }
+
+    out[0] = left * (1.f / 32768.f);
+    out[1] = right * (1.f / 32768.f);
+}
+
+static s16 __gs_audio_to_s16(float x)
+{
+    return (s16)gs_clamp(lrintf(x * 32768.f), -32768, 32767);
+}
+
+// Wave channel order: FL FR [FC] [LFE] then left/right surround pairs. Center and surrounds go in at -3dB, LFE is dropped
+static void __gs_audio_downmix(const s16* in, uint32_t channels, uint32_t frames, s16* out)
+{
+    const float k = 0.7071f / 32768.f;
+    const bool32_t center = channels == 3 || channels >= 5;
+    const uint32_t surround = channels >= 6 ? 4 : center ? 3 : 2;
+    for (uint32_t i = 0; i < frames; ++i, in += channels, out += 2)
+    {
+        float left = in[0] / 32768.f, right = in[1] / 32768.f;
+        if (center) {
+            left += in[2] * k;
+            right += in[2] * k;
+        }
+        for (uint32_t c = surround; c + 1 < channels; c += 2) {
+            left += in[c] * k;
+            right += in[c + 1] * k;
+        }
+        out[0] = __gs_audio_to_s16(left);
+        out[1] = __gs_audio_to_s16(right);
+    }
+}
+
+// Rate sources are converted to, 0 (leave them alone) until the device is open
+static int32_t __gs_audio_device_rate()
+{
+    gs_audio_i* audio = gs_engine_instance() ? gs_engine_subsystem(audio) : NULL;
+    return audio ? (int32_t)audio->samples_per_second : 0;
+}
+
+// Replaces decoded samples with a copy at rate and at most two channels, returns whether anything had to change
+static bool32_t __gs_audio_convert_source(gs_audio_source_t* src, int32_t rate)
+{
+    if (!rate || !src->samples || src->format != GS_AUDIO_SAMPLE_FORMAT_S16 || src->channels <= 0 || src->sample_rate <= 0) return false;
+    if (src->sample_rate == rate && src->channels <= 2) return false;
+
+    const uint32_t channels = gs_min((uint32_t)src->channels, 2);
+    const int64_t frames = src->sample_count / src->channels;
+    s16* samples = (s16*)src->samples;
+
+    if ((uint32_t)src->channels > channels)
+    {
+        s16* folded = (s16*)gs_malloc(frames * channels * sizeof(s16));
+        __gs_audio_downmix(samples, (uint32_t)src->channels, (uint32_t)frames, folded);
+        gs_free(samples);
+        samples = folded;
+    }
+
+    int64_t out_frames = frames;
+    if (src->sample_rate != rate)
+    {
+        const uint64_t step = ((uint64_t)src->sample_rate << 32) / (uint64_t)rate;
+        const uint32_t band = __gs_audio_resample_band(step);
+        out_frames = frames * rate / src->sample_rate;
+        s16* out = (s16*)gs_malloc(gs_max(out_frames, 1) * channels * sizeof(s16));
+        uint64_t p = 0;
+        for (int64_t i = 0; i < out_frames; ++i, p += step)
+        {
+            float lr[2];
+            __gs_audio_resample_frame(samples, channels, frames, p, band, lr);
+            for (uint32_t c = 0; c < channels; ++c) {
+                out[i * channels + c] = __gs_audio_to_s16(lr[c]);
+            }
+        }
+        gs_free(samples);
+        samples = out;
+    }
+
+    src->samples = samples;
+    src->channels = (int32_t)channels;
+    src->sample_rate = rate;
+    src->sample_count = (int32_t)(out_frames * channels);
+    return true;
+}
+
+/*
+    IMA ADPCM. Every block stores, per channel, its first sample and step index in a 4 byte header followed by the 
+    remaining GS_AUDIO_ADPCM_BLOCK_FRAMES - 1 samples as packed nibbles, so any block decodes on its own.
+*/
+
+#define __GS_AUDIO_ADPCM_CHANNEL_BYTES  (4 + GS_AUDIO_ADPCM_BLOCK_FRAMES / 2)
+
+static const int16_t __gs_audio_adpcm_steps[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 
+    118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 
+    6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t __gs_audio_adpcm_index[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+static s16 __gs_audio_adpcm_step(int32_t* pred, int32_t* index, uint8_t nibble)
+{
+    const int32_t step = __gs_audio_adpcm_steps[*index];
+    int32_t diff = step >> 3;
+    if (nibble & 4) diff += step;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 1) diff += step >> 2;
+    *pred = gs_clamp(nibble & 8 ? *pred - diff : *pred + diff, -32768, 32767);
+    *index = gs_clamp(*index + __gs_audio_adpcm_index[nibble & 7], 0, 88);
+    return (s16)*pred;
+}
+
+// Quantizes against the decoder's own state so encoder and decoder never drift apart
+static uint8_t __gs_audio_adpcm_encode_sample(int32_t* pred, int32_t* index, int32_t sample)
+{
+    const int32_t step = __gs_audio_adpcm_steps[*index];
+    int32_t diff = sample - *pred;
+    uint8_t nibble = 0;
+    if (diff < 0) {nibble = 8; diff = -diff;}
+    if (diff >= step) {nibble |= 4; diff -= step;}
+    if (diff >= step >> 1) {nibble |= 2; diff -= step >> 1;}
+    if (diff >= step >> 2) {nibble |= 1;}
+    __gs_audio_adpcm_step(pred, index, nibble);
+    return nibble;
+}
+
+// Decodes one block (mono or stereo) to interleaved s16
+static void __gs_audio_adpcm_decode_block(const uint8_t* block, uint32_t channels, s16* out)
+{
+    int32_t pred[2], index[2];
+    const uint8_t* nibbles[2];
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        const uint8_t* header = block + c * __GS_AUDIO_ADPCM_CHANNEL_BYTES;
+        pred[c] = (s16)(header[0] | (header[1] << 8));
+        index[c] = gs_min(header[2], 88);
+        nibbles[c] = header + 4;
+        out[c] = (s16)pred[c];
+    }
+
+    // Every sample depends on the last through a table lookup, so both sides are stepped together to overlap the chains
+    for (uint32_t i = 1; i < GS_AUDIO_ADPCM_BLOCK_FRAMES; ++i)
+    {
+        const uint32_t shift = ((i - 1) & 1) * 4;
+        for (uint32_t c = 0; c < channels; ++c) {
+            out[i * channels + c] = __gs_audio_adpcm_step(&pred[c], &index[c], (nibbles[c][(i - 1) >> 1] >> shift) & 15);
+        }
+    }
+}
+
+bool32_t gs_audio_source_compress(gs_audio_source_t* src)
+{
+    if (!src->samples || src->stream || src->format != GS_AUDIO_SAMPLE_FORMAT_S16 || src->channels <= 0) return false;
+
+    // Converted first, the mixer can only interpolate out of stereo at most
+    __gs_audio_convert_source(src, __gs_audio_device_rate());
+    __gs_audio_convert_source(src, src->sample_rate);
+
+    const uint32_t channels = (uint32_t)src->channels;
+    const uint32_t frames = (uint32_t)(src->sample_count / src->channels);
+    const uint32_t blocks = (frames + GS_AUDIO_ADPCM_BLOCK_FRAMES - 1) / GS_AUDIO_ADPCM_BLOCK_FRAMES;
+    const s16* in = (const s16*)src->samples;
+    uint8_t* data = (uint8_t*)gs_malloc(gs_max(blocks, 1) * channels * __GS_AUDIO_ADPCM_CHANNEL_BYTES);
+    memset(data, 0, gs_max(blocks, 1) * channels * __GS_AUDIO_ADPCM_CHANNEL_BYTES);
+
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        int32_t pred = 0, index = 0;
+        for (uint32_t b = 0; b < blocks; ++b)
+        {
+            // The step index carries over between blocks, the predictor restarts exactly on the first sample
+            const uint32_t first = b * GS_AUDIO_ADPCM_BLOCK_FRAMES;
+            uint8_t* block = data + (b * channels + c) * __GS_AUDIO_ADPCM_CHANNEL_BYTES;
+            pred = in[first * channels + c];
+            block[0] = (uint8_t)(pred & 0xff);
+            block[1] = (uint8_t)((pred >> 8) & 0xff);
+            block[2] = (uint8_t)index;
+
+            for (uint32_t i = 1; i < GS_AUDIO_ADPCM_BLOCK_FRAMES; ++i)
+            {
+                // The tail of the last block holds the final sample so it decodes without a click
+                const uint32_t frame = gs_min(first + i, frames - 1);
+                uint8_t nibble = __gs_audio_adpcm_encode_sample(&pred, &index, in[frame * channels + c]);
+                block[4 + ((i - 1) >> 1)] |= (uint8_t)(nibble << (((i - 1) & 1) * 4));
+            }
+        }
+    }
+
+    gs_free(src->samples);
+    src->samples = data;
+    src->format = GS_AUDIO_SAMPLE_FORMAT_ADPCM;
+    return true;
+}
+
+/*
+    Streamed sources keep the compressed file mapped and decode into a ring of GS_AUDIO_STREAM_BUFFER_FRAMES frames on 
+    the stream thread, which the mixer drains. Seeks are requested by the mixer through seek_serial, the stream thread 
+    answers with ready_serial once decoding restarted at flush_write, and everything before that is skipped.
+*/
+struct gs_audio_stream_t
+{
+    gs_platform_file_view_t view;
+    gs_audio_file_type type;
+    union {
+        drmp3 mp3;
+        drwav wav;
+        stb_vorbis* ogg;
+    } decoder;
+    drmp3_seek_point mp3_seek_points[GS_AUDIO_STREAM_MP3_SEEK_POINTS];
+    size_t mp3_cursor;
+    int32_t src_channels;           // Decoder channels
+    int32_t channels;               // Ring channels, the decoder's folded down to stereo
+    uint64_t frame_count;           // In ring frames, at the device rate
+    s16* buffer;
+    s16* scratch;                   // Raw decoder output of surround wavs, before folding
+
+    /* Resampling to the device rate, unused when step is 0 */
+    uint64_t step;                  // Decoded frames per ring frame, 32.32 fixed point
+    s16* decoded;                   // Decoded frames still within reach of the filter
+    uint32_t decoded_frames;
+    uint64_t decoded_pos;           // 32.32 position of the next ring frame in decoded
+    bool32_t decoded_end;
+
+    /* Written by the stream thread */
+    uint32_t write;
+    uint32_t ready_serial;
+    uint32_t flush_write;
+    uint32_t end_serial;            // Serial whose decode reached the end of the file at end_write
+    uint32_t end_write;
+
+    /* Written by the mixer */
+    uint32_t read;
+    uint32_t seek_serial;
+    uint32_t seek_frame;
+    uint32_t loop;
+    uint32_t read_serial;           // Seek the read cursor belongs to
+    bool32_t dirty;                 // Consumed or seeked since load, the next play has to seek
+
+    /* Stream thread only */
+    uint32_t decode_serial;
+    bool32_t decode_end;
+};
+
+// dr_mp3's memory backend doesn't track byte offsets for seek tables, so mp3 streams read the view through callbacks
+static size_t __gs_audio_stream_mp3_read(void* user_data, void* out, size_t bytes)
+{
+    gs_audio_stream_t* st = (gs_audio_stream_t*)user_data;
+    bytes = gs_min(bytes, st->view.size - st->mp3_cursor);
+    memcpy(out, (const uint8_t*)st->view.data + st->mp3_cursor, bytes);
+    st->mp3_cursor += bytes;
+    return bytes;
+}
+
+static drmp3_bool32 __gs_audio_stream_mp3_seek(void* user_data, int offset, drmp3_seek_origin origin)
+{
+    gs_audio_stream_t* st = (gs_audio_stream_t*)user_data;
+    int64_t pos = (origin == drmp3_seek_origin_current ? (int64_t)st->mp3_cursor : 0) + offset;
+    st->mp3_cursor = (size_t)gs_clamp(pos, 0, (int64_t)st->view.size);
+    return DRMP3_TRUE;
+}
+
+static bool32_t __gs_audio_stream_seek_decoder(gs_audio_stream_t* st, uint64_t frame)
+{
+    switch (st->type)
+    {
+        case GS_MP3: return drmp3_seek_to_pcm_frame(&st->decoder.mp3, frame);
+        case GS_WAV: return drwav_seek_to_pcm_frame(&st->decoder.wav, frame);
+        case GS_OGG: return stb_vorbis_seek(st->decoder.ogg, (unsigned int)frame);
+    }
+    return false;
+}
+
+// Decodes frames at the ring's channel count, stb_vorbis folds channels itself and dr_mp3 never exceeds two
+static uint32_t __gs_audio_stream_decode(gs_audio_stream_t* st, s16* out, uint32_t frames)
+{
+    switch (st->type)
+    {
+        case GS_MP3: return (uint32_t)drmp3_read_pcm_frames_s16(&st->decoder.mp3, frames, out);
+        case GS_OGG: return (uint32_t)stb_vorbis_get_samples_short_interleaved(st->decoder.ogg, st->channels, out, frames * st->channels);
+        case GS_WAV:
+        {
+            if (!st->scratch) {
+                return (uint32_t)drwav_read_pcm_frames_s16(&st->decoder.wav, frames, out);
+            }
+
+            uint32_t done = 0;
+            while (done < frames)
+            {
+                uint32_t count = gs_min(frames - done, GS_AUDIO_STREAM_CHUNK_FRAMES);
+                uint32_t got = (uint32_t)drwav_read_pcm_frames_s16(&st->decoder.wav, count, st->scratch);
+                __gs_audio_downmix(st->scratch, (uint32_t)st->src_channels, got, out + done * st->channels);
+                done += got;
+                if (got < count) break;
+            }
+            return done;
+        }
+    }
+    return 0;
+}
+
+// Decodes up to frames, wrapping to the start of the file while looping. Fewer frames means the file ended
+static uint32_t __gs_audio_stream_read(gs_audio_stream_t* st, s16* out, uint32_t frames)
+{
+    uint32_t done = 0;
+    bool32_t wrapped = false;
+    while (done < frames)
+    {
+        uint32_t got = __gs_audio_stream_decode(st, out + done * st->channels, frames - done);
+        done += got;
+        if (done == frames) break;
+
+        // A file that decodes nothing right after wrapping would spin forever
+        if ((wrapped && !got) || !gs_atomic_load_u32(&st->loop) || !__gs_audio_stream_seek_decoder(st, 0)) break;
+        wrapped = true;
+    }
+    return done;
+}
+
+static void __gs_audio_stream_reset_resampler(gs_audio_stream_t* st)
+{
+    if (!st->step) return;
+
+    // Silence in front of the first frame so the filter starts out centered on it
+    st->decoded_frames = __GS_AUDIO_RESAMPLE_HALF - 1;
+    st->decoded_pos = (uint64_t)st->decoded_frames << 32;
+    st->decoded_end = false;
+    memset(st->decoded, 0, st->decoded_frames * st->channels * sizeof(s16));
+}
+
+// Fills out with frames at the device rate, fewer once the file ended
+static uint32_t __gs_audio_stream_resample(gs_audio_stream_t* st, s16* out, uint32_t frames)
+{
+    const uint32_t channels = (uint32_t)st->channels;
+    const uint32_t band = __gs_audio_resample_band(st->step);
+    uint32_t done = 0;
+    while (done < frames)
+    {
+        // The next frame needs decoded frames up to half a filter past its position
+        if ((st->decoded_pos >> 32) + __GS_AUDIO_RESAMPLE_HALF >= st->decoded_frames)
+        {
+            if (st->decoded_end) break;
+
+            // Drop what no tap can reach anymore and decode the next chunk behind the rest
+            uint32_t drop = gs_min((uint32_t)(st->decoded_pos >> 32) - (__GS_AUDIO_RESAMPLE_HALF - 1), st->decoded_frames);
+            memmove(st->decoded, st->decoded + drop * channels, (st->decoded_frames - drop) * channels * sizeof(s16));
+            st->decoded_frames -= drop;
+            st->decoded_pos -= (uint64_t)drop << 32;
+
+            uint32_t got = __gs_audio_stream_read(st, st->decoded + st->decoded_frames * channels, GS_AUDIO_STREAM_CHUNK_FRAMES);
+            st->decoded_frames += got;
+            if (got < GS_AUDIO_STREAM_CHUNK_FRAMES)
+            {
+                // Trailing silence lets the filter ring out the last frames
+                memset(st->decoded + st->decoded_frames * channels, 0, __GS_AUDIO_RESAMPLE_HALF * channels * sizeof(s16));
+                st->decoded_frames += __GS_AUDIO_RESAMPLE_HALF;
+                st->decoded_end = true;
+            }
+            continue;
+        }
+
+        for (; done < frames && (st->decoded_pos >> 32) + __GS_AUDIO_RESAMPLE_HALF < st->decoded_frames; ++done)
+        {
+            float lr[2];
+            __gs_audio_resample_frame(st->decoded, channels, st->decoded_frames, st->decoded_pos, band, lr);
+            for (uint32_t c = 0; c < channels; ++c) {
+                out[done * channels + c] = __gs_audio_to_s16(lr[c]);
+            }
+            st->decoded_pos += st->step;
+        }
+    }
+    return done;
+}
+
+static void __gs_audio_stream_free(gs_audio_stream_t* st)
+{
+    switch (st->type)
+    {
+        case GS_MP3: drmp3_uninit(&st->decoder.mp3); break;
+        case GS_WAV: drwav_uninit(&st->decoder.wav); break;
+        case GS_OGG: stb_vorbis_close(st->decoder.ogg); break;
+    }
+    gs_platform_file_view_close(&st->view);
+    gs_free(st->buffer);
+    gs_free(st->scratch);
+    gs_free(st->decoded);
+    gs_free(st);
+}
+
+// Services a pending seek and tops the ring up, returns whether anything was decoded
+static bool32_t __gs_audio_stream_fill(gs_audio_stream_t* st)
+{
+    const uint32_t capacity = GS_AUDIO_STREAM_BUFFER_FRAMES;
+    uint32_t serial = gs_atomic_load_u32(&st->seek_serial);
+    if (serial != st->decode_serial)
+    {
+        uint64_t frame = gs_min((uint64_t)st->seek_frame, st->frame_count);
+        __gs_audio_stream_seek_decoder(st, st->step ? (frame * st->step) >> 32 : frame);
+        __gs_audio_stream_reset_resampler(st);
+        st->decode_serial = serial;
+        st->decode_end = false;
+        st->flush_write = st->write;
+        gs_atomic_store_u32(&st->ready_serial, serial);
+    }
+
+    bool32_t decoded = false;
+    while (!st->decode_end)
+    {
+        // The mixer skips straight to flush_write once it picks a seek up and never reads what came before it
+        uint32_t read = gs_atomic_load_u32(&st->read);
+        if ((int32_t)(st->flush_write - read) > 0) {
+            read = st->flush_write;
+        }
+        uint32_t used = st->write - read;
+        uint32_t space = used < capacity ? capacity - used : 0;
+        if (space < GS_AUDIO_STREAM_CHUNK_FRAMES) break;
+
+        uint32_t offset = st->write & (capacity - 1);
+        uint32_t count = gs_min(GS_AUDIO_STREAM_CHUNK_FRAMES, capacity - offset);
+        s16* out = st->buffer + offset * st->channels;
+        uint32_t got = st->step ? __gs_audio_stream_resample(st, out, count) : __gs_audio_stream_read(st, out, count);
+        gs_atomic_store_u32(&st->write, st->write + got);
+        decoded = true;
+
+        if (got < count)
+        {
+            st->decode_end = true;
+            st->end_write = st->write;
+            gs_atomic_store_u32(&st->end_serial, serial);
+        }
+    }
+    return decoded;
+}
+
+static void __gs_audio_stream_thread(void* user_data)
+{
+    gs_audio_i* audio = (gs_audio_i*)user_data;
+    while (gs_atomic_load_u32(&audio->stream_running))
+    {
+        uint32_t count = gs_atomic_load_u32(&audio->stream_count);
+        for (uint32_t i = 0; i < count; ++i) {
+            __gs_audio_stream_fill(audio->streams[i]);
+        }
+        gs_platform_sleep(GS_AUDIO_STREAM_POLL_MS);
+    }
+}
+
+// Game thread side of the command queue, drops (and reports) commands once the mixer falls too far behind. Callers
+// that mirror the command's effect on the game thread undo it when this fails
+static bool32_t __gs_audio_push_command(gs_audio_i* audio, const gs_audio_command_t* cmd)
+{
+    gs_audio_command_queue_t* q = &audio->commands;
+    uint32_t write = q->write;
+    if (write - gs_atomic_load_u32(&q->read) >= GS_AUDIO_COMMAND_QUEUE_SIZE) {
+        gs_println("Warning:Audio:Command queue full, dropping command");
+        return false;
+    }
+    q->data[write & (GS_AUDIO_COMMAND_QUEUE_SIZE - 1)] = *cmd;
+    gs_atomic_store_u32(&q->write, write + 1);
+    return true;
+}
+
+/*
+    Reverb is a small Freeverb style network, four damped feedback combs in parallel into two allpasses per side with 
+    the right side's delays stretched a little to decorrelate it. Lengths are tuned at 44.1kHz and scaled to the device.
+*/
+static const uint32_t __gs_audio_reverb_lengths[6] = {1116, 1188, 1277, 1356, 556, 441};
+
+#define __GS_AUDIO_REVERB_SPREAD    23
+
+typedef struct __gs_audio_delay_t
+{
+    float* data;
+    uint32_t length;
+    uint32_t pos;
+    float store;                    // Comb damping filter state
+} __gs_audio_delay_t;
+
+typedef struct __gs_audio_reverb_t
+{
+    __gs_audio_delay_t comb[2][4];
+    __gs_audio_delay_t allpass[2][2];
+    uint32_t size;                  // Floats of delay line following the header
+} __gs_audio_reverb_t;
+
+// Header and every delay line in one allocation, made on the game thread and cleared by the mixer when it takes it
+static __gs_audio_reverb_t* __gs_audio_reverb_create(uint32_t rate)
+{
+    const float scale = (float)(rate ? rate : 44100) / 44100.f;
+    uint32_t lengths[2][6], total = 0;
+    for (uint32_t c = 0; c < 2; ++c) {
+        for (uint32_t i = 0; i < 6; ++i) {
+            lengths[c][i] = gs_max((uint32_t)((__gs_audio_reverb_lengths[i] + c * __GS_AUDIO_REVERB_SPREAD) * scale), 1);
+            total += lengths[c][i];
+        }
+    }
+
+    __gs_audio_reverb_t* rv = (__gs_audio_reverb_t*)gs_malloc(sizeof(__gs_audio_reverb_t) + total * sizeof(float));
+    memset(rv, 0, sizeof(__gs_audio_reverb_t) + total * sizeof(float));
+    float* data = (float*)(rv + 1);
+    for (uint32_t c = 0; c < 2; ++c) {
+        for (uint32_t i = 0; i < 6; ++i) {
+            __gs_audio_delay_t* dl = i < 4 ? &rv->comb[c][i] : &rv->allpass[c][i - 4];
+            dl->data = data;
+            dl->length = lengths[c][i];
+            data += dl->length;
+        }
+    }
+    rv->size = total;
+    return rv;
+}
+
+static uint32_t __gs_audio_bus_add(gs_audio_i* audio, const char* name, uint32_t parent)
+{
+    if (audio->bus_count >= GS_AUDIO_MAX_BUSES || (audio->bus_count && parent >= audio->bus_count)) {
+        gs_println("Warning:Audio:Could not create bus: %s", name);
+        return GS_AUDIO_BUS_INVALID;
+    }
+
+    uint32_t id = audio->bus_count++;
+    gs_audio_bus_t* bus = &audio->buses[id];
+    memset(bus, 0, sizeof(gs_audio_bus_t));
+    gs_snprintf(bus->name, sizeof(bus->name), "%s", name);
+    bus->parent = id ? parent : 0;
+    bus->volume = 1.f;
+
+    gs_audio_command_t cmd = gs_default_val();
+    cmd.type = GS_AUDIO_COMMAND_ADD_BUS;
+    cmd.bus.id = id;
+    cmd.bus.parent = bus->parent;
+    cmd.bus.volume = bus->volume;
+    __gs_audio_push_command(audio, &cmd);
+    return id;
+}
+
 /* Audio Create, Destroy, Init, Shutdown, Submit */
 gs_audio_i* gs_audio_create()
 {
@@ -39,15 +677,80 @@ gs_audio_i* gs_audio_create()
     audio->min_audio_volume = 0.f;
     /* Set user data to null */
     audio->user_data = NULL;
+    /* Filter used for all sample rate conversion */
+    __gs_audio_resample_init();
+    /* Listener at the origin until the game places it */
+    audio->listener.transform = gs_vqs_default();
+    /* Default buses, everything mixes into the master unless routed elsewhere */
+    __gs_audio_bus_add(audio, "master", 0);
+    __gs_audio_bus_add(audio, "music", GS_AUDIO_BUS_MASTER);
+    __gs_audio_bus_add(audio, "sfx", GS_AUDIO_BUS_MASTER);
+    __gs_audio_bus_add(audio, "ui", GS_AUDIO_BUS_MASTER);
 
     return audio;
 }
 
+static bool32_t __gs_audio_push_instance_command(gs_audio_i* audio, gs_audio_command_type type, uint32_t id)
+{
+    gs_audio_instance_t* ip = gs_slot_array_getp(audio->instances, id);
+    gs_audio_command_t cmd = gs_default_val();
+    cmd.type = type;
+    cmd.inst = id;
+    cmd.play_id = ip->play_id;
+    cmd.decl = ip->decl;
+    if (gs_slot_array_handle_valid(audio->sources, ip->decl.src.id)) {
+        cmd.src = gs_slot_array_get(audio->sources, ip->decl.src.id);
+    }
+    return __gs_audio_push_command(audio, &cmd);
+}
+
+void gs_audio_update(gs_audio_i* audio)
+{
+    gs_audio_event_queue_t* q = &audio->events;
+    uint32_t write = gs_atomic_load_u32(&q->write);
+    uint32_t read = q->read;
+    for (; read != write; ++read)
+    {
+        gs_audio_event_t* evt = &q->data[read & (GS_AUDIO_EVENT_QUEUE_SIZE - 1)];
+        if (!gs_slot_array_handle_valid(audio->instances, evt->inst)) continue;
+
+        // Anything reported for an earlier play of this instance is stale
+        gs_audio_instance_t* ip = gs_slot_array_getp(audio->instances, evt->inst);
+        if (ip->play_id != evt->play_id) continue;
+
+        ip->decl.sample_position = evt->sample_position;
+        if (evt->type == GS_AUDIO_EVENT_FINISHED)
+        {
+            // One-shots are recycled here, the mixer already released their voice. 
+            // Anything else may still be referenced by a user handle, and slot ids are reused.
+            if (ip->one_shot) {
+                gs_slot_array_erase(audio->instances, evt->inst);
+            } else {
+                ip->decl.playing = false;
+            }
+        }
+    }
+    gs_atomic_store_u32(&q->read, read);
+}
+
 void gs_audio_destroy(gs_audio_i* audio)
 {
     // Release all relevant memory
     if (audio)
     {
+        if (audio->stream_count)
+        {
+            gs_atomic_store_u32(&audio->stream_running, 0);
+            gs_platform_thread_join(audio->stream_thread);
+            for (uint32_t i = 0; i < audio->stream_count; ++i) {
+                __gs_audio_stream_free(audio->streams[i]);
+            }
+        }
+        for (uint32_t i = 0; i < audio->bus_count; ++i) {
+            for (uint32_t j = 0; j < GS_AUDIO_MAX_BUS_EFFECTS; ++j) {
+                gs_free(audio->buses[i].effect_memory[j]);
+            }
+        }
         gs_slot_array_free(audio->sources);
         gs_slot_array_free(audio->instances);
         gs_free(audio);
@@ -65,8 +768,14 @@ bool32_t gs_audio_load_ogg_data_from_file
     void** samples
 )
 {
-    *sample_count = stb_vorbis_decode_filename(file_path, channels, 
-        sample_rate, (s16**)samples);
+    gs_platform_file_view_t view = gs_default_val();
+    *samples = NULL;
+    *sample_count = -1;
+    if (gs_platform_file_view_open(file_path, &view)) {
+        *sample_count = stb_vorbis_decode_memory((const uint8_t*)view.data, (int)view.size, channels, 
+            sample_rate, (s16**)samples);
+        gs_platform_file_view_close(&view);
+    }
 
     if (!*samples || *sample_count == -1)
     {
@@ -90,9 +799,14 @@ bool32_t gs_audio_load_wav_data_from_file
 )
 {
     uint64_t total_pcm_frame_count = 0;
-    *samples = drwav_open_file_and_read_pcm_frames_s16(
-        file_path, (uint32_t*)channels, (uint32_t*)sample_rate, 
-        &total_pcm_frame_count, NULL);
+    gs_platform_file_view_t view = gs_default_val();
+    *samples = NULL;
+    if (gs_platform_file_view_open(file_path, &view)) {
+        *samples = drwav_open_memory_and_read_pcm_frames_s16(
+            view.data, view.size, (uint32_t*)channels, (uint32_t*)sample_rate, 
+            &total_pcm_frame_count, NULL);
+        gs_platform_file_view_close(&view);
+    }
 
     if (!*samples) {
         *samples = NULL; 
@@ -117,8 +831,13 @@ bool32_t gs_audio_load_mp3_data_from_file
     // Decode entire mp3 
     uint64_t total_pcm_frame_count = 0;
     drmp3_config cfg = gs_default_val();
-    *samples = drmp3_open_file_and_read_pcm_frames_s16(
-        file_path, &cfg, &total_pcm_frame_count, NULL);
+    gs_platform_file_view_t view = gs_default_val();
+    *samples = NULL;
+    if (gs_platform_file_view_open(file_path, &view)) {
+        *samples = drmp3_open_memory_and_read_pcm_frames_s16(
+            view.data, view.size, &cfg, &total_pcm_frame_count, NULL);
+        gs_platform_file_view_close(&view);
+    }
 
     if (!*samples) {
         *samples = NULL; 
@@ -136,14 +855,40 @@ bool32_t gs_audio_load_mp3_data_from_file
 /* Audio create source */
 gs_handle(gs_audio_source_t) gs_audio_load_from_file(const char* file_path)
 {
-    gs_audio_i* audio = gs_engine_subsystem(audio);
     gs_audio_source_t src = gs_default_val();
     gs_handle(gs_audio_source_t) handle = gs_handle_invalid(gs_audio_source_t);
-    bool32_t load_successful = false;
 
-    if(!gs_platform_file_exists(file_path)) 
+    if (gs_audio_load_source_data_from_file(file_path, &src))
     {
-        gs_println("WARNING: Could not open file: %s", file_path);
+        handle = gs_audio_source_create(&src);
+    }
+
+    return handle;
+}
+
+/* Audio create compressed source */
+gs_handle(gs_audio_source_t) gs_audio_load_compressed_from_file(const char* file_path)
+{
+    gs_audio_source_t src = gs_default_val();
+    gs_handle(gs_audio_source_t) handle = gs_handle_invalid(gs_audio_source_t);
+
+    if (gs_audio_load_source_data_from_file(file_path, &src))
+    {
+        gs_audio_source_compress(&src);
+        handle = gs_audio_source_create(&src);
+    }
+
+    return handle;
+}
+
+/* Audio create streamed source */
+gs_handle(gs_audio_source_t) gs_audio_load_stream_from_file(const char* file_path)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    gs_handle(gs_audio_source_t) handle = gs_handle_invalid(gs_audio_source_t);
+
+    if (audio->stream_count >= GS_AUDIO_MAX_STREAMS) {
+        gs_println("Warning:Audio:Stream limit reached, could not stream: %s", file_path);
         return handle;
     }
 
@@ -151,14 +896,133 @@ gs_handle(gs_audio_source_t) gs_audio_load_from_file(const char* file_path)
     gs_util_str_to_lower(file_path, ext, sizeof(ext));
     gs_platform_file_extension(ext, sizeof(ext), ext);
 
-    // Load OGG data
-    if (gs_string_compare_equal(ext, "ogg"))
-    {
+    // Mapped so the compressed data costs address space rather than heap
+    gs_audio_stream_t* st = gs_malloc_init(gs_audio_stream_t);
+    if (!gs_platform_file_view_open_mapped(file_path, &st->view)) {
+        gs_println("WARNING: Could not open file: %s", file_path);
+        gs_free(st);
+        return handle;
+    }
 
-        load_successful = gs_audio_load_ogg_data_from_file (
-            file_path, 
-            &src.sample_count, 
-            &src.channels,
+    bool32_t opened = false;
+    int32_t sample_rate = 0;
+    if (gs_string_compare_equal(ext, "mp3"))
+    {
+        st->type = GS_MP3;
+        if ((opened = drmp3_init(&st->decoder.mp3, __gs_audio_stream_mp3_read, __gs_audio_stream_mp3_seek, st, NULL))) {
+            st->src_channels = st->decoder.mp3.channels;
+            sample_rate = st->decoder.mp3.sampleRate;
+            st->frame_count = drmp3_get_pcm_frame_count(&st->decoder.mp3);
+            drmp3_uint32 seek_point_count = GS_AUDIO_STREAM_MP3_SEEK_POINTS;
+            if (drmp3_calculate_seek_points(&st->decoder.mp3, &seek_point_count, st->mp3_seek_points)) {
+                drmp3_bind_seek_table(&st->decoder.mp3, seek_point_count, st->mp3_seek_points);
+            }
+        }
+    }
+    else if (gs_string_compare_equal(ext, "wav"))
+    {
+        st->type = GS_WAV;
+        if ((opened = drwav_init_memory(&st->decoder.wav, st->view.data, st->view.size, NULL))) {
+            st->src_channels = st->decoder.wav.channels;
+            sample_rate = st->decoder.wav.sampleRate;
+            st->frame_count = st->decoder.wav.totalPCMFrameCount;
+        }
+    }
+    else if (gs_string_compare_equal(ext, "ogg"))
+    {
+        st->type = GS_OGG;
+        if ((opened = (st->decoder.ogg = stb_vorbis_open_memory((const uint8_t*)st->view.data, (int)st->view.size, NULL, NULL)) != NULL)) {
+            stb_vorbis_info info = stb_vorbis_get_info(st->decoder.ogg);
+            st->src_channels = info.channels;
+            sample_rate = info.sample_rate;
+            st->frame_count = stb_vorbis_stream_length_in_samples(st->decoder.ogg);
+        }
+    }
+
+    if (!opened || !st->src_channels || !sample_rate || !st->frame_count)
+    {
+        gs_println("WARNING: Could not stream audio source: %s", file_path);
+        if (opened) {
+            __gs_audio_stream_free(st);
+        } else {
+            gs_platform_file_view_close(&st->view);
+            gs_free(st);
+        }
+        return handle;
+    }
+
+    // The ring holds device rate stereo (at most) so the mixer only ever copies out of it
+    st->channels = gs_min(st->src_channels, 2);
+    if (st->type == GS_WAV && st->src_channels > st->channels) {
+        st->scratch = (s16*)gs_malloc(GS_AUDIO_STREAM_CHUNK_FRAMES * st->src_channels * sizeof(s16));
+    }
+    int32_t rate = __gs_audio_device_rate();
+    if (rate && rate != sample_rate)
+    {
+        st->step = ((uint64_t)sample_rate << 32) / (uint64_t)rate;
+        st->frame_count = st->frame_count * rate / sample_rate;
+        st->decoded = (s16*)gs_malloc((GS_AUDIO_STREAM_CHUNK_FRAMES + GS_AUDIO_RESAMPLE_TAPS * 2) * st->channels * sizeof(s16));
+        __gs_audio_stream_reset_resampler(st);
+        sample_rate = rate;
+    }
+
+    // Prime the ring from the start so the first play doesn't wait on the stream thread
+    st->buffer = (s16*)gs_malloc(GS_AUDIO_STREAM_BUFFER_FRAMES * st->channels * sizeof(s16));
+    st->end_serial = UINT32_MAX;
+    __gs_audio_stream_fill(st);
+
+    audio->streams[audio->stream_count] = st;
+    gs_atomic_store_u32(&audio->stream_count, audio->stream_count + 1);
+    if (audio->stream_count == 1) {
+        audio->stream_running = 1;
+        audio->stream_thread = gs_platform_thread_create(__gs_audio_stream_thread, audio);
+    }
+
+    gs_audio_source_t src = gs_default_val();
+    src.channels = st->channels;
+    src.sample_rate = sample_rate;
+    src.sample_count = (int32_t)(st->frame_count * st->channels);
+    src.stream = st;
+    gs_println("SUCCESS: Audio source streaming: %s", file_path);
+
+    return gs_audio_source_create(&src);
+}
+
+/* Add decoded source to resource cache */
+gs_handle(gs_audio_source_t) gs_audio_source_create(const gs_audio_source_t* src)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    gs_audio_source_t converted = *src;
+    if (!converted.stream) {
+        __gs_audio_convert_source(&converted, (int32_t)audio->samples_per_second);
+    }
+    return gs_handle_create(gs_audio_source_t, gs_slot_array_insert(audio->sources, converted));
+}
+
+/* Decode source samples without touching audio state, safe to call from any thread */
+bool32_t gs_audio_load_source_data_from_file(const char* file_path, gs_audio_source_t* out)
+{
+    gs_audio_source_t src = gs_default_val();
+    bool32_t load_successful = false;
+
+    if(!gs_platform_file_exists(file_path)) 
+    {
+        gs_println("WARNING: Could not open file: %s", file_path);
+        return false;
+    }
+
+    char ext[64] = gs_default_val();
+    gs_util_str_to_lower(file_path, ext, sizeof(ext));
+    gs_platform_file_extension(ext, sizeof(ext), ext);
+
+    // Load OGG data
+    if (gs_string_compare_equal(ext, "ogg"))
+    {
+
+        load_successful = gs_audio_load_ogg_data_from_file (
+            file_path, 
+            &src.sample_count, 
+            &src.channels,
             &src.sample_rate, 
             &src.samples
         );
@@ -187,332 +1051,1423 @@ gs_handle(gs_audio_source_t) gs_audio_load_from_file(const char* file_path)
         );
     }
 
-    // Load raw source into memory and return handle id
     if (load_successful)
     {
+        __gs_audio_convert_source(&src, __gs_audio_device_rate());
         gs_println("SUCCESS: Audio source loaded: %s", file_path);
+        *out = src;
+    }
+    else
+    {
+        gs_println("WARNING: Could not load audio source data: %s", file_path);
+    }
+
+    return load_successful;
+}
+
+/* Audio create instance */
+gs_handle(gs_audio_instance_t) gs_audio_instance_create(gs_audio_instance_decl_t* decl)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    gs_audio_instance_t inst = gs_default_val();
+    inst.decl = *decl;
+    uint32_t id = gs_slot_array_insert(audio->instances, inst);
+    if (decl->playing && !__gs_audio_push_instance_command(audio, GS_AUDIO_COMMAND_PLAY, id)) {
+        gs_slot_array_getp(audio->instances, id)->decl.playing = false;
+    }
+    return gs_handle_create(gs_audio_instance_t, id);
+}
+
+/* Audio play instance data */
+void gs_audio_play_source(gs_handle(gs_audio_source_t) src, float volume)
+{
+    // Construct instance data from source and play
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    gs_audio_instance_decl_t decl = gs_default_val();
+    decl.src = src;
+    decl.volume = gs_clamp(volume, audio->min_audio_volume, audio->max_audio_volume);
+    decl.persistent = false;
+    gs_handle(gs_audio_instance_t) inst = gs_audio_instance_create(&decl);
+    gs_slot_array_getp(audio->instances, inst.id)->one_shot = true;
+    gs_audio_play(inst);
+}
+
+// Helper macros
+#define __gs_audio_inst_valid(INST)\
+    gs_slot_array_handle_valid(gs_engine_subsystem(audio)->instances, INST.id)
+
+#define __gs_audio_src_valid(SRC)\
+    gs_slot_array_handle_valid(gs_engine_subsystem(audio)->sources, SRC.id)
+
+#define __gs_audio_inst_getp(INST)\
+    gs_slot_array_getp(gs_engine_subsystem(audio)->instances, INST.id)
+
+void gs_audio_play(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_i* audio = gs_engine_subsystem(audio);
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        bool32_t was_playing = ip->decl.playing;
+        ip->decl.playing = true;
+        ip->play_id = ++audio->play_id;
+        if (!__gs_audio_push_instance_command(audio, GS_AUDIO_COMMAND_PLAY, inst.id)) {
+            // The mixer will never report on a one-shot it didn't hear about
+            if (ip->one_shot) gs_slot_array_erase(audio->instances, inst.id);
+            else ip->decl.playing = was_playing;
+        }
+    }
+}
+
+void gs_audio_pause(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        bool32_t was_playing = ip->decl.playing;
+        ip->decl.playing = false;
+        if (!__gs_audio_push_instance_command(gs_engine_subsystem(audio), GS_AUDIO_COMMAND_PAUSE, inst.id)) {
+            ip->decl.playing = was_playing;
+        }
+    }
+}
+
+void gs_audio_stop(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        gs_audio_instance_t prev = *ip;
+        ip->decl.playing = false;
+        ip->decl.sample_position = 0;
+        ip->play_id = ++gs_engine_subsystem(audio)->play_id;   // Drop positions the mixer reports before it sees the stop
+        if (!__gs_audio_push_instance_command(gs_engine_subsystem(audio), GS_AUDIO_COMMAND_STOP, inst.id)) {
+            *ip = prev;
+        }
+    }
+}
+
+void gs_audio_restart(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        gs_audio_instance_t prev = *ip;
+        ip->decl.sample_position = 0;
+        ip->play_id = ++gs_engine_subsystem(audio)->play_id;
+        if (!__gs_audio_push_instance_command(gs_engine_subsystem(audio), GS_AUDIO_COMMAND_RESTART, inst.id)) {
+            *ip = prev;
+        }
+    }
+}
+
+bool32_t gs_audio_is_playing(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        return __gs_audio_inst_getp(inst)->decl.playing;
+    }
+    return false;
+}
+
+gs_audio_voice_stats_t gs_audio_get_voice_stats()
+{
+    gs_audio_voice_stats_t* vs = &gs_engine_subsystem(audio)->voice_stats;
+    gs_audio_voice_stats_t stats = gs_default_val();
+    stats.active = gs_atomic_load_u32(&vs->active);
+    stats.virtualized = gs_atomic_load_u32(&vs->virtualized);
+    stats.stolen = gs_atomic_load_u32(&vs->stolen);
+    stats.rejected = gs_atomic_load_u32(&vs->rejected);
+    return stats;
+}
+
+/* Audio spatialization */
+void gs_audio_set_listener(gs_vqs transform, gs_vec3 velocity)
+{
+    gs_audio_command_t cmd = gs_default_val();
+    cmd.type = GS_AUDIO_COMMAND_SET_LISTENER;
+    cmd.listener.transform = transform;
+    cmd.listener.velocity = velocity;
+    __gs_audio_push_command(gs_engine_subsystem(audio), &cmd);
+}
+
+void gs_audio_set_position(gs_handle(gs_audio_instance_t) inst, gs_vec3 position, gs_vec3 velocity)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        ip->decl.emitter.position = position;
+        ip->decl.emitter.velocity = velocity;
+        __gs_audio_push_instance_command(gs_engine_subsystem(audio), GS_AUDIO_COMMAND_SET_POSITION, inst.id);
+    }
+}
+
+/* Audio buses */
+uint32_t gs_audio_bus_create(const char* name, uint32_t parent)
+{
+    return __gs_audio_bus_add(gs_engine_subsystem(audio), name, parent);
+}
+
+uint32_t gs_audio_bus_find(const char* name)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    for (uint32_t i = 0; i < audio->bus_count; ++i) {
+        if (gs_string_compare_equal(audio->buses[i].name, name)) return i;
+    }
+    return GS_AUDIO_BUS_INVALID;
+}
+
+void gs_audio_bus_set_volume(uint32_t bus, float volume)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    if (bus < audio->bus_count) {
+        audio->buses[bus].volume = volume;
+        gs_audio_command_t cmd = gs_default_val();
+        cmd.type = GS_AUDIO_COMMAND_SET_BUS_VOLUME;
+        cmd.bus.id = bus;
+        cmd.bus.volume = volume;
+        __gs_audio_push_command(audio, &cmd);
+    }
+}
+
+float gs_audio_bus_get_volume(uint32_t bus)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    return bus < audio->bus_count ? audio->buses[bus].volume : 0.f;
+}
+
+void gs_audio_bus_set_effect(uint32_t bus, uint32_t slot, const gs_audio_effect_desc_t* effect)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    if (bus >= audio->bus_count || slot >= GS_AUDIO_MAX_BUS_EFFECTS) return;
+
+    gs_audio_bus_t* b = &audio->buses[bus];
+    gs_audio_effect_desc_t desc = gs_default_val();
+    if (effect) desc = *effect;
+
+    // The mixer may still be running an older reverb on this slot, so its delay lines are reused rather than replaced
+    if (desc.type == GS_AUDIO_EFFECT_REVERB && !b->effect_memory[slot]) {
+        b->effect_memory[slot] = __gs_audio_reverb_create(audio->samples_per_second);
+    }
+    b->effects[slot] = desc;
+
+    gs_audio_command_t cmd = gs_default_val();
+    cmd.type = GS_AUDIO_COMMAND_SET_BUS_EFFECT;
+    cmd.bus.id = bus;
+    cmd.bus.slot = slot;
+    cmd.bus.effect = desc;
+    cmd.bus.memory = b->effect_memory[slot];
+    __gs_audio_push_command(audio, &cmd);
+}
+
+/* Audio instance data */
+void gs_audio_set_instance_data(gs_handle(gs_audio_instance_t) inst, gs_audio_instance_decl_t decl)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        gs_audio_instance_decl_t prev = ip->decl;
+        ip->decl = decl;
+        if (decl.playing && !prev.playing) {
+            gs_audio_play(inst);
+        } else {
+            // Only seek when the position was actually changed, the mirror lags the mixer
+            if (!__gs_audio_push_instance_command(gs_engine_subsystem(audio),
+                decl.sample_position != prev.sample_position ? GS_AUDIO_COMMAND_SEEK : GS_AUDIO_COMMAND_SET_DATA, inst.id))
+            {
+                ip->decl = prev;
+            }
+        }
+    }
+}
+
+gs_audio_instance_decl_t gs_audio_get_instance_data(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        return __gs_audio_inst_getp(inst)->decl;
+    }
+    gs_audio_instance_decl_t decl = gs_default_val();
+    return decl;
+}
+
+float gs_audio_get_volume(gs_handle(gs_audio_instance_t) inst)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        return __gs_audio_inst_getp(inst)->decl.volume;
+    }
+    return 0.f;
+}
+
+void gs_audio_set_volume(gs_handle(gs_audio_instance_t) inst, float volume)
+{
+    if (__gs_audio_inst_valid(inst)) {
+        gs_audio_instance_t* ip = __gs_audio_inst_getp(inst);
+        float prev = ip->decl.volume;
+        ip->decl.volume = volume;
+        if (!__gs_audio_push_instance_command(gs_engine_subsystem(audio), GS_AUDIO_COMMAND_SET_VOLUME, inst.id)) {
+            ip->decl.volume = prev;
+        }
+    }
+}
+
+/* Audio source data */
+gs_audio_source_t* gs_audio_get_source_data(gs_handle(gs_audio_source_t) src)
+{
+    if (__gs_audio_src_valid(src)) {
+        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id);
+    }
+    return NULL;
+}
+
+void gs_audio_get_runtime(gs_handle(gs_audio_source_t) src, int32_t* minutes_out, int32_t* seconds_out)
+{
+    if (__gs_audio_src_valid(src)) {
+        gs_audio_i* audio = gs_engine_subsystem(audio);
+        gs_audio_source_t* sp = gs_slot_array_getp(audio->sources, src.id);
+        if (sp)
+        {
+            // Calculate total length in seconds
+            float64_t total_seconds = ((float32_t)sp->sample_count / (float32_t)sp->sample_rate) / sp->channels;
+            int32_t seconds = (int32_t)(fmodf(total_seconds, 60.f));
+            int32_t minutes = (int32_t)(total_seconds / 60.f);  
+
+            if (minutes_out) {
+                *minutes_out = minutes;
+            }
+
+            if (seconds_out) {
+                *seconds_out = seconds;
+            }
+        }
+    }
+}
+
+void gs_audio_convert_to_runtime(int32_t sample_count, int32_t sample_rate, int32_t num_channels, int32_t position, int32_t* minutes_out, int32_t* seconds_out)
+{
+    // Calculate total length in seconds
+    float64_t frac = (float64_t)position / (float64_t)sample_count;
+    float64_t total_seconds = ((float64_t)sample_count / (float64_t)sample_rate) / num_channels;
+    total_seconds = total_seconds * frac;
+    int32_t seconds = (int32_t)(fmodf(total_seconds, 60.f));
+    int32_t minutes = (int32_t)(total_seconds / 60.f);  
+
+    if (minutes_out) {
+        *minutes_out = minutes;
+    }
+
+    if (seconds_out) {
+        *seconds_out = seconds;
+    }
+}
+
+int32_t gs_audio_get_sample_count(gs_handle(gs_audio_source_t) src)
+{
+    if (__gs_audio_src_valid(src)) {
+        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id)->sample_count;
+    }
+    return 0;
+}
+
+int32_t gs_audio_get_sample_rate(gs_handle(gs_audio_source_t) src)
+{
+    if (__gs_audio_src_valid(src)) {
+        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id)->sample_rate;
+    }
+    return 0;
+}
+
+int32_t gs_audio_get_num_channels(gs_handle(gs_audio_source_t) src)
+{
+    if (__gs_audio_src_valid(src)) {
+        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id)->channels;
+    }
+    return 0;
+}
+
+#undef GS_AUDIO_IMPL_DEFAULT
+#endif // GS_AUDIO_IMPL_DEFAULT
+
+/*=============================
+// Miniaudio Impl
+=============================*/
+
+#ifdef GS_AUDIO_IMPL_MINIAUDIO
+
+#define MINIAUDIO_IMPLEMENTATION
+#include "../external/miniaudio/miniaudio.h"
+
+#if (!defined GS_AUDIO_NO_SIMD && (defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)))
+    #include <emmintrin.h>
+    #define GS_AUDIO_SIMD_SSE2
+#elif (!defined GS_AUDIO_NO_SIMD && (defined __ARM_NEON || defined __ARM_NEON__))
+    #include <arm_neon.h>
+    #define GS_AUDIO_SIMD_NEON
+#endif
+
+#ifndef GS_AUDIO_MIX_BLOCK_FRAMES
+    #define GS_AUDIO_MIX_BLOCK_FRAMES   256     // Frames mixed per pass, sized to keep both buffers in L1
+#endif
+
+#ifndef GS_AUDIO_SOFT_CLIP_KNEE
+    #define GS_AUDIO_SOFT_CLIP_KNEE     0.8f    // Bus level above which the output is smoothly compressed towards full scale
+#endif
+
+typedef struct __gs_audio_biquad_t
+{
+    float b0, b1, b2, a1, a2;
+    float z[2][2];                  // Transposed direct form II state per side
+} __gs_audio_biquad_t;
+
+typedef struct __gs_audio_effect_t
+{
+    gs_audio_effect_desc_t desc;
+    __gs_audio_biquad_t biquad;
+    __gs_audio_reverb_t* reverb;
+    float gain;                     // Compressor gain applied by the last block
+    float reduction;                // Compressor gain reduction in dB, smoothed
+} __gs_audio_effect_t;
+
+typedef struct __gs_audio_bus_state_t
+{
+    uint32_t parent;
+    float volume;
+    float gain;                     // Volume applied by the last block, ramped towards volume
+    float level;                    // Peak of the last block sent to the parent, keys sidechained compressors
+    __gs_audio_effect_t effects[GS_AUDIO_MAX_BUS_EFFECTS];
+} __gs_audio_bus_state_t;
+
+typedef struct miniaudio_data_t
+{
+    ma_context context;
+    ma_device device;
+    ma_device_config device_config;
+    float mix[GS_AUDIO_MIX_BLOCK_FRAMES * 2];       // Stereo float accumulation bus
+    float voice[GS_AUDIO_MIX_BLOCK_FRAMES * 2];     // Current voice, resampled to stereo float
+    float bus_mix[GS_AUDIO_MAX_BUSES][GS_AUDIO_MIX_BLOCK_FRAMES * 2];
+    __gs_audio_bus_state_t buses[GS_AUDIO_MAX_BUSES];
+    uint32_t bus_count;
+} miniaudio_data_t;
+
+/* Everything below runs on the audio thread and only touches the voice pool and the two queues */
+
+static gs_audio_voice_t* __gs_audio_find_voice(gs_audio_i* audio, uint32_t inst)
+{
+    for (uint32_t i = 0; i < audio->voice_count; ++i) {
+        if (audio->voices[i].inst == inst) return &audio->voices[i];
+    }
+    return NULL;
+}
+
+static void __gs_audio_release_voice(gs_audio_i* audio, gs_audio_voice_t* v)
+{
+    *v = audio->voices[--audio->voice_count];
+}
 
-        // Add to resource cache
-        handle.id = gs_slot_array_insert(audio->sources, src);
+static bool32_t __gs_audio_push_event(gs_audio_i* audio, gs_audio_event_type type, uint32_t inst, uint32_t play_id, double position)
+{
+    gs_audio_event_queue_t* q = &audio->events;
+    uint32_t write = q->write;
+    if (write - gs_atomic_load_u32(&q->read) >= GS_AUDIO_EVENT_QUEUE_SIZE) {
+        return false;
+    }
+    gs_audio_event_t* evt = &q->data[write & (GS_AUDIO_EVENT_QUEUE_SIZE - 1)];
+    evt->type = type;
+    evt->inst = inst;
+    evt->play_id = play_id;
+    evt->sample_position = position;
+    gs_atomic_store_u32(&q->write, write + 1);
+    return true;
+}
+
+// Ranking used for both stealing and virtualization, priority first then loudness
+#define __gs_audio_voice_score(PRIORITY, VOLUME)\
+    ((double)(PRIORITY) * 1024.0 + (double)gs_clamp((VOLUME), 0.f, 1023.f))
+
+// Loudness as heard by the listener
+#define __gs_audio_voice_level(V)\
+    gs_max((V)->target[0], (V)->target[1])
+
+// Finds a voice for a new play, stealing the lowest scored voice if the pool is full and it ranks below the newcomer
+static gs_audio_voice_t* __gs_audio_alloc_voice(gs_audio_i* audio, const gs_audio_command_t* cmd)
+{
+    if (audio->voice_count < GS_AUDIO_MAX_VOICES) {
+        return &audio->voices[audio->voice_count++];
+    }
+
+    gs_audio_voice_t* victim = NULL;
+    double victim_score = 0.0;
+    for (uint32_t i = 0; i < audio->voice_count; ++i)
+    {
+        gs_audio_voice_t* v = &audio->voices[i];
+        double score = v->finished ? -DBL_MAX : __gs_audio_voice_score(v->priority, v->playing ? __gs_audio_voice_level(v) : 0.f);
+        if (!victim || score < victim_score) {
+            victim = v;
+            victim_score = score;
+        }
+    }
+
+    // The victim's instance has to learn that it stopped, otherwise keep it and drop the newcomer
+    if (victim_score > __gs_audio_voice_score(cmd->decl.priority, cmd->decl.volume) ||
+        !__gs_audio_push_event(audio, GS_AUDIO_EVENT_FINISHED, victim->inst, victim->play_id, victim->finished ? 0.0 : victim->sample_position)) 
+    {
+        return NULL;
+    }
+
+    gs_atomic_store_u32(&audio->voice_stats.stolen, audio->voice_stats.stolen + 1);
+    memset(victim, 0, sizeof(gs_audio_voice_t));
+    return victim;
+}
+
+// Marks inaudible voices and everything below the GS_AUDIO_MAX_MIXED_VOICES best playing voices as virtual
+static void __gs_audio_virtualize_voices(gs_audio_i* audio)
+{
+    double scores[GS_AUDIO_MAX_VOICES];
+    uint32_t count = 0, inaudible = 0;
+    for (uint32_t i = 0; i < audio->voice_count; ++i)
+    {
+        gs_audio_voice_t* v = &audio->voices[i];
+        v->virtualized = false;
+        if (!v->playing || v->finished) continue;
+        if (__gs_audio_voice_level(v) < GS_AUDIO_AUDIBLE_THRESHOLD) {
+            v->virtualized = true;
+            ++inaudible;
+            continue;
+        }
+        scores[count++] = __gs_audio_voice_score(v->priority, __gs_audio_voice_level(v));
+    }
+
+    uint32_t active = count;
+    if (count > GS_AUDIO_MAX_MIXED_VOICES)
+    {
+        // Quickselect the cutoff score so the cost stays linear in the voice count
+        int32_t k = GS_AUDIO_MAX_MIXED_VOICES - 1, lo = 0, hi = (int32_t)count - 1;
+        while (lo < hi)
+        {
+            double pivot = scores[(lo + hi) / 2];
+            int32_t i = lo, j = hi;
+            while (i <= j)
+            {
+                while (scores[i] > pivot) ++i;
+                while (scores[j] < pivot) --j;
+                if (i <= j) {
+                    double t = scores[i]; scores[i] = scores[j]; scores[j] = t;
+                    ++i; --j;
+                }
+            }
+            if (k <= j) hi = j;
+            else if (k >= i) lo = i;
+            else break;
+        }
+        double cutoff = scores[k];
+
+        // Strictly better voices always mix, ties fill whatever is left in pool order
+        uint32_t above = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (scores[i] > cutoff) ++above;
+        }
+        uint32_t ties = GS_AUDIO_MAX_MIXED_VOICES - above;
+
+        for (uint32_t i = 0; i < audio->voice_count; ++i)
+        {
+            gs_audio_voice_t* v = &audio->voices[i];
+            if (!v->playing || v->finished || v->virtualized) continue;
+            double score = __gs_audio_voice_score(v->priority, __gs_audio_voice_level(v));
+            if (score > cutoff) continue;
+            if (score == cutoff && ties) {--ties; continue;}
+            v->virtualized = true;
+        }
+        active = GS_AUDIO_MAX_MIXED_VOICES;
+    }
+
+    gs_atomic_store_u32(&audio->voice_stats.active, active);
+    gs_atomic_store_u32(&audio->voice_stats.virtualized, count - active + inaudible);
+}
+
+// Last frame a voice can interpolate from, in frames
+#define __gs_audio_voice_end(V)\
+    ((V)->src.channels > 0 ? (V)->src.sample_count / (V)->src.channels - 1 : 0)
+
+/*
+    Mix kernels. Voices are rendered to stereo float, added into the float bus with their gain and the bus is soft 
+    clipped and converted to s16 once at the end, so nothing can wrap around however many voices overlap.
+*/
+
+// Whole frames, no resampling: plain s16 to float conversion (mono is duplicated to both sides)
+static void __gs_audio_convert_s16(const s16* s, uint32_t channels, uint32_t n, float* out)
+{
+    const float scale = 1.f / 32768.f;
+    uint32_t i = 0;
+
+#if (defined GS_AUDIO_SIMD_SSE2)
+    const __m128 vs = _mm_set1_ps(scale);
+    if (channels == 2)
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i * 2));
+            __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+            __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+            _mm_storeu_ps(out + i * 2, _mm_mul_ps(lo, vs));
+            _mm_storeu_ps(out + i * 2 + 4, _mm_mul_ps(hi, vs));
+        }
+    }
+    else
+    {
+        for (; i + 8 <= n; i += 8)
+        {
+            __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+            __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), vs);
+            __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), vs);
+            _mm_storeu_ps(out + i * 2,      _mm_unpacklo_ps(lo, lo));
+            _mm_storeu_ps(out + i * 2 + 4,  _mm_unpackhi_ps(lo, lo));
+            _mm_storeu_ps(out + i * 2 + 8,  _mm_unpacklo_ps(hi, hi));
+            _mm_storeu_ps(out + i * 2 + 12, _mm_unpackhi_ps(hi, hi));
+        }
+    }
+#elif (defined GS_AUDIO_SIMD_NEON)
+    if (channels == 2)
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            int16x8_t v = vld1q_s16(s + i * 2);
+            vst1q_f32(out + i * 2,     vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+            vst1q_f32(out + i * 2 + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+        }
+    }
+    else
+    {
+        for (; i + 4 <= n; i += 4)
+        {
+            float32x4_t f = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(s + i))), scale);
+            vst2q_f32(out + i * 2, (float32x4x2_t){{f, f}});
+        }
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        const s16* f = s + i * channels;
+        out[i * 2]     = f[0] * scale;
+        out[i * 2 + 1] = f[channels > 1 ? 1 : 0] * scale;
+    }
+}
+
+// Interpolation at a 32.32 fixed point position/step, keeps divisions and doubles out of the inner loop
+static void __gs_audio_fetch(const s16* s, uint32_t channels, int64_t frames, uint64_t p, uint64_t step, bool32_t hq, uint32_t n, float* out)
+{
+    if (step == ((uint64_t)1 << 32) && !(p & 0xffffffff)) {
+        __gs_audio_convert_s16(s + (p >> 32) * channels, channels, n, out);
+        return;
+    }
+
+    if (hq)
+    {
+        const uint32_t band = __gs_audio_resample_band(step);
+        for (uint32_t i = 0; i < n; ++i, p += step) {
+            __gs_audio_resample_frame(s, channels, frames, p, band, out + i * 2);
+        }
+        return;
+    }
+
+    const float scale = 1.f / 32768.f;
+    const uint32_t r = channels > 1 ? 1 : 0;
+    uint32_t i = 0;
+
+    // Positions are arbitrary so the taps are gathered per frame, two frames are lerped per vector
+#if (defined GS_AUDIO_SIMD_SSE2)
+    const __m128 vs = _mm_set1_ps(scale);
+    for (; i + 2 <= n; i += 2, p += step * 2)
+    {
+        const s16* a = s + (p >> 32) * channels;
+        const s16* b = s + ((p + step) >> 32) * channels;
+        float ta = (float)(uint32_t)p * (1.f / 4294967296.f);
+        float tb = (float)(uint32_t)(p + step) * (1.f / 4294967296.f);
+        __m128 x0 = _mm_setr_ps(a[0], a[r], b[0], b[r]);
+        __m128 x1 = _mm_setr_ps(a[channels], a[channels + r], b[channels], b[channels + r]);
+        __m128 t = _mm_setr_ps(ta, ta, tb, tb);
+        _mm_storeu_ps(out + i * 2, _mm_mul_ps(_mm_add_ps(x0, _mm_mul_ps(_mm_sub_ps(x1, x0), t)), vs));
+    }
+#elif (defined GS_AUDIO_SIMD_NEON)
+    for (; i + 2 <= n; i += 2, p += step * 2)
+    {
+        const s16* a = s + (p >> 32) * channels;
+        const s16* b = s + ((p + step) >> 32) * channels;
+        float ta = (float)(uint32_t)p * (1.f / 4294967296.f);
+        float tb = (float)(uint32_t)(p + step) * (1.f / 4294967296.f);
+        float32x4_t x0 = {a[0], a[r], b[0], b[r]};
+        float32x4_t x1 = {a[channels], a[channels + r], b[channels], b[channels + r]};
+        float32x4_t t = {ta, ta, tb, tb};
+        vst1q_f32(out + i * 2, vmulq_n_f32(vaddq_f32(x0, vmulq_f32(vsubq_f32(x1, x0), t)), scale));
+    }
+#endif
+
+    for (; i < n; ++i, p += step)
+    {
+        const s16* a = s + (p >> 32) * channels;
+        float t = (float)(uint32_t)p * (1.f / 4294967296.f);
+        out[i * 2]     = (a[0] + (a[channels] - a[0]) * t) * scale;
+        out[i * 2 + 1] = (a[r] + (a[channels + r] - a[r]) * t) * scale;
+    }
+}
+
+// mix += in * gain, ramping the gain from g0 to g1 over the block so volume changes don't zipper
+static void __gs_audio_mix_gain(float* mix, const float* in, uint32_t n, const float* g0, const float* g1)
+{
+    if (!n) return;
+    const float dl = (g1[0] - g0[0]) / (float)n;
+    const float dr = (g1[1] - g0[1]) / (float)n;
+    uint32_t i = 0;
+
+#if (defined GS_AUDIO_SIMD_SSE2)
+    __m128 g = _mm_setr_ps(g0[0], g0[1], g0[0] + dl, g0[1] + dr);
+    const __m128 dg = _mm_setr_ps(2.f * dl, 2.f * dr, 2.f * dl, 2.f * dr);
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128 m = _mm_loadu_ps(mix + i * 2);
+        _mm_storeu_ps(mix + i * 2, _mm_add_ps(m, _mm_mul_ps(_mm_loadu_ps(in + i * 2), g)));
+        g = _mm_add_ps(g, dg);
+    }
+#elif (defined GS_AUDIO_SIMD_NEON)
+    float32x4_t g = {g0[0], g0[1], g0[0] + dl, g0[1] + dr};
+    const float32x4_t dg = {2.f * dl, 2.f * dr, 2.f * dl, 2.f * dr};
+    for (; i + 2 <= n; i += 2)
+    {
+        vst1q_f32(mix + i * 2, vmlaq_f32(vld1q_f32(mix + i * 2), vld1q_f32(in + i * 2), g));
+        g = vaddq_f32(g, dg);
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        mix[i * 2]     += in[i * 2] * (g0[0] + dl * i);
+        mix[i * 2 + 1] += in[i * 2 + 1] * (g0[1] + dr * i);
+    }
+}
+
+// Linear below the knee, then x/(1+x) shaped towards full scale with a continuous slope
+static void __gs_audio_soft_clip_s16(const float* mix, s16* out, uint32_t count)
+{
+    const float knee = GS_AUDIO_SOFT_CLIP_KNEE;
+    const float range = 1.f - knee;
+    const float inv_range = 1.f / range;
+    uint32_t i = 0;
+
+#if (defined GS_AUDIO_SIMD_SSE2)
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    const __m128 vk = _mm_set1_ps(knee), vr = _mm_set1_ps(range), vir = _mm_set1_ps(inv_range);
+    const __m128 one = _mm_set1_ps(1.f), zero = _mm_setzero_ps(), full = _mm_set1_ps(32767.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i w[2];
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            __m128 x = _mm_loadu_ps(mix + i + j * 4);
+            __m128 sign = _mm_and_ps(x, sign_mask);
+            __m128 a = _mm_andnot_ps(sign_mask, x);
+            __m128 z = _mm_mul_ps(_mm_max_ps(_mm_sub_ps(a, vk), zero), vir);
+            __m128 y = _mm_add_ps(_mm_min_ps(a, vk), _mm_mul_ps(vr, _mm_div_ps(z, _mm_add_ps(one, z))));
+            w[j] = _mm_cvtps_epi32(_mm_mul_ps(_mm_or_ps(y, sign), full));
+        }
+        _mm_storeu_si128((__m128i*)(out + i), _mm_packs_epi32(w[0], w[1]));
     }
-    else
+#elif (defined GS_AUDIO_SIMD_NEON)
+    const float32x4_t vk = vdupq_n_f32(knee), one = vdupq_n_f32(1.f), zero = vdupq_n_f32(0.f);
+    for (; i + 8 <= count; i += 8)
     {
-        gs_println("WARNING: Could not load audio source data: %s", file_path);
+        int16x4_t w[2];
+        for (uint32_t j = 0; j < 2; ++j)
+        {
+            float32x4_t x = vld1q_f32(mix + i + j * 4);
+            float32x4_t a = vabsq_f32(x);
+            float32x4_t z = vmulq_n_f32(vmaxq_f32(vsubq_f32(a, vk), zero), inv_range);
+            float32x4_t d = vaddq_f32(one, z);
+        #if (defined __aarch64__)
+            float32x4_t q = vdivq_f32(z, d);
+        #else
+            float32x4_t rd = vrecpeq_f32(d);
+            rd = vmulq_f32(rd, vrecpsq_f32(d, rd));
+            rd = vmulq_f32(rd, vrecpsq_f32(d, rd));
+            float32x4_t q = vmulq_f32(z, rd);
+        #endif
+            float32x4_t y = vmlaq_n_f32(vminq_f32(a, vk), q, range);
+            y = vbslq_f32(vcltq_f32(x, zero), vnegq_f32(y), y);
+        #if (defined __aarch64__)
+            w[j] = vqmovn_s32(vcvtnq_s32_f32(vmulq_n_f32(y, 32767.f)));
+        #else
+            w[j] = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(y, 32767.f)));
+        #endif
+        }
+        vst1q_s16(out + i, vcombine_s16(w[0], w[1]));
     }
+#endif
 
-    return handle;
+    for (; i < count; ++i)
+    {
+        float a = fabsf(mix[i]);
+        float z = gs_max(a - knee, 0.f) * inv_range;
+        float y = gs_min(a, knee) + range * (z / (1.f + z));
+        out[i] = (s16)lrintf((mix[i] < 0.f ? -y : y) * 32767.f);
+    }
 }
 
-/* Audio create instance */
-gs_handle(gs_audio_instance_t) gs_audio_instance_create(gs_audio_instance_decl_t* decl)
+/*
+    Bus effects, each processes a whole mix block of stereo float in place.
+*/
+
+static float __gs_audio_peak(const float* buf, uint32_t count)
 {
-    gs_audio_i* audio = gs_engine_subsystem(audio);
-    return gs_handle_create(gs_audio_instance_t, gs_slot_array_insert(audio->instances, *decl));    
+    float peak = 0.f;
+    for (uint32_t i = 0; i < count; ++i) {
+        peak = gs_max(peak, fabsf(buf[i]));
+    }
+    return peak;
 }
 
-/* Audio play instance data */
-void gs_audio_play_source(gs_handle(gs_audio_source_t) src, float volume)
+// RBJ cookbook low/high pass
+static void __gs_audio_biquad_set(__gs_audio_biquad_t* bq, gs_audio_effect_type type, float frequency, float q, float rate)
 {
-    // Construct instance data from source and play
-    gs_audio_i* audio = gs_engine_subsystem(audio);
-    gs_audio_instance_decl_t decl = gs_default_val();
-    decl.src = src;
-    decl.volume = gs_clamp(volume, audio->min_audio_volume, audio->max_audio_volume);
-    decl.persistent = false;
-    gs_handle(gs_audio_instance_t) inst = gs_audio_instance_create(&decl);
-    gs_audio_play(inst);
+    const float w0 = 2.f * (float)GS_PI * gs_clamp(frequency, 10.f, rate * 0.45f) / rate;
+    const float cw = cosf(w0);
+    const float alpha = sinf(w0) / (2.f * (q > 0.f ? q : 0.7071f));
+    const float a0 = 1.f + alpha;
+    const float b1 = type == GS_AUDIO_EFFECT_LOWPASS ? 1.f - cw : -(1.f + cw);
+    bq->b0 = bq->b2 = fabsf(b1) * 0.5f / a0;
+    bq->b1 = b1 / a0;
+    bq->a1 = -2.f * cw / a0;
+    bq->a2 = (1.f - alpha) / a0;
 }
 
-// Helper macros
-#define __gs_audio_inst_valid(INST)\
-    gs_slot_array_handle_valid(gs_engine_subsystem(audio)->instances, INST.id)
-
-#define __gs_audio_src_valid(SRC)\
-    gs_slot_array_handle_valid(gs_engine_subsystem(audio)->sources, SRC.id)
-
-void gs_audio_play(gs_handle(gs_audio_instance_t) inst)
+static void __gs_audio_biquad_process(__gs_audio_biquad_t* bq, float* buf, uint32_t n)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id)->playing = true;
+    for (uint32_t c = 0; c < 2; ++c)
+    {
+        float z0 = bq->z[c][0], z1 = bq->z[c][1];
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            float x = buf[i * 2 + c];
+            float y = bq->b0 * x + z0;
+            z0 = bq->b1 * x - bq->a1 * y + z1;
+            z1 = bq->b2 * x - bq->a2 * y;
+            buf[i * 2 + c] = y;
+        }
+        bq->z[c][0] = z0;
+        bq->z[c][1] = z1;
     }
 }
 
-void gs_audio_pause(gs_handle(gs_audio_instance_t) inst)
+static void __gs_audio_reverb_process(__gs_audio_reverb_t* rv, const gs_audio_effect_desc_t* desc, float* buf, uint32_t n)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id)->playing = false;
+    const float feedback = 0.7f + 0.28f * gs_clamp(desc->room_size, 0.f, 1.f);
+    const float damp = 0.4f * gs_clamp(desc->damping, 0.f, 1.f);
+    const float wet = gs_clamp(desc->wet, 0.f, 1.f);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        const float in = (buf[i * 2] + buf[i * 2 + 1]) * 0.015f;
+        for (uint32_t c = 0; c < 2; ++c)
+        {
+            float out = 0.f;
+            for (uint32_t k = 0; k < 4; ++k)
+            {
+                __gs_audio_delay_t* dl = &rv->comb[c][k];
+                float y = dl->data[dl->pos];
+                dl->store = y * (1.f - damp) + dl->store * damp;
+                dl->data[dl->pos] = in + dl->store * feedback;
+                if (++dl->pos == dl->length) dl->pos = 0;
+                out += y;
+            }
+            for (uint32_t k = 0; k < 2; ++k)
+            {
+                __gs_audio_delay_t* dl = &rv->allpass[c][k];
+                float b = dl->data[dl->pos];
+                dl->data[dl->pos] = out + b * 0.5f;
+                if (++dl->pos == dl->length) dl->pos = 0;
+                out = b - out;
+            }
+            buf[i * 2 + c] = buf[i * 2 + c] * (1.f - wet) + out * wet * 3.f;
+        }
     }
 }
 
-void gs_audio_stop(gs_handle(gs_audio_instance_t) inst)
+// Gain reduction is worked out once per block from the key's peak and ramped across it
+static void __gs_audio_compressor_process(__gs_audio_effect_t* e, float key, float* buf, uint32_t n, float rate)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        gs_audio_instance_t* ip = gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id);
-        ip->playing = false;
-        ip->sample_position = 0;
+    const gs_audio_effect_desc_t* desc = &e->desc;
+    const float ratio = desc->ratio > 0.f ? gs_max(desc->ratio, 1.f) : 4.f;
+    const float level = 20.f * log10f(gs_max(key, 1e-6f));
+    const float target = gs_max(level - desc->threshold, 0.f) * (1.f - 1.f / ratio);
+    const float ms = target > e->reduction ? desc->attack_ms : desc->release_ms;
+    const float coeff = ms > 0.f ? expf(-(float)n / (ms * 0.001f * rate)) : 0.f;
+    e->reduction = target + (e->reduction - target) * coeff;
+
+    const float gain = powf(10.f, -e->reduction / 20.f);
+    const float dg = (gain - e->gain) / (float)n;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        float g = e->gain + dg * i;
+        buf[i * 2] *= g;
+        buf[i * 2 + 1] *= g;
     }
+    e->gain = gain;
 }
 
-void gs_audio_restart(gs_handle(gs_audio_instance_t) inst)
+static void __gs_audio_apply_effect(__gs_audio_effect_t* e, const gs_audio_bus_command_t* bc, float rate)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id)->sample_position = 0;
+    const gs_audio_effect_type prev = e->desc.type;
+    e->desc = bc->effect;
+    switch (e->desc.type)
+    {
+        case GS_AUDIO_EFFECT_LOWPASS:
+        case GS_AUDIO_EFFECT_HIGHPASS:
+        {
+            // History carries over while only the coefficients change, so sweeping a filter doesn't click
+            if (prev != e->desc.type) memset(&e->biquad, 0, sizeof(__gs_audio_biquad_t));
+            __gs_audio_biquad_set(&e->biquad, e->desc.type, e->desc.frequency, e->desc.q, rate);
+        } break;
+
+        case GS_AUDIO_EFFECT_REVERB:
+        {
+            __gs_audio_reverb_t* rv = (__gs_audio_reverb_t*)bc->memory;
+            if (rv && (prev != GS_AUDIO_EFFECT_REVERB || e->reverb != rv))
+            {
+                memset(rv + 1, 0, rv->size * sizeof(float));
+                for (uint32_t c = 0; c < 2; ++c) {
+                    for (uint32_t k = 0; k < 4; ++k) rv->comb[c][k].pos = 0, rv->comb[c][k].store = 0.f;
+                    for (uint32_t k = 0; k < 2; ++k) rv->allpass[c][k].pos = 0;
+                }
+            }
+            e->reverb = rv;
+        } break;
+
+        case GS_AUDIO_EFFECT_COMPRESSOR:
+        {
+            if (prev != GS_AUDIO_EFFECT_COMPRESSOR) {
+                e->gain = 1.f;
+                e->reduction = 0.f;
+            }
+        } break;
+
+        default: break;
     }
 }
 
-bool32_t gs_audio_is_playing(gs_handle(gs_audio_instance_t) inst)
+// Runs each bus' effects and folds it into its parent, children first so the master lands in ma->mix last
+static void __gs_audio_process_buses(gs_audio_i* audio, miniaudio_data_t* ma, uint32_t n)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        return (gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id)->playing);
+    const float rate = (float)(audio->samples_per_second ? audio->samples_per_second : 44100);
+    for (int32_t b = (int32_t)ma->bus_count - 1; b >= 0; --b)
+    {
+        __gs_audio_bus_state_t* bus = &ma->buses[b];
+        float* buf = ma->bus_mix[b];
+        for (uint32_t s = 0; s < GS_AUDIO_MAX_BUS_EFFECTS; ++s)
+        {
+            __gs_audio_effect_t* e = &bus->effects[s];
+            switch (e->desc.type)
+            {
+                case GS_AUDIO_EFFECT_LOWPASS:
+                case GS_AUDIO_EFFECT_HIGHPASS:  __gs_audio_biquad_process(&e->biquad, buf, n); break;
+                case GS_AUDIO_EFFECT_REVERB:    if (e->reverb) __gs_audio_reverb_process(e->reverb, &e->desc, buf, n); break;
+                case GS_AUDIO_EFFECT_COMPRESSOR:
+                {
+                    // Keys processed after this bus (lower ids) are heard one block late. Master already
+                    // contains this bus, so 0 (the zeroed default) keys on the bus itself like any invalid id
+                    uint32_t key = e->desc.sidechain;
+                    float level = key && key < ma->bus_count && key != (uint32_t)b ? ma->buses[key].level : __gs_audio_peak(buf, n * 2);
+                    __gs_audio_compressor_process(e, level, buf, n, rate);
+                } break;
+                default: break;
+            }
+        }
+
+        float g0[2] = {bus->gain, bus->gain}, g1[2] = {bus->volume, bus->volume};
+        __gs_audio_mix_gain(b ? ma->bus_mix[bus->parent] : ma->mix, buf, n, g0, g1);
+        bus->gain = bus->volume;
+        bus->level = __gs_audio_peak(buf, n * 2) * bus->volume;
     }
-    return false;
 }
 
-/* Audio instance data */
-void gs_audio_set_instance_data(gs_handle(gs_audio_instance_t) inst, gs_audio_instance_decl_t decl)
+// Asks the stream thread to restart decoding at frame, the voice stays silent until it has
+static void __gs_audio_stream_request_seek(gs_audio_stream_t* st, uint32_t frame)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        *gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id) = decl;
-    }
+    st->seek_frame = frame;
+    st->dirty = true;
+    gs_atomic_store_u32(&st->seek_serial, st->seek_serial + 1);
 }
 
-gs_audio_instance_decl_t gs_audio_get_instance_data(gs_handle(gs_audio_instance_t) inst)
+// A decode that already reached the end of the file won't wrap, so turning loop on restarts it at the voice's frame
+static void __gs_audio_stream_set_loop(gs_audio_stream_t* st, bool32_t loop, double sample_position)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        return gs_slot_array_get(gs_engine_subsystem(audio)->instances, inst.id);
+    gs_atomic_store_u32(&st->loop, (uint32_t)loop);
+    if (loop && gs_atomic_load_u32(&st->end_serial) == st->seek_serial) {
+        __gs_audio_stream_request_seek(st, (uint32_t)(sample_position / st->channels));
     }
-    gs_audio_instance_decl_t decl = gs_default_val();
-    return decl;
 }
 
-float gs_audio_get_volume(gs_handle(gs_audio_instance_t) inst)
+// A stream has a single decode cursor, so whichever voice played it before is finished
+static void __gs_audio_stream_claim(gs_audio_i* audio, const gs_audio_command_t* cmd)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        return gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id)->volume;
+    for (uint32_t i = 0; i < audio->voice_count; ++i)
+    {
+        gs_audio_voice_t* v = &audio->voices[i];
+        if (v->src.stream == cmd->src.stream && v->inst != cmd->inst) {
+            v->finished = true;
+            v->playing = false;
+        }
     }
-    return 0.f;
 }
 
-void gs_audio_set_volume(gs_handle(gs_audio_instance_t) inst, float volume)
+// Pulls up to n frames out of a stream's ring (just skips them if out is NULL), fewer if the stream thread is behind
+static uint32_t __gs_audio_render_stream(gs_audio_voice_t* v, float* out, uint32_t n)
 {
-    if (__gs_audio_inst_valid(inst)) {
-        gs_slot_array_getp(gs_engine_subsystem(audio)->instances, inst.id)->volume = volume;
+    gs_audio_stream_t* st = v->src.stream;
+    const uint32_t capacity = GS_AUDIO_STREAM_BUFFER_FRAMES;
+    const uint32_t channels = (uint32_t)st->channels;
+    uint32_t serial = st->seek_serial;
+    if (gs_atomic_load_u32(&st->ready_serial) != serial) {
+        return 0;
+    }
+
+    // First read since the seek was serviced, drop everything decoded before it
+    if (st->read_serial != serial) {
+        st->read_serial = serial;
+        gs_atomic_store_u32(&st->read, st->flush_write);
     }
+
+    uint32_t count = gs_min(gs_atomic_load_u32(&st->write) - st->read, n);
+    if (out)
+    {
+        uint32_t offset = st->read & (capacity - 1);
+        uint32_t first = gs_min(count, capacity - offset);
+        __gs_audio_convert_s16(st->buffer + offset * channels, channels, first, out);
+        __gs_audio_convert_s16(st->buffer, channels, count - first, out + first * 2);
+    }
+    gs_atomic_store_u32(&st->read, st->read + count);
+    st->dirty |= (count > 0);
+
+    // The stream thread wraps to the start of the file when looping, so the position does too
+    double frame = v->sample_position / channels + (double)count;
+    v->sample_position = fmod(frame, (double)st->frame_count) * channels;
+
+    if (count < n && gs_atomic_load_u32(&st->end_serial) == serial && st->read == st->end_write) {
+        v->finished = true;
+        v->sample_position = 0;
+    }
+
+    return count;
 }
 
-/* Audio source data */
-gs_audio_source_t* gs_audio_get_source_data(gs_handle(gs_audio_source_t) src)
+// Points an ADPCM voice's cache at the two blocks around p, decoding what it doesn't hold yet, and trims count to the
+// frames whose filter taps fall inside that window
+static uint32_t __gs_audio_adpcm_window(gs_audio_voice_t* v, uint64_t p, uint64_t step, uint32_t count, int64_t* base, int64_t* frames)
 {
-    if (__gs_audio_src_valid(src)) {
-        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id);
+    const uint32_t channels = (uint32_t)v->src.channels;
+    const int64_t total = v->src.sample_count / v->src.channels;
+    const uint32_t blocks = (uint32_t)((total + GS_AUDIO_ADPCM_BLOCK_FRAMES - 1) / GS_AUDIO_ADPCM_BLOCK_FRAMES);
+    const uint32_t block = (uint32_t)(gs_max((int64_t)(p >> 32) - (__GS_AUDIO_RESAMPLE_HALF - 1), 0) / GS_AUDIO_ADPCM_BLOCK_FRAMES);
+    const uint32_t block_samples = GS_AUDIO_ADPCM_BLOCK_FRAMES * channels;
+    const uint8_t* data = (const uint8_t*)v->src.samples;
+
+    if (block != v->adpcm_block)
+    {
+        // Playing forward the second block is already decoded
+        uint32_t next = 0;
+        if (v->adpcm_block != UINT32_MAX && block == v->adpcm_block + 1) {
+            memcpy(v->adpcm_cache, v->adpcm_cache + block_samples, block_samples * sizeof(s16));
+            next = 1;
+        }
+        for (uint32_t i = next; i < 2; ++i)
+        {
+            s16* out = v->adpcm_cache + i * block_samples;
+            if (block + i < blocks) {
+                __gs_audio_adpcm_decode_block(data + (block + i) * channels * __GS_AUDIO_ADPCM_CHANNEL_BYTES, channels, out);
+            } else {
+                memset(out, 0, block_samples * sizeof(s16));
+            }
+        }
+        v->adpcm_block = block;
     }
-    return NULL;
+
+    *base = (int64_t)block * GS_AUDIO_ADPCM_BLOCK_FRAMES;
+    *frames = gs_min(2 * GS_AUDIO_ADPCM_BLOCK_FRAMES, total - *base);
+    if (*base + 2 * GS_AUDIO_ADPCM_BLOCK_FRAMES < total)
+    {
+        const uint64_t limit = (uint64_t)(*base + 2 * GS_AUDIO_ADPCM_BLOCK_FRAMES - __GS_AUDIO_RESAMPLE_HALF) << 32;
+        count = (uint32_t)gs_min((uint64_t)count, (limit - p + step - 1) / step);
+    }
+    return count;
 }
 
-void gs_audio_get_runtime(gs_handle(gs_audio_source_t) src, int32_t* minutes_out, int32_t* seconds_out)
+// Renders up to n stereo frames of a voice, fewer if a one-shot runs out
+static uint32_t __gs_audio_render_voice(gs_audio_voice_t* v, float* out, uint32_t n)
 {
-    if (__gs_audio_src_valid(src)) {
-        gs_audio_i* audio = gs_engine_subsystem(audio);
-        gs_audio_source_t* sp = gs_slot_array_getp(audio->sources, src.id);
-        if (sp)
-        {
-            // Calculate total length in seconds
-            float64_t total_seconds = ((float32_t)sp->sample_count / (float32_t)sp->sample_rate) / sp->channels;
-            int32_t seconds = (int32_t)(fmodf(total_seconds, 60.f));
-            int32_t minutes = (int32_t)(total_seconds / 60.f);  
+    if (v->src.stream) {
+        return __gs_audio_render_stream(v, out, n);
+    }
 
-            if (minutes_out) {
-                *minutes_out = minutes;
-            }
+    const uint32_t channels = (uint32_t)v->src.channels;
+    const int32_t last = __gs_audio_voice_end(v);
+    if (last <= 0) {
+        v->finished = true;
+        return 0;
+    }
 
-            if (seconds_out) {
-                *seconds_out = seconds;
+    const uint64_t end = (uint64_t)last << 32;
+    const uint64_t step = gs_max((uint64_t)(v->step * (double)v->doppler), 1);
+    uint64_t p = (uint64_t)(v->sample_position / channels * 4294967296.0);
+    uint32_t done = 0;
+
+    while (done < n)
+    {
+        if (p >= end)
+        {
+            if (!v->loop) {
+                v->finished = true;
+                p = 0;
+                break;
             }
+            p %= end;
         }
+
+        uint64_t avail = (end - p + step - 1) / step;
+        uint32_t count = (uint32_t)gs_min(avail, (uint64_t)(n - done));
+        if (v->src.format == GS_AUDIO_SAMPLE_FORMAT_ADPCM) {
+            int64_t base = 0, frames = 0;
+            count = __gs_audio_adpcm_window(v, p, step, count, &base, &frames);
+            __gs_audio_fetch(v->adpcm_cache, channels, frames, p - ((uint64_t)base << 32), step, v->high_quality, count, out + done * 2);
+        } else {
+            __gs_audio_fetch((const s16*)v->src.samples, channels, last + 1, p, step, v->high_quality, count, out + done * 2);
+        }
+        p += count * step;
+        done += count;
     }
+
+    v->sample_position = (double)p / 4294967296.0 * channels;
+    return done;
 }
 
-void gs_audio_convert_to_runtime(int32_t sample_count, int32_t sample_rate, int32_t num_channels, int32_t position, int32_t* minutes_out, int32_t* seconds_out)
+// Virtual voices keep their timeline so they resume in the right place once they're loud enough again
+static void __gs_audio_advance_virtual_voice(gs_audio_voice_t* v, uint32_t frame_count)
 {
-    // Calculate total length in seconds
-    float64_t frac = (float64_t)position / (float64_t)sample_count;
-    float64_t total_seconds = ((float64_t)sample_count / (float64_t)sample_rate) / num_channels;
-    total_seconds = total_seconds * frac;
-    int32_t seconds = (int32_t)(fmodf(total_seconds, 60.f));
-    int32_t minutes = (int32_t)(total_seconds / 60.f);  
-
-    if (minutes_out) {
-        *minutes_out = minutes;
+    if (v->src.stream) {
+        v->gain[0] = v->gain[1] = 0.f;
+        __gs_audio_render_stream(v, NULL, frame_count);
+        return;
     }
 
-    if (seconds_out) {
-        *seconds_out = seconds;
+    double end = (double)__gs_audio_voice_end(v);
+    double frame = v->sample_position / v->src.channels + (double)frame_count * ((double)v->step * v->doppler / 4294967296.0);
+    v->gain[0] = v->gain[1] = 0.f;     // Fade back in when it becomes audible again
+    if (frame >= end)
+    {
+        if (v->loop && end > 0.0) {
+            frame = fmod(frame, end);
+        } else {
+            v->finished = true;
+            frame = 0.0;
+        }
     }
+    v->sample_position = frame * v->src.channels;
 }
 
-int32_t gs_audio_get_sample_count(gs_handle(gs_audio_source_t) src)
+static float __gs_audio_attenuate(const gs_audio_emitter_t* e, float distance)
 {
-    if (__gs_audio_src_valid(src)) {
-        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id)->sample_count;
+    const float min = e->min_distance > 0.f ? e->min_distance : 1.f;
+    const float max = e->max_distance > 0.f ? gs_max(e->max_distance, min) : FLT_MAX;
+    const float rolloff = e->rolloff > 0.f ? e->rolloff : 1.f;
+    const float d = gs_clamp(distance, min, max);
+    switch (e->attenuation)
+    {
+        case GS_AUDIO_ATTENUATION_INVERSE:      return min / (min + rolloff * (d - min));
+        case GS_AUDIO_ATTENUATION_LINEAR:       return max > min && max < FLT_MAX ? gs_max(1.f - rolloff * (d - min) / (max - min), 0.f) : 1.f;
+        case GS_AUDIO_ATTENUATION_EXPONENTIAL:  return powf(d / min, -rolloff);
+        default:                                return 1.f;
     }
-    return 0;
 }
 
-int32_t gs_audio_get_sample_rate(gs_handle(gs_audio_source_t) src)
+// Target left/right gain and doppler factor for the coming callback, spatial voices are attenuated and equal power panned
+static void __gs_audio_spatialize_voice(const gs_audio_listener_t* l, gs_quat listener_inv, gs_audio_voice_t* v)
 {
-    if (__gs_audio_src_valid(src)) {
-        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id)->sample_rate;
+    v->doppler = 1.f;
+    if (!v->spatial) {
+        v->target[0] = v->target[1] = v->volume;
+        return;
+    }
+
+    const gs_audio_emitter_t* e = &v->emitter;
+    const float min = e->min_distance > 0.f ? e->min_distance : 1.f;
+    gs_vec3 to_source = gs_vec3_sub(e->position, l->transform.position);
+    float distance = gs_vec3_len(to_source);
+    float gain = v->volume * __gs_audio_attenuate(e, distance);
+
+    // Pulled towards the center within min_distance, so passing through the listener doesn't flip sides
+    gs_vec3 local = gs_quat_rotate(listener_inv, to_source);
+    float pan = gs_clamp(local.x / gs_max(distance, min), -1.f, 1.f);
+    float angle = (pan + 1.f) * (float)GS_PI * 0.25f;
+    v->target[0] = gain * cosf(angle);
+    v->target[1] = gain * sinf(angle);
+
+    // Streams are read 1:1 out of their ring buffer so they can't be pitched, they're only panned and attenuated
+    if (e->doppler > 0.f && distance > 1e-4f && !v->src.stream)
+    {
+        // Speeds along the source -> listener line, kept well short of the speed of sound
+        const float c = GS_AUDIO_SPEED_OF_SOUND;
+        gs_vec3 dir = gs_vec3_scale(to_source, -1.f / distance);
+        float vl = gs_clamp(gs_vec3_dot(l->velocity, dir) * e->doppler, -0.5f * c, 0.5f * c);
+        float vs = gs_clamp(gs_vec3_dot(e->velocity, dir) * e->doppler, -0.5f * c, 0.5f * c);
+        v->doppler = (c - vl) / (c - vs);
     }
-    return 0;
 }
 
-int32_t gs_audio_get_num_channels(gs_handle(gs_audio_source_t) src)
+#define __gs_audio_src_playable(SRC)\
+    ((SRC).samples || (SRC).stream)
+
+// Source frames per output frame in 32.32. Sources are converted to the device rate on load, so this is mostly pitch
+static uint64_t __gs_audio_voice_step(gs_audio_i* audio, const gs_audio_command_t* cmd)
 {
-    if (__gs_audio_src_valid(src)) {
-        return gs_slot_array_getp(gs_engine_subsystem(audio)->sources, src.id)->channels;
+    if (cmd->src.stream) {
+        return (uint64_t)1 << 32;
     }
-    return 0;
+    double ratio = cmd->decl.pitch > 0.f ? (double)cmd->decl.pitch : 1.0;
+    if (audio->samples_per_second && cmd->src.sample_rate > 0) {
+        ratio *= (double)cmd->src.sample_rate / (double)audio->samples_per_second;
+    }
+    return (uint64_t)(gs_clamp(ratio, 1.0 / 1024.0, 64.0) * 4294967296.0 + 0.5);
 }
 
-#undef GS_AUDIO_IMPL_DEFAULT
-#endif // GS_AUDIO_IMPL_DEFAULT
+// False leaves the command queued for the next callback
+static bool32_t __gs_audio_apply_command(gs_audio_i* audio, const gs_audio_command_t* cmd)
+{
+    gs_audio_voice_t* v = __gs_audio_find_voice(audio, cmd->inst);
 
-/*=============================
-// Miniaudio Impl
-=============================*/
+    switch (cmd->type)
+    {
+        case GS_AUDIO_COMMAND_PLAY:
+        {
+            if (cmd->src.stream) {
+                __gs_audio_stream_claim(audio, cmd);
+            }
 
-#ifdef GS_AUDIO_IMPL_MINIAUDIO
+            if (!v)
+            {
+                // No voice left or nothing to play, let the game thread know it never started. Retried like a
+                // finished voice if the event queue is full, or the instance would never be released
+                v = __gs_audio_src_playable(cmd->src) ? __gs_audio_alloc_voice(audio, cmd) : NULL;
+                if (!v) {
+                    if (!__gs_audio_push_event(audio, GS_AUDIO_EVENT_FINISHED, cmd->inst, cmd->play_id, cmd->decl.sample_position)) {
+                        return false;
+                    }
+                    gs_atomic_store_u32(&audio->voice_stats.rejected, audio->voice_stats.rejected + 1);
+                    break;
+                }
+                v->inst = cmd->inst;
+                v->sample_position = cmd->decl.sample_position;
+                v->gain[0] = v->gain[1] = -1.f;    // Snaps to the first target instead of fading in
+                v->target[0] = v->target[1] = cmd->decl.volume;
+                v->doppler = 1.f;
+
+                // Primed streams can start right away, anything else decodes from the requested frame first
+                gs_audio_stream_t* st = cmd->src.stream;
+                if (st && (st->dirty || v->sample_position > 0.0)) {
+                    __gs_audio_stream_request_seek(st, (uint32_t)(v->sample_position / st->channels));
+                }
+            }
+            if (cmd->src.stream) {
+                __gs_audio_stream_set_loop(cmd->src.stream, cmd->decl.loop, v->sample_position);
+            }
+            v->play_id = cmd->play_id;
+            v->src = cmd->src;
+            v->adpcm_block = UINT32_MAX;
+            v->step = __gs_audio_voice_step(audio, cmd);
+            v->high_quality = cmd->decl.high_quality;
+            v->volume = cmd->decl.volume;
+            v->priority = cmd->decl.priority;
+            v->loop = cmd->decl.loop;
+            v->persistent = cmd->decl.persistent;
+            v->spatial = cmd->decl.spatial;
+            v->emitter = cmd->decl.emitter;
+            v->bus = cmd->decl.bus;
+            v->playing = true;
+            v->finished = false;
+        } break;
+
+        case GS_AUDIO_COMMAND_PAUSE:
+        {
+            if (v) v->playing = false;
+        } break;
 
-#define MINIAUDIO_IMPLEMENTATION
-#include "../external/miniaudio/miniaudio.h"
+        case GS_AUDIO_COMMAND_STOP:
+        {
+            if (v) __gs_audio_release_voice(audio, v);
+        } break;
 
-typedef struct miniaudio_data_t
-{
-    ma_context context;
-    ma_device device;
-    ma_device_config device_config;
-    ma_mutex lock;
-} miniaudio_data_t;
+        case GS_AUDIO_COMMAND_RESTART:
+        {
+            if (!v) break;
+            v->play_id = cmd->play_id;
+            v->sample_position = 0;
+            if (v->src.stream) __gs_audio_stream_request_seek(v->src.stream, 0);
+        } break;
 
-void ma_audio_commit(ma_device* device, void* output, const void* input, ma_uint32 frame_count)
-{
-    gs_audio_i* audio = gs_engine_subsystem(audio);
-    miniaudio_data_t* ma = (miniaudio_data_t*)audio->user_data;
-    memset(output, 0, frame_count * device->playback.channels * ma_get_bytes_per_sample(device->playback.format));
+        case GS_AUDIO_COMMAND_SET_VOLUME:
+        {
+            if (v) v->volume = cmd->decl.volume;
+        } break;
 
-    // Only destroy 32 at a time
-    u32 destroy_count = 0;
-    gs_handle(gs_audio_instance_t) handles_to_destroy[32];
+        case GS_AUDIO_COMMAND_SET_DATA:
+        case GS_AUDIO_COMMAND_SEEK:
+        {
+            if (!v) break;
+            if (__gs_audio_src_playable(cmd->src)) {
+                v->src = cmd->src;
+                v->adpcm_block = UINT32_MAX;
+            }
+            v->step = __gs_audio_voice_step(audio, cmd);
+            v->high_quality = cmd->decl.high_quality;
+            v->volume = cmd->decl.volume;
+            v->priority = cmd->decl.priority;
+            v->loop = cmd->decl.loop;
+            v->persistent = cmd->decl.persistent;
+            v->spatial = cmd->decl.spatial;
+            v->emitter = cmd->decl.emitter;
+            v->bus = cmd->decl.bus;
+            v->playing = cmd->decl.playing;
+            if (cmd->type == GS_AUDIO_COMMAND_SEEK) {
+                v->sample_position = gs_clamp(cmd->decl.sample_position, 0.0, (double)gs_max(v->src.sample_count - v->src.channels - 1, 0));
+                if (v->src.stream) __gs_audio_stream_request_seek(v->src.stream, (uint32_t)(v->sample_position / v->src.channels));
+            }
+            if (v->src.stream) {
+                __gs_audio_stream_set_loop(v->src.stream, v->loop, v->sample_position);
+            }
+        } break;
 
-    if (!audio->instances) 
-        return;
+        case GS_AUDIO_COMMAND_SET_POSITION:
+        {
+            if (!v) break;
+            v->emitter.position = cmd->decl.emitter.position;
+            v->emitter.velocity = cmd->decl.emitter.velocity;
+        } break;
 
-    // Mutex not working for pushing samples back. Need to copy sample data OVER at a synced position.
-    // Add sample data into byte buffer to push back, but this has to be done to sync with audio
-    // thread so that it's consistent and smooth feeding.
-    ma_mutex_lock(&ma->lock);
-    {
-        for (u32 i = 0; i < gs_slot_array_size(audio->instances); ++i)
+        case GS_AUDIO_COMMAND_SET_LISTENER:
         {
-            gs_audio_instance_t* inst = &audio->instances->data[i];
+            audio->listener = cmd->listener;
+        } break;
 
-            // Get raw audio source from instance
-            gs_audio_source_t* src = gs_slot_array_getp(audio->sources, inst->src.id);
+        case GS_AUDIO_COMMAND_ADD_BUS:
+        {
+            miniaudio_data_t* ma = (miniaudio_data_t*)audio->user_data;
+            if (cmd->bus.id != ma->bus_count || ma->bus_count >= GS_AUDIO_MAX_BUSES) break;
+            __gs_audio_bus_state_t* bus = &ma->buses[ma->bus_count++];
+            memset(bus, 0, sizeof(__gs_audio_bus_state_t));
+            bus->parent = cmd->bus.parent;
+            bus->volume = bus->gain = cmd->bus.volume;
+        } break;
+
+        case GS_AUDIO_COMMAND_SET_BUS_VOLUME:
+        {
+            miniaudio_data_t* ma = (miniaudio_data_t*)audio->user_data;
+            if (cmd->bus.id < ma->bus_count) ma->buses[cmd->bus.id].volume = cmd->bus.volume;
+        } break;
 
-            // Easy out if the instance is not playing currently or the source is invalid
-            if (!inst->playing || !src) {
-                continue;
-            }
+        case GS_AUDIO_COMMAND_SET_BUS_EFFECT:
+        {
+            miniaudio_data_t* ma = (miniaudio_data_t*)audio->user_data;
+            if (cmd->bus.id >= ma->bus_count || cmd->bus.slot >= GS_AUDIO_MAX_BUS_EFFECTS) break;
+            __gs_audio_apply_effect(&ma->buses[cmd->bus.id].effects[cmd->bus.slot], &cmd->bus, 
+                (float)(audio->samples_per_second ? audio->samples_per_second : 44100));
+        } break;
+    }
+    return true;
+}
 
-            s16* sample_out = (s16*)output;
-            s16* samples = (s16*)src->samples;
+void ma_audio_commit(ma_device* device, void* output, const void* input, ma_uint32 frame_count)
+{
+    gs_audio_i* audio = gs_engine_subsystem(audio);
+    memset(output, 0, frame_count * device->playback.channels * ma_get_bytes_per_sample(device->playback.format));
 
-            u64 samples_to_write = (u64)frame_count;
-            f64 sample_volume = inst->volume;
+    if (!audio) 
+        return;
 
-            // Write to channels
-            for (u64 write_sample = 0; write_sample < samples_to_write; ++write_sample)
-            {
-                s32 channels = src->channels;
-                f64 start_sample_position = inst->sample_position;
-                s16 start_left_sample;
-                s16 start_right_sample;
+#if (defined GS_AUDIO_SIMD_SSE2)
+    // Effect feedback decays into denormals, which are orders of magnitude slower to process on x86
+    _mm_setcsr(_mm_getcsr() | 0x8040);
+#endif
 
-                // Not sure about this line of code...
-                f64 target_sample_position = start_sample_position + (f64)channels * (f64)1.f;
+    // Drain everything the game thread queued since the last callback, stopping early (in order) at a play whose
+    // rejection can't be reported yet
+    gs_audio_command_queue_t* cq = &audio->commands;
+    uint32_t cmd_write = gs_atomic_load_u32(&cq->write);
+    uint32_t cmd_read = cq->read;
+    for (; cmd_read != cmd_write; ++cmd_read) {
+        if (!__gs_audio_apply_command(audio, &cq->data[cmd_read & (GS_AUDIO_COMMAND_QUEUE_SIZE - 1)])) break;
+    }
+    gs_atomic_store_u32(&cq->read, cmd_read);
 
-                if (target_sample_position >= src->sample_count)
-                {
-                    target_sample_position -= src->sample_count;
-                }
+    // Gains only change between callbacks, so they're worked out once here and ramped to by the mix loop
+    gs_quat listener_inv = gs_quat_inverse(audio->listener.transform.rotation);
+    for (uint32_t i = 0; i < audio->voice_count; ++i)
+    {
+        gs_audio_voice_t* v = &audio->voices[i];
+        if (v->playing && !v->finished) {
+            __gs_audio_spatialize_voice(&audio->listener, listener_inv, v);
+        }
+    }
 
-                s16 target_left_sample;
-                s16 target_right_sample;
+    __gs_audio_virtualize_voices(audio);
 
-                {
-                    u64 left_idx = (u64)start_sample_position;
-                    if (channels > 1)
-                    {
-                        left_idx &= ~((u64)(0x01));
-                    }
-                    u64 right_idx = left_idx + (channels - 1);
+    miniaudio_data_t* ma = (miniaudio_data_t*)audio->user_data;
+    s16* out = (s16*)output;
 
-                    s16 first_left_sample = samples[left_idx];
-                    s16 first_right_sample = samples[right_idx];
-                    s16 second_left_sample = samples[left_idx + channels];
-                    s16 second_right_sample = samples[right_idx + channels];
+    for (uint32_t i = 0; i < audio->voice_count; ++i)
+    {
+        gs_audio_voice_t* v = &audio->voices[i];
+        if (v->playing && !v->finished && v->virtualized) {
+            __gs_audio_advance_virtual_voice(v, frame_count);
+        }
+    }
 
-                    start_left_sample = (s16)(first_left_sample + (second_left_sample - first_left_sample) * (start_sample_position / channels - (u64)(start_sample_position / channels)));
-                    start_right_sample = (s16)(first_right_sample + (second_right_sample - first_right_sample) * (start_sample_position / channels - (u64)(start_sample_position / channels)));
-                }
+    for (uint32_t offset = 0; offset < frame_count; offset += GS_AUDIO_MIX_BLOCK_FRAMES)
+    {
+        uint32_t n = gs_min(frame_count - offset, GS_AUDIO_MIX_BLOCK_FRAMES);
+        memset(ma->mix, 0, n * 2 * sizeof(float));
+        for (uint32_t b = 0; b < ma->bus_count; ++b) {
+            memset(ma->bus_mix[b], 0, n * 2 * sizeof(float));
+        }
 
-                {
-                    u64 left_index = (u64)target_sample_position;
-                    if(channels > 1)
-                    {
-                        left_index &= ~((u64)(0x01));
-                    }
-                    u64 right_index = left_index + (channels - 1);
-                    
-                    s16 first_left_sample = samples[left_index];
-                    s16 first_right_sample = samples[right_index];
-                    s16 second_left_sample = samples[left_index + channels];
-                    s16 second_right_sample = samples[right_index + channels];
-                    
-                    target_left_sample = (s16)(first_left_sample + (second_left_sample - first_left_sample) * (target_sample_position / channels - (u64)(target_sample_position / channels)));
-                    target_right_sample = (s16)(first_right_sample + (second_right_sample - first_right_sample) * (target_sample_position / channels - (u64)(target_sample_position / channels)));
-                }
+        for (uint32_t i = 0; i < audio->voice_count; ++i)
+        {
+            gs_audio_voice_t* v = &audio->voices[i];
+            if (!v->playing || v->finished || v->virtualized) continue;
 
-                s16 left_sample = (s16)((((s64)start_left_sample + (s64)target_left_sample) / 2) * sample_volume);
-                s16 right_sample = (s16)((((s64)start_right_sample + (s64)target_right_sample) / 2) * sample_volume);
+            uint32_t rendered = __gs_audio_render_voice(v, ma->voice, n);
+            if (v->gain[0] < 0.f) {
+                v->gain[0] = v->target[0];
+                v->gain[1] = v->target[1];
+            }
+            float* bus = ma->bus_count ? ma->bus_mix[v->bus < ma->bus_count ? v->bus : GS_AUDIO_BUS_MASTER] : ma->mix;
+            __gs_audio_mix_gain(bus, ma->voice, rendered, v->gain, v->target);
+            v->gain[0] = v->target[0];
+            v->gain[1] = v->target[1];
+        }
 
-                *sample_out++ += left_sample;  // Left
-                *sample_out++ += right_sample; // Right
+        __gs_audio_process_buses(audio, ma, n);
 
-                // Possibly need fixed sampling instead
-                inst->sample_position = target_sample_position;
+        __gs_audio_soft_clip_s16(ma->mix, out + offset * 2, n * 2);
+    }
 
-                // Loop sound if necessary
-                if(inst->sample_position >= src->sample_count - channels - 1)
-                {
-                    if(inst->loop)
-                    {
-                        // inst->sample_position -= src->sample_count;
-                        inst->sample_position = 0;
-                    }
-                    else
-                    {
-                        // Need to destroy the instance at this point...
-                        inst->playing = false;
-                        inst->sample_position = 0;
-                        break;
-                    }
-                }
+    for (uint32_t i = 0; i < audio->voice_count;)
+    {
+        gs_audio_voice_t* inst = &audio->voices[i];
 
+        // Finished voices are only released once the game thread is guaranteed to hear about it
+        if (inst->finished)
+        {
+            if (__gs_audio_push_event(audio, GS_AUDIO_EVENT_FINISHED, inst->inst, inst->play_id, 0.0)) {
+                __gs_audio_release_voice(audio, inst);
+                continue;
             }
         }
+        else if (inst->playing && inst->persistent &&
+            audio->events.write - gs_atomic_load_u32(&audio->events.read) < GS_AUDIO_EVENT_QUEUE_SIZE / 2)
+        {
+            // Best effort, a busy queue just means a slightly older position on the game thread. The other half is
+            // kept for finished events, which can't be dropped
+            __gs_audio_push_event(audio, GS_AUDIO_EVENT_POSITION, inst->inst, inst->play_id, inst->sample_position);
+        }
+
+        ++i;
     }
-    ma_mutex_unlock(&ma->lock);
 }
 
 gs_result gs_audio_init(gs_audio_i* audio)
@@ -532,7 +2487,7 @@ gs_result gs_audio_init(gs_audio_i* audio)
     config.capture.pDeviceID = NULL;  // NULL for the default capture AUDIO.System.device.
     config.capture.format = ma_format_s16;
     config.capture.channels = 1;
-    config.sampleRate = 44100;
+    config.sampleRate = GS_AUDIO_SAMPLE_RATE;
     config.dataCallback = &ma_audio_commit;
     config.pUserData = NULL;
 
@@ -542,6 +2497,9 @@ gs_result gs_audio_init(gs_audio_i* audio)
         gs_assert(false);
     }
 
+    // Sources loaded from here on are converted to whatever rate the device settled on
+    audio->samples_per_second = output->device.sampleRate;
+
     if ((ma_device_start(&output->device)) != MA_SUCCESS) {
         gs_assert(false);
     }
@@ -551,6 +2509,14 @@ gs_result gs_audio_init(gs_audio_i* audio)
 
 gs_result gs_audio_shutdown(gs_audio_i* audio)
 {
+    // Stop the device first so the callback can't run against freed queues
+    miniaudio_data_t* ma = (miniaudio_data_t*)audio->user_data;
+    if (ma)
+    {
+        ma_device_uninit(&ma->device);
+        gs_free(ma);
+        audio->user_data = NULL;
+    }
     return GS_RESULT_SUCCESS;
 }
 
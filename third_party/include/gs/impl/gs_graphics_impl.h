@@ -26,6 +26,14 @@ gs_graphics_info_t* gs_graphics_info()
 
 #ifdef GS_GRAPHICS_IMPL_OPENGL
 
+// S3TC isn't core, but is exposed by every desktop driver
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
 typedef enum gsgl_uniform_type
 {
     GSGL_UNIFORMTYPE_FLOAT,
@@ -89,6 +97,7 @@ typedef uint32_t gsgl_buffer_t;
 typedef struct gsgl_texture_t {
     uint32_t id;
     gs_graphics_texture_desc_t desc;
+    uint32_t base_level;            // Finest allocated level (streamed textures)
 } gsgl_texture_t;
 
 typedef struct gsgl_vertex_buffer_decl_t {
@@ -137,6 +146,7 @@ typedef enum gs_opengl_op_code_type
     GS_OPENGL_OP_SET_VIEW_SCISSOR,
     GS_OPENGL_OP_CLEAR,
     GS_OPENGL_OP_REQUEST_BUFFER_UPDATE,
+    GS_OPENGL_OP_REQUEST_TEXTURE_UPDATE,
     GS_OPENGL_OP_BIND_PIPELINE,
     GS_OPENGL_OP_APPLY_BINDINGS,
     GS_OPENGL_OP_DISPATCH_COMPUTE,
@@ -151,6 +161,18 @@ void gsgl_reset_data_cache(gsgl_data_cache_t* cache)
     gs_dyn_array_clear(cache->vdecls);
 }
 
+bool32_t gsgl_has_extension(const char* name)
+{
+    int32_t count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (int32_t i = 0; i < count; ++i)
+    {
+        const char* ext = (const char*)glGetStringi(GL_EXTENSIONS, (uint32_t)i);
+        if (ext && strcmp(ext, name) == 0) return true;
+    }
+    return false;
+}
+
 void gsgl_pipeline_state()
 {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -203,11 +225,144 @@ uint32_t gsgl_texture_format_to_gl_texture_format(gs_graphics_texture_format_typ
         case GS_GRAPHICS_TEXTURE_FORMAT_RGBA16F:            format = GL_RGBA16F;            break;
         case GS_GRAPHICS_TEXTURE_FORMAT_RGBA32F:            format = GL_RGBA32F;            break;
         case GS_GRAPHICS_TEXTURE_FORMAT_R8:                 format = GL_R8;                 break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC1:                format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;  break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC3:                format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;  break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC5:                format = GL_COMPRESSED_RG_RGTC2;            break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC7:                format = GL_COMPRESSED_RGBA_BPTC_UNORM;     break;
+        default:                                                                            break;
+    }
+    return format;
+}
+
+uint32_t gsgl_texture_format_to_gl_data_format(gs_graphics_texture_format_type type)
+{
+    uint32_t format = GL_RGBA;
+    switch (type)
+    {
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGB8:               format = GL_RGB;                break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_A8:                 format = GL_ALPHA;              break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_R8:                 format = GL_RED;                break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH8:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH16:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F:           format = GL_DEPTH_COMPONENT;    break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24_STENCIL8:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F_STENCIL8:  format = GL_DEPTH_STENCIL;      break;
         default:                                                                            break;
     }
     return format;
 }
 
+uint32_t gsgl_texture_format_to_gl_data_type(gs_graphics_texture_format_type type)
+{
+    uint32_t dtype = GL_UNSIGNED_BYTE;
+    switch (type)
+    {
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA16F:
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA32F:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH8:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH16:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24:
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F:           dtype = GL_FLOAT;                           break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24_STENCIL8:   dtype = GL_UNSIGNED_INT_24_8;               break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F_STENCIL8:  dtype = GL_FLOAT_32_UNSIGNED_INT_24_8_REV;  break;
+        default:                                                                                        break;
+    }
+    return dtype;
+}
+
+// Size of one pixel of client data, as uploaded (float formats are uploaded as 32 bit floats)
+uint32_t gsgl_texture_format_size_in_bytes(gs_graphics_texture_format_type type)
+{
+    uint32_t sz = 4;
+    switch (type)
+    {
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGB8:               sz = 3;     break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA16F:
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA32F:            sz = 16;    break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_A8:
+        case GS_GRAPHICS_TEXTURE_FORMAT_R8:                 sz = 1;     break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F_STENCIL8:  sz = 8;     break;
+        default:                                                        break;
+    }
+    return sz;
+}
+
+bool32_t gs_graphics_texture_format_is_compressed(gs_graphics_texture_format_type format)
+{
+    switch (format)
+    {
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC1:
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC3:
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC5:
+        case GS_GRAPHICS_TEXTURE_FORMAT_BC7:    return true;
+        default:                                return false;
+    }
+}
+
+size_t gs_graphics_texture_level_size(gs_graphics_texture_format_type format, uint32_t width, uint32_t height)
+{
+    if (gs_graphics_texture_format_is_compressed(format)) {
+        // Partial blocks at the edges still occupy a full 4x4 block
+        size_t block_sz = format == GS_GRAPHICS_TEXTURE_FORMAT_BC1 ? 8 : 16;
+        return (size_t)((width + 3) / 4) * (size_t)((height + 3) / 4) * block_sz;
+    }
+    return (size_t)width * (size_t)height * (size_t)gsgl_texture_format_size_in_bytes(format);
+}
+
+// Allocate and upload a single level of currently bound texture (data can be null)
+void gsgl_texture_upload_level(gs_graphics_texture_format_type format, uint32_t level, uint32_t width, uint32_t height, const void* data)
+{
+    if (gs_graphics_texture_format_is_compressed(format)) {
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, gsgl_texture_format_to_gl_texture_format(format), width, height, 0, 
+            (GLsizei)gs_graphics_texture_level_size(format, width, height), data);
+        return;
+    }
+
+    switch(format) 
+    {
+        case GS_GRAPHICS_TEXTURE_FORMAT_A8:                 glTexImage2D(GL_TEXTURE_2D, level, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_R8:                 glTexImage2D(GL_TEXTURE_2D, level, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGB8:               glTexImage2D(GL_TEXTURE_2D, level, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA8:              glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA16F:            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA32F:            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH8:             glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH16:            glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH_COMPONENT16, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;              
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24:            glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F:           glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH_COMPONENT32F, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24_STENCIL8:   glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, data); break;
+        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F_STENCIL8:  glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH32F_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, data); break;
+
+        // NOTE(john): Because Apple is a shit company, I have to section this off and provide support for 4.1 only features.
+        // case GS_GRAPHICS_TEXTURE_FORMAT_STENCIL8:            glTexImage2D(GL_TEXTURE_2D, level, GL_DEPTH_COMPONENT8, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
+        default: break;
+    }
+}
+
+// Upload region of texture (texture must already be allocated at full size)
+void gsgl_texture_update_region(gsgl_texture_t* tex, uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void* data)
+{
+    const gs_graphics_texture_format_type format = tex->desc.format;
+    glBindTexture(GL_TEXTURE_2D, tex->id);
+    if (gs_graphics_texture_format_is_compressed(format)) {
+        // Region must be block aligned, level 0 only (prebuilt mips aren't regenerated)
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, gsgl_texture_format_to_gl_texture_format(format), 
+            (GLsizei)gs_graphics_texture_level_size(format, w, h), data);
+    }
+    else {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, gsgl_texture_format_to_gl_data_format(format), 
+            gsgl_texture_format_to_gl_data_type(format), data);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        // Whole chain (generated or prebuilt) is rebuilt on the gpu once level 0 changes
+        if (tex->desc.num_mips) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 uint32_t gsgl_shader_stage_to_gl_stage(gs_graphics_shader_stage_type type)
 {
     uint32_t stage = GL_VERTEX_SHADER;
@@ -387,6 +542,11 @@ size_t gsgl_get_byte_size_of_vertex_attribute(gs_graphics_vertex_attribute_type
         case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE3:    { byte_size = sizeof(uint8_t) * 3; } break;
         case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE2:    { byte_size = sizeof(uint8_t) * 2; } break;
         case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE:     { byte_size = sizeof(uint8_t) * 1; } break;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF4:    { byte_size = sizeof(uint16_t) * 4; } break;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF2:    { byte_size = sizeof(uint16_t) * 2; } break;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT4N:  { byte_size = sizeof(int16_t) * 4; } break;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT2N:  { byte_size = sizeof(int16_t) * 2; } break;
+        case GS_GRAPHICS_VERTEX_ATTRIBUTE_INT_10_10_10_2N: { byte_size = sizeof(uint32_t); } break;
     } 
 
     return byte_size;
@@ -540,6 +700,19 @@ gs_result gs_graphics_init(gs_graphics_i* graphics)
         glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, (int32_t*)&info->compute.max_work_group_invocations);
     }
 
+    // Anisotropic filtering (core in 4.6, ext everywhere else, 0 when unsupported)
+    info->max_anisotropy = 0.f;
+    if ((info->major_version > 4 || (info->major_version == 4 && info->minor_version >= 6)) ||
+        gsgl_has_extension("GL_ARB_texture_filter_anisotropic") ||
+        gsgl_has_extension("GL_EXT_texture_filter_anisotropic"))
+    {
+        glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &info->max_anisotropy);
+
+        // Drivers that advertise it and then reject the query still shouldn't leave an error behind, bounded
+        // since a lost context keeps reporting one
+        for (uint32_t i = 0; i < 8 && glGetError() != GL_NO_ERROR; ++i);
+    }
+
     return GS_RESULT_SUCCESS;
 }
 
@@ -564,38 +737,41 @@ gs_handle(gs_graphics_texture_t) gs_graphics_texture_create(gs_graphics_texture_
     glGenTextures(1, &tex.id);
     glBindTexture(GL_TEXTURE_2D, tex.id);
 
+    // Upload prebuilt mip chain, if provided (stops at first missing level)
+    uint32_t prebuilt_mips = 0;
+    while (prebuilt_mips < GS_GRAPHICS_TEXTURE_MAX_MIPS && desc->mip_data[prebuilt_mips]) prebuilt_mips++;
+
+    // Levels finer than base level are left unallocated until made resident
+    tex.base_level = gs_min(desc->base_level, prebuilt_mips);
+
     // Construct texture based on appropriate format
-    switch(desc->format) 
-    {
-        case GS_GRAPHICS_TEXTURE_FORMAT_A8:                 glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_R8:                 glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_RGB8:               glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA8:              glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA16F:            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_RGBA32F:            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH8:             glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH16:            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT16, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;              
-        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24:            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F:           glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
-        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH24_STENCIL8:   glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, data);
-        case GS_GRAPHICS_TEXTURE_FORMAT_DEPTH32F_STENCIL8:  glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH32F_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_FLOAT_32_UNSIGNED_INT_24_8_REV, data); break;
+    for (uint32_t i = tex.base_level; i <= prebuilt_mips; ++i) {
+        uint32_t mw = gs_max(width >> i, 1);
+        uint32_t mh = gs_max(height >> i, 1);
+        gsgl_texture_upload_level(desc->format, i, mw, mh, i ? desc->mip_data[i - 1] : data);
+    }
 
-        // NOTE(john): Because Apple is a shit company, I have to section this off and provide support for 4.1 only features.
-        // case GS_GRAPHICS_TEXTURE_FORMAT_STENCIL8:            glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT8, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, data); break;
-        default: break;
+    // Clamp sampling to the levels that actually exist (num_mips is a count of levels below base)
+    uint32_t max_level = prebuilt_mips;
+    if (!prebuilt_mips && desc->num_mips) {
+        uint32_t full_chain = 0;
+        while ((width >> (full_chain + 1)) || (height >> (full_chain + 1))) full_chain++;
+        max_level = gs_min(desc->num_mips, full_chain);
     }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, tex.base_level);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, max_level);
 
     int32_t mag_filter = desc->mag_filter == GS_GRAPHICS_TEXTURE_FILTER_NEAREST ? GL_NEAREST : GL_LINEAR;
     int32_t min_filter = desc->min_filter == GS_GRAPHICS_TEXTURE_FILTER_NEAREST ? GL_NEAREST : GL_LINEAR;
 
-    if (desc->num_mips) {
+    if (desc->num_mips || prebuilt_mips) {
         if (desc->min_filter == GS_GRAPHICS_TEXTURE_FILTER_NEAREST) {
             min_filter = desc->mip_filter == GS_GRAPHICS_TEXTURE_FILTER_NEAREST ? GL_NEAREST_MIPMAP_NEAREST : 
                 GL_NEAREST_MIPMAP_LINEAR;
         } 
         else {
             min_filter = desc->mip_filter == GS_GRAPHICS_TEXTURE_FILTER_NEAREST ? GL_LINEAR_MIPMAP_NEAREST : 
-                GL_NEAREST_MIPMAP_LINEAR;
+                GL_LINEAR_MIPMAP_LINEAR;
         }
     }
 
@@ -608,13 +784,15 @@ gs_handle(gs_graphics_texture_t) gs_graphics_texture_create(gs_graphics_texture_
                          desc->wrap_t == GS_GRAPHICS_TEXTURE_WRAP_CLAMP_TO_EDGE ? GL_CLAMP_TO_EDGE : 
                          GL_CLAMP_TO_BORDER;
 
-    if (desc->num_mips) {
+    // Compressed data can't be regenerated on the gpu, so those rely on prebuilt levels only
+    if (desc->num_mips && !prebuilt_mips && !gs_graphics_texture_format_is_compressed(desc->format)) {
         glGenerateMipmap(GL_TEXTURE_2D);
     }
 
-    // float aniso = 0.0f;
-    // glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &aniso);
-    // glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, aniso); 
+    if (desc->max_anisotropy > 1.f && gs_engine_subsystem(graphics)->info.max_anisotropy > 1.f) {
+        float aniso = gs_min(desc->max_anisotropy, gs_engine_subsystem(graphics)->info.max_anisotropy);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, aniso); 
+    }
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, texture_wrap_s);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, texture_wrap_t);
@@ -625,8 +803,9 @@ gs_handle(gs_graphics_texture_t) gs_graphics_texture_create(gs_graphics_texture_
     glBindTexture(GL_TEXTURE_2D, 0);
     glBindRenderbuffer(GL_RENDERBUFFER, 0);
 
-    // Set description
+    // Set description (level pointers are only valid for the duration of the call)
     tex.desc = *desc;
+    memset(tex.desc.mip_data, 0, sizeof(tex.desc.mip_data));
 
     // Add texture to internal resource pool and return handle
     return (gs_handle_create(gs_graphics_texture_t, gs_slot_array_insert(ogl->textures, tex)));
@@ -933,6 +1112,32 @@ gs_handle(gs_graphics_pipeline_t) gs_graphics_pipeline_create(gs_graphics_pipeli
 /* Resource Destruction */
 void gs_graphics_texture_destroy(gs_handle(gs_graphics_texture_t) hndl)
 {
+    gsgl_data_t* ogl = (gsgl_data_t*)gs_engine_subsystem(graphics)->user_data;
+    if (!hndl.id || !gs_slot_array_handle_valid(ogl->textures, hndl.id)) return;
+
+    gsgl_texture_t* tex = gs_slot_array_getp(ogl->textures, hndl.id);
+    glDeleteTextures(1, &tex->id);
+    gs_slot_array_erase(ogl->textures, hndl.id);
+}
+
+void gs_graphics_vertex_buffer_destroy(gs_handle(gs_graphics_vertex_buffer_t) hndl)
+{
+    gsgl_data_t* ogl = (gsgl_data_t*)gs_engine_subsystem(graphics)->user_data;
+    if (!hndl.id || !gs_slot_array_handle_valid(ogl->vertex_buffers, hndl.id)) return;
+
+    gsgl_buffer_t buffer = gs_slot_array_get(ogl->vertex_buffers, hndl.id);
+    glDeleteBuffers(1, &buffer);
+    gs_slot_array_erase(ogl->vertex_buffers, hndl.id);
+}
+
+void gs_graphics_index_buffer_destroy(gs_handle(gs_graphics_index_buffer_t) hndl)
+{
+    gsgl_data_t* ogl = (gsgl_data_t*)gs_engine_subsystem(graphics)->user_data;
+    if (!hndl.id || !gs_slot_array_handle_valid(ogl->index_buffers, hndl.id)) return;
+
+    gsgl_buffer_t buffer = gs_slot_array_get(ogl->index_buffers, hndl.id);
+    glDeleteBuffers(1, &buffer);
+    gs_slot_array_erase(ogl->index_buffers, hndl.id);
 }
 
 // void gs_graphics_buffer_destroy(gs_handle(gs_graphics_buffer_t) hndl)
@@ -954,6 +1159,43 @@ void gs_graphics_pipeline_destroy(gs_handle(gs_graphics_pipeline_t) hndl)
 /* Resource Update*/
 void gs_graphics_texture_update(gs_handle(gs_graphics_texture_t) hndl, gs_graphics_texture_desc_t* desc)
 {
+    gsgl_data_t* ogl = (gsgl_data_t*)gs_engine_subsystem(graphics)->user_data;
+
+    // Return if handle or data not valid
+    if (!hndl.id || !desc->data) return;
+
+    gsgl_texture_t* tex = gs_slot_array_getp(ogl->textures, hndl.id);
+    uint32_t w = desc->update.width ? desc->update.width : tex->desc.width;
+    uint32_t h = desc->update.height ? desc->update.height : tex->desc.height;
+    gsgl_texture_update_region(tex, desc->update.x, desc->update.y, w, h, desc->data);
+}
+
+void gs_graphics_texture_set_base_level(gs_handle(gs_graphics_texture_t) hndl, uint32_t base_level, const gs_graphics_texture_desc_t* levels)
+{
+    gsgl_data_t* ogl = (gsgl_data_t*)gs_engine_subsystem(graphics)->user_data;
+    if (!hndl.id || !gs_slot_array_handle_valid(ogl->textures, hndl.id)) return;
+
+    gsgl_texture_t* tex = gs_slot_array_getp(ogl->textures, hndl.id);
+    const gs_graphics_texture_format_type format = tex->desc.format;
+    const uint32_t w = tex->desc.width, h = tex->desc.height;
+
+    glBindTexture(GL_TEXTURE_2D, tex->id);
+
+    // Upload newly resident levels before sampling can reach them
+    for (uint32_t l = base_level; l < tex->base_level; ++l) {
+        const void* data = levels ? (l ? levels->mip_data[l - 1] : levels->data) : NULL;
+        gsgl_texture_upload_level(format, l, gs_max(w >> l, 1), gs_max(h >> l, 1), data);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, base_level);
+
+    // Evicted levels give their storage back (zero sized level)
+    for (uint32_t l = tex->base_level; l < base_level; ++l) {
+        gsgl_texture_upload_level(format, l, 0, 0, NULL);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    tex->base_level = base_level;
 }
 
 // void gs_graphics_buffer_update(gs_handle(gs_graphics_buffer_t) hndl, gs_graphics_buffer_desc_t* desc)
@@ -1016,6 +1258,23 @@ void gs_graphics_set_view_scissor(gs_command_buffer_t* cb, uint32_t x, uint32_t
 
 void gs_graphics_texture_request_update(gs_command_buffer_t* cb, gs_handle(gs_graphics_texture_t) hndl, gs_graphics_texture_desc_t* desc)
 {
+    // Return if handle or data not valid
+    if (!hndl.id || !desc->data) return;
+
+    // Region defaults to full texture, desc must describe the texture's format and size
+    uint32_t w = desc->update.width ? desc->update.width : desc->width;
+    uint32_t h = desc->update.height ? desc->update.height : desc->height;
+    size_t sz = gs_graphics_texture_level_size(desc->format, w, h);
+
+    __ogl_push_command(cb, GS_OPENGL_OP_REQUEST_TEXTURE_UPDATE, {
+        gs_byte_buffer_write(&cb->commands, uint32_t, hndl.id);
+        gs_byte_buffer_write(&cb->commands, uint32_t, desc->update.x);
+        gs_byte_buffer_write(&cb->commands, uint32_t, desc->update.y);
+        gs_byte_buffer_write(&cb->commands, uint32_t, w);
+        gs_byte_buffer_write(&cb->commands, uint32_t, h);
+        gs_byte_buffer_write(&cb->commands, size_t, sz);
+        gs_byte_buffer_write_bulk(&cb->commands, desc->data, sz);
+    });
 }
 
 void __gs_graphics_update_buffer_internal(gs_command_buffer_t* cb, 
@@ -1795,6 +2054,11 @@ void gs_graphics_submit_command_buffer(gs_command_buffer_t* cb)
                         case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE2:  glVertexAttribPointer(i, 2, GL_UNSIGNED_BYTE, GL_TRUE, stride, gs_int2voidp(offset)); break;
                         case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE3:  glVertexAttribPointer(i, 3, GL_UNSIGNED_BYTE, GL_TRUE, stride, gs_int2voidp(offset)); break;
                         case GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE4:  glVertexAttribPointer(i, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, gs_int2voidp(offset)); break;
+                        case GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF4:  glVertexAttribPointer(i, 4, GL_HALF_FLOAT, GL_FALSE, stride, gs_int2voidp(offset)); break;
+                        case GS_GRAPHICS_VERTEX_ATTRIBUTE_HALF2:  glVertexAttribPointer(i, 2, GL_HALF_FLOAT, GL_FALSE, stride, gs_int2voidp(offset)); break;
+                        case GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT4N: glVertexAttribPointer(i, 4, GL_SHORT, GL_TRUE, stride, gs_int2voidp(offset)); break;
+                        case GS_GRAPHICS_VERTEX_ATTRIBUTE_SHORT2N: glVertexAttribPointer(i, 2, GL_SHORT, GL_TRUE, stride, gs_int2voidp(offset)); break;
+                        case GS_GRAPHICS_VERTEX_ATTRIBUTE_INT_10_10_10_2N: glVertexAttribPointer(i, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, gs_int2voidp(offset)); break;
 
                         // Shouldn't get here
                         default: {
@@ -1917,6 +2181,25 @@ void gs_graphics_submit_command_buffer(gs_command_buffer_t* cb)
 
             } break;
 
+            case GS_OPENGL_OP_REQUEST_TEXTURE_UPDATE:
+            {
+                gsgl_data_t* ogl = (gsgl_data_t*)gs_engine_subsystem(graphics)->user_data;
+
+                gs_byte_buffer_readc(&cb->commands, uint32_t, id);
+                gs_byte_buffer_readc(&cb->commands, uint32_t, x);
+                gs_byte_buffer_readc(&cb->commands, uint32_t, y);
+                gs_byte_buffer_readc(&cb->commands, uint32_t, w);
+                gs_byte_buffer_readc(&cb->commands, uint32_t, h);
+                gs_byte_buffer_readc(&cb->commands, size_t, sz);
+
+                gsgl_texture_t* tex = gs_slot_array_getp(ogl->textures, id);
+                gsgl_texture_update_region(tex, x, y, w, h, (cb->commands.data + cb->commands.position));
+
+                // Advance past data
+                gs_byte_buffer_advance_position(&cb->commands, sz);
+
+            } break;
+
             default:
             {
                 // Op code not supported yet!
@@ -25,6 +25,9 @@
 
 #if !( defined GS_PLATFORM_WIN )
     #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
 #endif
 
 /*== Platform Window ==*/
@@ -37,6 +40,8 @@ gs_platform_i* gs_platform_create()
     // Initialize windows
     platform->windows = gs_slot_array_new(void*);
 
+    platform->pak_lock = gs_platform_mutex_create();
+
     // Set up video mode (for now, just do opengl)
     platform->settings.video.driver = GS_PLATFORM_VIDEO_DRIVER_TYPE_OPENGL;
 
@@ -50,6 +55,12 @@ void gs_platform_destroy(gs_platform_i* platform)
     // Free all resources
     gs_slot_array_free(platform->windows);
 
+    for (uint32_t i = 0; i < gs_dyn_array_size(platform->paks); ++i) {
+        gs_pak_close(&platform->paks[i]);
+    }
+    gs_dyn_array_free(platform->paks);
+    gs_platform_mutex_destroy(platform->pak_lock);
+
     // Free platform
     gs_free(platform);
     platform = NULL;
@@ -76,6 +87,43 @@ float gs_platform_delta_time()
     return (float)gs_engine_subsystem(platform)->time.delta;
 }
 
+float gs_platform_fixed_delta_time()
+{
+    return (float)gs_engine_subsystem(platform)->time.fixed_delta;
+}
+
+float gs_platform_interpolation_alpha()
+{
+    return (float)gs_engine_subsystem(platform)->time.alpha;
+}
+
+const gs_platform_frame_stats_t* gs_platform_frame_stats()
+{
+    return &gs_engine_subsystem(platform)->time.stats;
+}
+
+void gs_platform_frame_stats_reset()
+{
+    memset(&gs_engine_subsystem(platform)->time.stats, 0, sizeof(gs_platform_frame_stats_t));
+}
+
+double gs_platform_frame_stats_percentile(float p)
+{
+    const gs_platform_frame_stats_t* s = gs_platform_frame_stats();
+    if (!s->count) return 0.0;
+
+    // Upper edge of the bucket the percentile falls in, exact max for the overflow bucket
+    uint64_t rank = (uint64_t)ceil((f64)gs_clamp(p, 0.f, 100.f) / 100.0 * (f64)s->count);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < GS_PLATFORM_FRAME_HISTOGRAM_BUCKETS - 1; ++i)
+    {
+        seen += s->histogram[i];
+        if (seen >= rank && seen) return gs_min((f64)(i + 1) * GS_PLATFORM_FRAME_HISTOGRAM_BUCKET_MS, s->max);
+    }
+
+    return s->max;
+}
+
 /*== Platform UUID ==*/
 
 struct gs_uuid_t gs_platform_generate_uuid()
@@ -395,7 +443,152 @@ gs_result gs_platform_write_file_contents(const char* file_path, const char* mod
 
 bool gs_platform_file_exists(const char* file_path)
 {
-    return (gs_util_file_exists(file_path));
+    gs_platform_i* platform = gs_engine_instance() ? gs_engine_subsystem(platform) : NULL;
+    bool found = false;
+    if (platform) 
+    {
+        gs_platform_mutex_lock(platform->pak_lock);
+        for (uint32_t i = 0; i < gs_dyn_array_size(platform->paks) && !found; ++i) {
+            found = gs_pak_find(&platform->paks[i], file_path) != NULL;
+        }
+        gs_platform_mutex_unlock(platform->pak_lock);
+    }
+
+    return (found || gs_util_file_exists(file_path));
+}
+
+void* gs_platform_file_map(const char* file_path, size_t* sz)
+{
+    void* data = NULL;
+    *sz = 0;
+
+    #ifdef GS_PLATFORM_WIN
+
+        HANDLE file = CreateFileA(file_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return NULL;
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        {
+            // View keeps the mapping alive, so both handles can be closed right away
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping) {
+                data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (data) *sz = (size_t)size.QuadPart;
+            }
+        }
+        CloseHandle(file);
+
+    #else
+
+        int fd = open(file_path, O_RDONLY);
+        if (fd < 0) return NULL;
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) data = NULL;
+            else *sz = (size_t)st.st_size;
+        }
+        close(fd);
+
+    #endif
+
+    return data;
+}
+
+void gs_platform_file_unmap(void* data, size_t sz)
+{
+    if (!data) return;
+
+    #ifdef GS_PLATFORM_WIN
+        UnmapViewOfFile(data);
+    #else
+        munmap(data, sz);
+    #endif
+}
+
+bool32_t gs_platform_mount_pak(const char* pak_path)
+{
+    gs_platform_i* platform = gs_engine_subsystem(platform);
+    gs_pak_t pak = gs_default_val();
+    if (!gs_pak_open(&pak, pak_path)) return false;
+    gs_platform_mutex_lock(platform->pak_lock);
+    gs_dyn_array_push(platform->paks, pak);
+    gs_platform_mutex_unlock(platform->pak_lock);
+    return true;
+}
+
+void gs_platform_unmount_paks()
+{
+    gs_platform_i* platform = gs_engine_subsystem(platform);
+    gs_platform_mutex_lock(platform->pak_lock);
+    for (uint32_t i = 0; i < gs_dyn_array_size(platform->paks); ++i) {
+        gs_pak_close(&platform->paks[i]);
+    }
+    gs_dyn_array_clear(platform->paks);
+    gs_platform_mutex_unlock(platform->pak_lock);
+}
+
+// Looks file up in mounted paks, newest first (later mounts override earlier ones)
+bool32_t __gs_platform_pak_view_open(const char* file_path, gs_platform_file_view_t* view, bool32_t* found)
+{
+    gs_platform_i* platform = gs_engine_instance() ? gs_engine_subsystem(platform) : NULL;
+    bool32_t result = false;
+    *found = false;
+    if (!platform) return false;
+
+    gs_platform_mutex_lock(platform->pak_lock);
+    for (int32_t i = (int32_t)gs_dyn_array_size(platform->paks) - 1; i >= 0 && !*found; --i) 
+    {
+        const gs_pak_entry_t* entry = gs_pak_find(&platform->paks[i], file_path);
+        if (entry) {
+            *found = true;
+            result = gs_pak_read(&platform->paks[i], entry, view);
+        }
+    }
+    gs_platform_mutex_unlock(platform->pak_lock);
+    return result;
+}
+
+bool32_t gs_platform_file_view_open(const char* file_path, gs_platform_file_view_t* view)
+{
+    memset(view, 0, sizeof(gs_platform_file_view_t));
+
+    bool32_t in_pak = false;
+    bool32_t result = __gs_platform_pak_view_open(file_path, view, &in_pak);
+    if (in_pak) return result;
+
+    int32_t sz = 0;
+    char* data = gs_platform_read_file_contents(file_path, "rb", &sz);
+    if (!data) return false;
+
+    view->data = data;
+    view->alloc = data;
+    view->size = (size_t)sz;
+    return true;
+}
+
+bool32_t gs_platform_file_view_open_mapped(const char* file_path, gs_platform_file_view_t* view)
+{
+    memset(view, 0, sizeof(gs_platform_file_view_t));
+
+    bool32_t in_pak = false;
+    bool32_t result = __gs_platform_pak_view_open(file_path, view, &in_pak);
+    if (in_pak) return result;
+
+    view->map = gs_platform_file_map(file_path, &view->size);
+    view->data = view->map;
+    return (view->map != NULL);
+}
+
+void gs_platform_file_view_close(gs_platform_file_view_t* view)
+{
+    if (view->alloc) gs_free(view->alloc);
+    if (view->map) gs_platform_file_unmap(view->map, view->size);
+    memset(view, 0, sizeof(gs_platform_file_view_t));
 }
 
 int32_t gs_platform_file_size_in_bytes(const char* file_path)
@@ -451,8 +644,9 @@ void gs_platform_file_extension(char* buffer, size_t buffer_sz, const char* file
 
     #include <sched.h>
     #include <unistd.h>
+    #include <pthread.h>
 
-#elif (defined GS_PLATFORM_WINDOWS)
+#elif (defined GS_PLATFORM_WIN)
 
     #include <windows.h>
 
@@ -470,6 +664,30 @@ void __glfw_drop_callback(GLFWwindow* window);
 #define __glfw_window_from_handle(platform, handle)\
     ((GLFWwindow*)(gs_slot_array_get((platform)->windows, (handle))))
 
+#if (defined GS_PLATFORM_WIN)
+
+// Sleep() rounds up to the scheduler tick (15.6ms by default), which the frame pacer can't work with.
+// winmm is loaded at runtime so apps don't have to add it to their link line.
+typedef UINT (WINAPI* __gs_platform_time_period_fn)(UINT);
+static HMODULE __gs_platform_winmm = NULL;
+
+static void __gs_platform_timer_resolution(bool32_t begin)
+{
+    if (begin && !__gs_platform_winmm) __gs_platform_winmm = LoadLibraryA("winmm.dll");
+    if (!__gs_platform_winmm) return;
+
+    __gs_platform_time_period_fn fn = (__gs_platform_time_period_fn)(void*)GetProcAddress(__gs_platform_winmm,
+        begin ? "timeBeginPeriod" : "timeEndPeriod");
+    if (fn) fn(1);
+
+    if (!begin) {
+        FreeLibrary(__gs_platform_winmm);
+        __gs_platform_winmm = NULL;
+    }
+}
+
+#endif
+
 /*== Platform Init / Shutdown == */
 
 gs_result gs_platform_init(gs_platform_i* pf)
@@ -479,6 +697,10 @@ gs_result gs_platform_init(gs_platform_i* pf)
     gs_println("Initializing GLFW");
     glfwInit();
 
+    #if (defined GS_PLATFORM_WIN)
+        __gs_platform_timer_resolution(true);
+    #endif
+
     switch (pf->settings.video.driver)
     {
         case GS_PLATFORM_VIDEO_DRIVER_TYPE_OPENGL:
@@ -540,6 +762,10 @@ gs_result gs_platform_shutdown(gs_platform_i* pf)
 
     // glfwTerminate();
 
+    #if (defined GS_PLATFORM_WIN)
+        __gs_platform_timer_resolution(false);
+    #endif
+
     return GS_RESULT_SUCCESS;
 }
 
@@ -884,28 +1110,270 @@ gs_result gs_platform_process_input(gs_platform_input_t* input)
 
 void  gs_platform_sleep(float ms)
 {
+    if (ms <= 0.f) return;
+
     #if (defined GS_PLATFORM_WIN)
 
             Sleep((uint64_t)ms);
 
-    #elif (defined GS_PLATFORM_APPLE)
-
-            usleep(ms * 1000.f); // unistd.h
     #else
-            usleep(ms * 1000.f); // unistd.h
+
+            struct timespec ts = {0};
+            ts.tv_sec = (time_t)(ms / 1000.f);
+            ts.tv_nsec = (long)((ms - (float)ts.tv_sec * 1000.f) * 1000000.f);
+
+        #if (defined GS_PLATFORM_APPLE)
+            nanosleep(&ts, NULL);
+        #else
+            clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, NULL);
+        #endif
+
     #endif
 }
 
+void gs_platform_sleep_until(double ms)
+{
+    // Scheduler wake up is only good to around a millisecond, so leave the tail to a spin
+    double remaining = ms - gs_platform_elapsed_time();
+    if (remaining > GS_PLATFORM_PACER_SPIN_MS)
+    {
+        gs_platform_sleep((float)(remaining - GS_PLATFORM_PACER_SPIN_MS));
+    }
+
+    while (gs_platform_elapsed_time() < ms);
+}
+
 double gs_platform_elapsed_time()
 {
     return (glfwGetTime() * 1000.0);
 }
 
+/*== Platform Threads == */
+
+typedef struct gs_platform_thread_data_t
+{
+    gs_platform_thread_func_t func;
+    void* user_data;
+    #if (defined GS_PLATFORM_WIN)
+        HANDLE thread;
+    #else
+        pthread_t thread;
+    #endif
+} gs_platform_thread_data_t;
+
+typedef struct gs_platform_semaphore_data_t
+{
+    #if (defined GS_PLATFORM_WIN)
+        HANDLE sem;
+    #else
+        // Unnamed posix semaphores are not available on apple, so build one from a mutex/condition pair
+        pthread_mutex_t mtx;
+        pthread_cond_t cond;
+        uint32_t count;
+    #endif
+} gs_platform_semaphore_data_t;
+
+#if (defined GS_PLATFORM_WIN)
+
+DWORD WINAPI __gs_platform_thread_proc(LPVOID data)
+{
+    gs_platform_thread_data_t* td = (gs_platform_thread_data_t*)data;
+    td->func(td->user_data);
+    return 0;
+}
+
+#else
+
+void* __gs_platform_thread_proc(void* data)
+{
+    gs_platform_thread_data_t* td = (gs_platform_thread_data_t*)data;
+    td->func(td->user_data);
+    return NULL;
+}
+
+#endif
+
+gs_platform_thread_t gs_platform_thread_create(gs_platform_thread_func_t func, void* user_data)
+{
+    gs_platform_thread_t t = gs_default_val();
+    gs_platform_thread_data_t* td = gs_malloc_init(gs_platform_thread_data_t);
+    td->func = func;
+    td->user_data = user_data;
+
+    #if (defined GS_PLATFORM_WIN)
+        td->thread = CreateThread(NULL, 0, __gs_platform_thread_proc, td, 0, NULL);
+        bool32_t created = (td->thread != NULL);
+    #else
+        bool32_t created = (pthread_create(&td->thread, NULL, __gs_platform_thread_proc, td) == 0);
+    #endif
+
+    if (!created) {
+        gs_println("Warning: could not create thread.");
+        gs_free(td);
+        return t;
+    }
+
+    t.hndl = td;
+    return t;
+}
+
+void gs_platform_thread_join(gs_platform_thread_t thread)
+{
+    gs_platform_thread_data_t* td = (gs_platform_thread_data_t*)thread.hndl;
+    if (!td) return;
+
+    #if (defined GS_PLATFORM_WIN)
+        WaitForSingleObject(td->thread, INFINITE);
+        CloseHandle(td->thread);
+    #else
+        pthread_join(td->thread, NULL);
+    #endif
+
+    gs_free(td);
+}
+
+uint32_t gs_platform_hardware_thread_count()
+{
+    #if (defined GS_PLATFORM_WIN)
+        SYSTEM_INFO info = gs_default_val();
+        GetSystemInfo(&info);
+        return (uint32_t)gs_max(info.dwNumberOfProcessors, 1);
+    #else
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        return n > 0 ? (uint32_t)n : 1;
+    #endif
+}
+
+gs_platform_mutex_t gs_platform_mutex_create()
+{
+    gs_platform_mutex_t m = gs_default_val();
+
+    #if (defined GS_PLATFORM_WIN)
+        CRITICAL_SECTION* cs = gs_malloc_init(CRITICAL_SECTION);
+        InitializeCriticalSection(cs);
+        m.hndl = cs;
+    #else
+        pthread_mutex_t* mtx = gs_malloc_init(pthread_mutex_t);
+        pthread_mutex_init(mtx, NULL);
+        m.hndl = mtx;
+    #endif
+
+    return m;
+}
+
+void gs_platform_mutex_destroy(gs_platform_mutex_t mutex)
+{
+    if (!mutex.hndl) return;
+
+    #if (defined GS_PLATFORM_WIN)
+        DeleteCriticalSection((CRITICAL_SECTION*)mutex.hndl);
+    #else
+        pthread_mutex_destroy((pthread_mutex_t*)mutex.hndl);
+    #endif
+
+    gs_free(mutex.hndl);
+}
+
+void gs_platform_mutex_lock(gs_platform_mutex_t mutex)
+{
+    #if (defined GS_PLATFORM_WIN)
+        EnterCriticalSection((CRITICAL_SECTION*)mutex.hndl);
+    #else
+        pthread_mutex_lock((pthread_mutex_t*)mutex.hndl);
+    #endif
+}
+
+void gs_platform_mutex_unlock(gs_platform_mutex_t mutex)
+{
+    #if (defined GS_PLATFORM_WIN)
+        LeaveCriticalSection((CRITICAL_SECTION*)mutex.hndl);
+    #else
+        pthread_mutex_unlock((pthread_mutex_t*)mutex.hndl);
+    #endif
+}
+
+gs_platform_semaphore_t gs_platform_semaphore_create(uint32_t count)
+{
+    gs_platform_semaphore_t s = gs_default_val();
+    gs_platform_semaphore_data_t* sd = gs_malloc_init(gs_platform_semaphore_data_t);
+
+    #if (defined GS_PLATFORM_WIN)
+        sd->sem = CreateSemaphore(NULL, (LONG)count, LONG_MAX, NULL);
+    #else
+        pthread_mutex_init(&sd->mtx, NULL);
+        pthread_cond_init(&sd->cond, NULL);
+        sd->count = count;
+    #endif
+
+    s.hndl = sd;
+    return s;
+}
+
+void gs_platform_semaphore_destroy(gs_platform_semaphore_t sem)
+{
+    gs_platform_semaphore_data_t* sd = (gs_platform_semaphore_data_t*)sem.hndl;
+    if (!sd) return;
+
+    #if (defined GS_PLATFORM_WIN)
+        CloseHandle(sd->sem);
+    #else
+        pthread_cond_destroy(&sd->cond);
+        pthread_mutex_destroy(&sd->mtx);
+    #endif
+
+    gs_free(sd);
+}
+
+void gs_platform_semaphore_wait(gs_platform_semaphore_t sem)
+{
+    gs_platform_semaphore_data_t* sd = (gs_platform_semaphore_data_t*)sem.hndl;
+
+    #if (defined GS_PLATFORM_WIN)
+        WaitForSingleObject(sd->sem, INFINITE);
+    #else
+        pthread_mutex_lock(&sd->mtx);
+        while (!sd->count) {
+            pthread_cond_wait(&sd->cond, &sd->mtx);
+        }
+        sd->count--;
+        pthread_mutex_unlock(&sd->mtx);
+    #endif
+}
+
+void gs_platform_semaphore_post(gs_platform_semaphore_t sem)
+{
+    gs_platform_semaphore_data_t* sd = (gs_platform_semaphore_data_t*)sem.hndl;
+
+    #if (defined GS_PLATFORM_WIN)
+        ReleaseSemaphore(sd->sem, 1, NULL);
+    #else
+        pthread_mutex_lock(&sd->mtx);
+        sd->count++;
+        pthread_cond_signal(&sd->cond);
+        pthread_mutex_unlock(&sd->mtx);
+    #endif
+}
+
 /*== Platform Video == */
 
 void  gs_platform_enable_vsync(int32_t enabled)
 {
-    glfwSwapInterval(enabled ? 1 : 0);
+    gs_platform_video_settings_t* video = &gs_engine_subsystem(platform)->settings.video;
+    video->vsync_enabled = gs_max(enabled, 0);
+    video->refresh_rate = gs_platform_refresh_rate();
+
+    // Applied on window creation if there's no context yet
+    if (glfwGetCurrentContext())
+    {
+        glfwSwapInterval(video->vsync_enabled);
+    }
+}
+
+float gs_platform_refresh_rate()
+{
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : NULL;
+    return mode ? (float)mode->refreshRate : 0.f;
 }
 
 /*== Platform Window == */
@@ -928,6 +1396,7 @@ void* gs_platform_create_window_internal(const char* title, uint32_t width, uint
 
     // Callbacks for window
     glfwMakeContextCurrent(window);
+    glfwSwapInterval(gs_engine_subsystem(platform)->settings.video.vsync_enabled);
     glfwSetKeyCallback(window, &__glfw_key_callback);
     glfwSetMouseButtonCallback(window, &__glfw_mouse_button_callback);
     glfwSetCursorPosCallback(window, &__glfw_mouse_cursor_position_callback);
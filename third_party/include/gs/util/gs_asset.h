@@ -34,6 +34,40 @@
     	#include "gs_asset.h"
 
 	================================================================================================================
+
+	ASYNC LOADING:
+
+	gs_assets_load_from_file_async() returns a handle immediately. File reads and decoding run on loader threads,
+	while the handle resolves to the importer's default asset (a checkerboard for textures, zeroed data otherwise).
+	Graphics uploads are batched onto the main thread: call gs_assets_update() once per frame to finish up to 
+	GS_ASSET_UPLOADS_PER_UPDATE loads, after which the handle resolves to the loaded asset. Options are passed as
+	a pointer to the importer's load options struct (ie. gs_asset_texture_load_opts_t) and are copied, or NULL.
+	Custom importers without decode_from_file/upload load in place instead, receiving the options pointer as the
+	first variadic argument of load_from_file.
+
+		gs_asset_texture_load_opts_t opts = {.default_desc = true, .flip_on_load = true};
+		gs_asset_t tex = gs_assets_load_from_file_async(&am, gs_asset_texture_t, "./assets/tex.png", &opts);
+
+		// Each frame, on the main thread
+		gs_assets_update(&am);
+
+	================================================================================================================
+
+	TEXTURE STREAMING:
+
+	gs_assets_texture_stream() registers a cooked texture (.dds with a mip chain, see gs_asset_texture_cook()). The file
+	stays mapped and only its low resolution tail (levels of GS_ASSET_TEXTURE_STREAM_TAIL_SIZE and below) is uploaded.
+	Report how large each streamed texture is drawn with gs_assets_texture_stream_feedback(), and gs_assets_update() 
+	streams in finer levels one at a time, coarse first. Once the budget is reached, levels of textures that aren't 
+	needed as finely (or haven't been drawn recently) are evicted, least recently used first.
+
+		gs_asset_t tex = gs_assets_texture_stream(&am, "./assets/rock.dds", NULL);
+
+		// Each frame, for each draw using it
+		gs_assets_texture_stream_feedback(&am, tex, screen_extent_in_pixels);
+		gs_assets_update(&am);
+
+	================================================================================================================
 */
 
 /*==== Interface ====*/
@@ -53,10 +87,19 @@ GS_API_DECL gs_asset_t __gs_asset_handle_create_impl(uint64_t type_id, uint32_t
 
 typedef void (* gs_asset_load_func)(const char *,void *,...);
 typedef gs_asset_t (* gs_asset_default_func)(void *);
+typedef bool32_t (* gs_asset_decode_func)(const char*, void*, const void*, void**);
+typedef void (* gs_asset_upload_func)(void*, const void*, void*);
+typedef void (* gs_asset_release_func)(void*);
 
 typedef struct gs_asset_importer_desc_t {
 	void (* load_from_file)(const char* path, void* out, ...);
-	gs_asset_t (* default_asset)(void* out);
+	gs_asset_t (* default_asset)(void* out);	// Passed the asset manager, returns handle to resolve pending async loads to
+	// Async loading (optional): decode runs on a loader thread, upload finishes the asset on the main thread
+	bool32_t (* decode_from_file)(const char* path, void* out, const void* opts, void** staging);
+	void (* upload)(void* out, const void* opts, void* staging);
+	void (* discard)(void* out, const void* opts, void* staging);	// Releases a decoded load that's dropped before upload
+	void (* release)(void* out);				// Releases an asset's resources when the manager is freed (optional)
+	size_t opts_size;							// Size of load options struct copied for each async load
 } gs_asset_importer_desc_t;
 
 typedef struct gs_asset_importer_t 
@@ -70,6 +113,7 @@ typedef struct gs_asset_importer_t
 	gs_asset_importer_desc_t desc;
 	uint32_t importer_id;
 	gs_asset_t default_asset;
+	bool32_t default_resolved;
 } gs_asset_importer_t;
 
 GS_API_DECL void gs_asset_default_load_from_file( const char* path, void* out );
@@ -120,22 +164,119 @@ GS_API_DECL void gs_asset_importer_set_desc(gs_asset_importer_t* imp, gs_asset_i
 	(\
 		gs_assert(gs_hash_table_key_exists((AM)->importers, gs_hash_str64(gs_to_str(T)))),\
 		(AM)->tmpi = gs_hash_table_getp((AM)->importers, gs_hash_str64(gs_to_str(T))),\
-		(AM)->tmpi->tmp_ptr = (DATA),\
-		(AM)->tmpi->tmpid = gs_slot_array_insert_func(&(AM)->tmpi->slot_array_indices_ptr, &(AM)->tmpi->slot_array_data_ptr, (AM)->tmpi->tmp_ptr, (AM)->tmpi->data_size, NULL),\
+		(AM)->tmpi->tmpid = gs_slot_array_insert_func(&(AM)->tmpi->slot_array_indices_ptr, &(AM)->tmpi->slot_array_data_ptr, (void*)(DATA), (AM)->tmpi->data_size, NULL),\
 		gs_asset_handle_create(T, (AM)->tmpi->tmpid, (AM)->tmpi->importer_id)\
 	)
 
+#ifndef GS_ASSET_LOADER_THREADS
+	#define GS_ASSET_LOADER_THREADS 0			// 0 picks from hardware thread count
+#endif
+
+#ifndef GS_ASSET_UPLOADS_PER_UPDATE
+	#define GS_ASSET_UPLOADS_PER_UPDATE 4
+#endif
+
+typedef struct gs_asset_load_job_t
+{
+	char* path;
+	void* opts;
+	void* data;									// Decoded asset, copied into its slot once uploaded
+	void* staging;
+	gs_asset_decode_func decode;
+	uint64_t type_id;
+	uint32_t asset_id;
+	uint32_t importer_id;
+	bool32_t loaded;
+} gs_asset_load_job_t;
+
+typedef struct gs_asset_loader_t
+{
+	gs_dyn_array(gs_platform_thread_t) threads;
+	gs_platform_mutex_t mtx;
+	gs_platform_semaphore_t sem;
+	gs_dyn_array(gs_asset_load_job_t*) queue;	// Waiting on decode, guarded by mtx
+	gs_dyn_array(gs_asset_load_job_t*) done;	// Waiting on upload, guarded by mtx
+	uint32_t queue_head;
+	gs_dyn_array(gs_asset_load_job_t*) jobs;	// All loads in flight, main thread only
+	bool32_t quit;
+} gs_asset_loader_t;
+
+#ifndef GS_ASSET_TEXTURE_STREAM_BUDGET
+	#define GS_ASSET_TEXTURE_STREAM_BUDGET (256 * 1024 * 1024)	// Default vram budget for streamed texture levels
+#endif
+
+#ifndef GS_ASSET_TEXTURE_STREAM_TAIL_SIZE
+	#define GS_ASSET_TEXTURE_STREAM_TAIL_SIZE 64				// Levels this size and smaller are always resident
+#endif
+
+#ifndef GS_ASSET_TEXTURE_STREAM_UPLOADS_PER_UPDATE
+	#define GS_ASSET_TEXTURE_STREAM_UPLOADS_PER_UPDATE 4		// Levels uploaded per gs_assets_update()
+#endif
+
+#ifndef GS_ASSET_TEXTURE_STREAM_IDLE_UPDATES
+	#define GS_ASSET_TEXTURE_STREAM_IDLE_UPDATES 120			// Updates without feedback before a texture only wants its tail
+#endif
+
+typedef struct gs_asset_texture_stream_t
+{
+	gs_asset_t asset;
+	gs_platform_file_view_t view;		// Cooked file stays mapped, levels upload straight from it
+	gs_graphics_texture_desc_t levels;	// Level pointers into view
+	uint32_t tail_level;				// Coarsest levels from here on are always resident
+	uint32_t resident_level;			// Finest level in vram
+	uint32_t wanted_level;				// Finest level asked for by feedback
+	uint64_t last_used;					// Update of last feedback
+} gs_asset_texture_stream_t;
+
+typedef struct gs_asset_texture_stream_stats_t
+{
+	size_t budget;
+	size_t resident_bytes;				// Streamed texture levels in vram, tails included
+	size_t wanted_bytes;				// Needed to satisfy all current feedback
+	uint32_t texture_count;
+	uint32_t satisfied_count;			// Textures resident at (or finer than) their wanted level
+	uint32_t uploads;					// Levels uploaded, running total
+	uint32_t evictions;					// Levels evicted, running total
+} gs_asset_texture_stream_stats_t;
+
+typedef struct gs_asset_texture_streamer_t
+{
+	gs_dyn_array(gs_asset_texture_stream_t) streams;
+	gs_hash_table(uint32_t, uint32_t) lookup;		// Asset id to stream index
+	uint64_t update;
+	gs_asset_texture_stream_stats_t stats;
+} gs_asset_texture_streamer_t;
+
 typedef struct gs_asset_manager_t
 {
 	gs_hash_table(uint64_t, gs_asset_importer_t) importers;	// Maps hashed types to importer
 	gs_asset_importer_t* tmpi;								// Temporary importer for caching 
 	uint32_t free_importer_id;
+	gs_asset_loader_t* loader;								// Started on first async load
+	gs_asset_texture_streamer_t streamer;
 } gs_asset_manager_t;
 
 GS_API_DECL gs_asset_manager_t gs_asset_manager_new();
 GS_API_DECL void gs_asset_manager_free(gs_asset_manager_t* am);
 GS_API_DECL void* __gs_assets_getp_impl(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t hndl);
 
+// Async loading
+GS_API_DECL gs_asset_t __gs_assets_load_from_file_async_impl(gs_asset_manager_t* am, uint64_t type_id, const char* path, const void* opts);
+GS_API_DECL void       gs_assets_update(gs_asset_manager_t* am);	// Finishes a batch of decoded loads, main thread only
+GS_API_DECL void       gs_assets_flush(gs_asset_manager_t* am);		// Blocks until all pending loads are finished
+GS_API_DECL uint32_t   gs_assets_pending(gs_asset_manager_t* am);
+GS_API_DECL bool32_t   gs_assets_is_loaded(gs_asset_manager_t* am, gs_asset_t hndl);
+GS_API_DECL gs_asset_t gs_asset_texture_default_asset(void* am);
+
+// Texture streaming
+GS_API_DECL gs_asset_t gs_assets_texture_stream(gs_asset_manager_t* am, const char* path, const gs_asset_texture_load_opts_t* opts);
+GS_API_DECL void       gs_assets_texture_stream_feedback(gs_asset_manager_t* am, gs_asset_t hndl, float screen_size);	// Largest on screen extent in pixels, this frame
+GS_API_DECL void       gs_assets_texture_stream_set_budget(gs_asset_manager_t* am, size_t bytes);
+GS_API_DECL gs_asset_texture_stream_stats_t gs_assets_texture_stream_stats(gs_asset_manager_t* am);
+
+#define gs_assets_load_from_file_async(AM, T, PATH, OPTS)\
+	__gs_assets_load_from_file_async_impl(AM, gs_hash_str64(gs_to_str(T)), PATH, OPTS)
+
 #define gs_assets_getp(AM, T, HNDL)\
 	(T*)(__gs_assets_getp_impl(AM, gs_hash_str64(gs_to_str(T)), HNDL))
 
@@ -162,25 +303,514 @@ gs_asset_manager_t gs_asset_manager_new()
 	// Register default asset importers
 	gs_asset_importer_desc_t tex_desc   = gs_default_val();
 	gs_asset_importer_desc_t font_desc  = gs_default_val();
+	gs_asset_importer_desc_t sdf_font_desc = gs_default_val();
 	gs_asset_importer_desc_t audio_desc = gs_default_val();
 	gs_asset_importer_desc_t mesh_desc  = gs_default_val();
 
 	tex_desc.load_from_file = (gs_asset_load_func)&gs_asset_texture_load_from_file;
 	font_desc.load_from_file = (gs_asset_load_func)&gs_asset_font_load_from_file;
+	sdf_font_desc.load_from_file = (gs_asset_load_func)&gs_asset_sdf_font_load_from_file;
 	audio_desc.load_from_file = (gs_asset_load_func)&gs_asset_audio_load_from_file;
 	mesh_desc.load_from_file = (gs_asset_load_func)&gs_asset_mesh_load_from_file;
 
+	tex_desc.decode_from_file = (gs_asset_decode_func)&gs_asset_texture_decode_from_file;
+	tex_desc.upload = (gs_asset_upload_func)&gs_asset_texture_upload;
+	tex_desc.discard = (gs_asset_upload_func)&gs_asset_texture_discard;
+	tex_desc.opts_size = sizeof(gs_asset_texture_load_opts_t);
+	tex_desc.default_asset = (gs_asset_default_func)&gs_asset_texture_default_asset;
+	font_desc.decode_from_file = (gs_asset_decode_func)&gs_asset_font_decode_from_file;
+	font_desc.upload = (gs_asset_upload_func)&gs_asset_font_upload;
+	font_desc.discard = (gs_asset_upload_func)&gs_asset_font_discard;
+	font_desc.opts_size = sizeof(gs_asset_font_load_opts_t);
+	sdf_font_desc.decode_from_file = (gs_asset_decode_func)&gs_asset_sdf_font_decode_from_file;
+	sdf_font_desc.upload = (gs_asset_upload_func)&gs_asset_sdf_font_upload;
+	sdf_font_desc.discard = (gs_asset_upload_func)&gs_asset_sdf_font_discard;
+	audio_desc.decode_from_file = (gs_asset_decode_func)&gs_asset_audio_decode_from_file;
+	audio_desc.upload = (gs_asset_upload_func)&gs_asset_audio_upload;
+	audio_desc.discard = (gs_asset_upload_func)&gs_asset_audio_discard;
+	mesh_desc.decode_from_file = (gs_asset_decode_func)&gs_asset_mesh_decode_from_file;
+	mesh_desc.upload = (gs_asset_upload_func)&gs_asset_mesh_upload;
+	mesh_desc.discard = (gs_asset_upload_func)&gs_asset_mesh_discard;
+	mesh_desc.opts_size = sizeof(gs_asset_mesh_load_opts_t);
+
+	// Audio sources belong to the audio subsystem and are released when it shuts down
+	tex_desc.release = (gs_asset_release_func)&gs_asset_texture_free;
+	font_desc.release = (gs_asset_release_func)&gs_asset_font_free;
+	sdf_font_desc.release = (gs_asset_release_func)&gs_asset_sdf_font_free;
+	mesh_desc.release = (gs_asset_release_func)&gs_asset_mesh_free;
+
 	gs_assets_register_importer(&assets, gs_asset_texture_t, &tex_desc);
 	gs_assets_register_importer(&assets, gs_asset_font_t, &font_desc);
+	gs_assets_register_importer(&assets, gs_asset_sdf_font_t, &sdf_font_desc);
 	gs_assets_register_importer(&assets, gs_asset_audio_t, &audio_desc);
 	gs_assets_register_importer(&assets, gs_asset_mesh_t, &mesh_desc);
 
 	return assets;
 }
 
+void gs_asset_loader_job_free(gs_asset_load_job_t* job)
+{
+	gs_free(job->path);
+	gs_free(job->opts);
+	gs_free(job->data);
+	gs_free(job);
+}
+
+// Element idx of an importer's data array
+static void* __gs_asset_importer_data_at(gs_asset_importer_t* imp, uint32_t idx)
+{
+	size_t data_sz = imp->data_size;
+	size_t s = data_sz == 8 ? 7 : 3;
+	size_t offset = (((data_sz * idx) + s) & (~s));
+	return ((char*)(imp->slot_array_data_ptr) + offset);
+}
+
 void gs_asset_manager_free(gs_asset_manager_t* am)
 {
-	// Free all data	
+	gs_asset_loader_t* ld = am->loader;
+	if (ld)
+	{
+		// Stop loader threads, decodes already running are allowed to finish
+		gs_platform_mutex_lock(ld->mtx);
+		ld->quit = true;
+		gs_platform_mutex_unlock(ld->mtx);
+
+		for (uint32_t i = 0; i < gs_dyn_array_size(ld->threads); ++i) {
+			gs_platform_semaphore_post(ld->sem);
+		}
+		for (uint32_t i = 0; i < gs_dyn_array_size(ld->threads); ++i) {
+			gs_platform_thread_join(ld->threads[i]);
+		}
+
+		// Anything still listed was never uploaded, decoded ones hold staging data
+		for (uint32_t i = 0; i < gs_dyn_array_size(ld->jobs); ++i) 
+		{
+			gs_asset_load_job_t* job = ld->jobs[i];
+			if (job->loaded) {
+				gs_asset_importer_t* imp = gs_hash_table_getp(am->importers, job->type_id);
+				if (imp->desc.discard) imp->desc.discard(job->data, job->opts, job->staging);
+				else if (job->staging) gs_free(job->staging);
+			}
+			gs_asset_loader_job_free(job);
+		}
+
+		gs_platform_semaphore_destroy(ld->sem);
+		gs_platform_mutex_destroy(ld->mtx);
+		gs_dyn_array_free(ld->threads);
+		gs_dyn_array_free(ld->queue);
+		gs_dyn_array_free(ld->done);
+		gs_dyn_array_free(ld->jobs);
+		gs_free(ld);
+		am->loader = NULL;
+	}
+
+	// Streamed textures keep their cooked files mapped
+	gs_asset_texture_streamer_t* st = &am->streamer;
+	for (uint32_t i = 0; i < gs_dyn_array_size(st->streams); ++i) {
+		gs_platform_file_view_close(&st->streams[i].view);
+	}
+	gs_dyn_array_free(st->streams);
+	gs_hash_table_free(st->lookup);
+	memset(st, 0, sizeof(gs_asset_texture_streamer_t));
+
+	// Importer storage, data and indices are tracked by the importer (slot array members are stale after growth).
+	// Pending loads hold a copy of the default asset, so releases have to ignore repeated handles (destroys do)
+	for (gs_hash_table_iter it = gs_hash_table_iter_new(am->importers); 
+		gs_hash_table_iter_valid(am->importers, it); gs_hash_table_iter_advance(am->importers, it)) {
+		gs_asset_importer_t* imp = gs_hash_table_iter_getp(am->importers, it);
+		if (imp->desc.release) {
+			for (uint32_t i = 0; i < gs_dyn_array_size(imp->slot_array_data_ptr); ++i) {
+				imp->desc.release(__gs_asset_importer_data_at(imp, i));
+			}
+		}
+		gs_dyn_array_free(imp->slot_array_data_ptr);
+		gs_dyn_array_free(imp->slot_array_indices_ptr);
+		gs_free(imp->slot_array);
+	}
+	gs_hash_table_free(am->importers);
+	am->importers = NULL;
+}
+
+void gs_asset_loader_thread(void* user_data)
+{
+	gs_asset_loader_t* ld = (gs_asset_loader_t*)user_data;
+
+	for (;;)
+	{
+		gs_platform_semaphore_wait(ld->sem);
+
+		gs_platform_mutex_lock(ld->mtx);
+		if (ld->quit) {
+			gs_platform_mutex_unlock(ld->mtx);
+			break;
+		}
+		gs_asset_load_job_t* job = ld->queue[ld->queue_head++];
+		if (ld->queue_head == gs_dyn_array_size(ld->queue)) {
+			gs_dyn_array_clear(ld->queue);
+			ld->queue_head = 0;
+		}
+		gs_platform_mutex_unlock(ld->mtx);
+
+		job->loaded = job->decode(job->path, job->data, job->opts, &job->staging);
+
+		gs_platform_mutex_lock(ld->mtx);
+		gs_dyn_array_push(ld->done, job);
+		gs_platform_mutex_unlock(ld->mtx);
+	}
+}
+
+gs_asset_loader_t* gs_asset_loader_start(gs_asset_manager_t* am)
+{
+	if (am->loader) return am->loader;
+
+	gs_asset_loader_t* ld = gs_malloc_init(gs_asset_loader_t);
+	ld->mtx = gs_platform_mutex_create();
+	ld->sem = gs_platform_semaphore_create(0);
+
+	// Leave a core for the main thread
+	uint32_t count = GS_ASSET_LOADER_THREADS;
+	if (!count) {
+		uint32_t hw = gs_platform_hardware_thread_count();
+		count = gs_clamp(hw > 1 ? hw - 1 : 1, 1, 4);
+	}
+
+	for (uint32_t i = 0; i < count; ++i) {
+		gs_platform_thread_t t = gs_platform_thread_create(gs_asset_loader_thread, ld);
+		if (t.hndl) gs_dyn_array_push(ld->threads, t);
+	}
+
+	am->loader = ld;
+	return ld;
+}
+
+gs_asset_t __gs_assets_load_from_file_async_impl(gs_asset_manager_t* am, uint64_t type_id, const char* path, const void* opts)
+{
+	gs_assert(gs_hash_table_key_exists(am->importers, type_id));
+	gs_asset_importer_t* imp = gs_hash_table_getp(am->importers, type_id);
+
+	// Importers without staged loading can't leave the main thread, load these in place (options passed through as is)
+	if (!imp->desc.decode_from_file || !imp->desc.upload) {
+		imp->desc.load_from_file(path, imp->tmp_ptr, opts);
+		uint32_t id = gs_slot_array_insert_func(&imp->slot_array_indices_ptr, &imp->slot_array_data_ptr, imp->tmp_ptr, imp->data_size, NULL);
+		return __gs_asset_handle_create_impl(type_id, id, imp->importer_id);
+	}
+
+	gs_asset_loader_t* ld = gs_asset_loader_start(am);
+
+	// Resolve placeholder once per importer, may create assets so importer is fetched again
+	if (!imp->default_resolved) {
+		imp->default_resolved = true;
+		gs_asset_t def = imp->desc.default_asset(am);
+		imp = gs_hash_table_getp(am->importers, type_id);
+		imp->default_asset = def;
+	}
+
+	// Slot holds a copy of the default asset until the load is uploaded
+	gs_asset_load_job_t* job = gs_malloc_init(gs_asset_load_job_t);
+	job->data = gs_malloc(imp->data_size);
+	if (imp->default_asset.type_id == type_id) {
+		memcpy(job->data, __gs_assets_getp_impl(am, type_id, imp->default_asset), imp->data_size);
+	} else {
+		memset(job->data, 0, imp->data_size);
+	}
+	job->asset_id = gs_slot_array_insert_func(&imp->slot_array_indices_ptr, &imp->slot_array_data_ptr, job->data, imp->data_size, NULL);
+	memset(job->data, 0, imp->data_size);
+
+	size_t len = strlen(path) + 1;
+	job->path = (char*)gs_malloc(len);
+	memcpy(job->path, path, len);
+	if (opts && imp->desc.opts_size) {
+		job->opts = gs_malloc(imp->desc.opts_size);
+		memcpy(job->opts, opts, imp->desc.opts_size);
+	}
+	job->decode = (gs_asset_decode_func)imp->desc.decode_from_file;
+	job->type_id = type_id;
+	job->importer_id = imp->importer_id;
+
+	gs_dyn_array_push(ld->jobs, job);
+
+	gs_platform_mutex_lock(ld->mtx);
+	gs_dyn_array_push(ld->queue, job);
+	gs_platform_mutex_unlock(ld->mtx);
+	gs_platform_semaphore_post(ld->sem);
+
+	return __gs_asset_handle_create_impl(type_id, job->asset_id, job->importer_id);
+}
+
+/* Texture Streaming */
+
+static size_t __gs_asset_texture_stream_level_size(const gs_asset_texture_stream_t* s, uint32_t level)
+{
+	return gs_graphics_texture_level_size(s->levels.format, gs_max(s->levels.width >> level, 1), gs_max(s->levels.height >> level, 1));
+}
+
+static void __gs_asset_texture_stream_set_level(gs_asset_manager_t* am, gs_asset_texture_stream_t* s, uint32_t level)
+{
+	gs_asset_texture_streamer_t* st = &am->streamer;
+	for (uint32_t l = gs_min(level, s->resident_level); l < gs_max(level, s->resident_level); ++l) {
+		size_t sz = __gs_asset_texture_stream_level_size(s, l);
+		if (level < s->resident_level) st->stats.resident_bytes += sz;
+		else st->stats.resident_bytes -= sz;
+	}
+
+	gs_asset_texture_t* t = gs_assets_getp(am, gs_asset_texture_t, s->asset);
+	gs_graphics_texture_set_base_level(t->hndl, level, &s->levels);
+	s->resident_level = level;
+}
+
+// Drops the finest level of one texture: levels finer than wanted go first, then least recently drawn.
+// Textures drawn as recently as keep hold on to what they need.
+static bool32_t __gs_asset_texture_stream_evict(gs_asset_manager_t* am, const gs_asset_texture_stream_t* keep)
+{
+	gs_asset_texture_streamer_t* st = &am->streamer;
+	gs_asset_texture_stream_t* victim = NULL;
+	bool32_t victim_surplus = false;
+
+	for (uint32_t i = 0; i < gs_dyn_array_size(st->streams); ++i) {
+		gs_asset_texture_stream_t* s = &st->streams[i];
+		if (s == keep || s->resident_level >= s->tail_level) continue;
+		bool32_t surplus = s->resident_level < s->wanted_level;
+		if (!surplus && keep && s->last_used >= keep->last_used) continue;
+		if (!victim || (surplus && !victim_surplus) || (surplus == victim_surplus && s->last_used < victim->last_used)) {
+			victim = s;
+			victim_surplus = surplus;
+		}
+	}
+
+	if (!victim) return false;
+	__gs_asset_texture_stream_set_level(am, victim, victim->resident_level + 1);
+	st->stats.evictions++;
+	return true;
+}
+
+static void __gs_assets_texture_stream_update(gs_asset_manager_t* am)
+{
+	gs_asset_texture_streamer_t* st = &am->streamer;
+	const uint32_t count = gs_dyn_array_size(st->streams);
+	if (!count) return;
+
+	st->update++;
+
+	// Textures not drawn for a while only want their tail, their finer levels become eviction candidates
+	for (uint32_t i = 0; i < count; ++i) {
+		gs_asset_texture_stream_t* s = &st->streams[i];
+		if (st->update - s->last_used > GS_ASSET_TEXTURE_STREAM_IDLE_UPDATES) {
+			s->wanted_level = s->tail_level;
+		}
+	}
+
+	// Budget may have shrunk
+	while (st->stats.resident_bytes > st->stats.budget && __gs_asset_texture_stream_evict(am, NULL));
+
+	for (uint32_t u = 0; u < GS_ASSET_TEXTURE_STREAM_UPLOADS_PER_UPDATE; ++u)
+	{
+		// Largest shortfall first, one level at a time, so coarse levels everywhere land before fine ones
+		gs_asset_texture_stream_t* want = NULL;
+		for (uint32_t i = 0; i < count; ++i) {
+			gs_asset_texture_stream_t* s = &st->streams[i];
+			if (s->resident_level <= s->wanted_level) continue;
+			uint32_t deficit = s->resident_level - s->wanted_level;
+			uint32_t want_deficit = want ? want->resident_level - want->wanted_level : 0;
+			if (!want || deficit > want_deficit || (deficit == want_deficit && s->last_used > want->last_used)) {
+				want = s;
+			}
+		}
+		if (!want) break;
+
+		const uint32_t level = want->resident_level - 1;
+		const size_t cost = __gs_asset_texture_stream_level_size(want, level);
+		while (st->stats.resident_bytes + cost > st->stats.budget && __gs_asset_texture_stream_evict(am, want));
+
+		// Over subscribed, keep what's resident
+		if (st->stats.resident_bytes + cost > st->stats.budget) break;
+
+		__gs_asset_texture_stream_set_level(am, want, level);
+		st->stats.uploads++;
+	}
+
+	st->stats.wanted_bytes = 0;
+	st->stats.satisfied_count = 0;
+	for (uint32_t i = 0; i < count; ++i) {
+		gs_asset_texture_stream_t* s = &st->streams[i];
+		for (uint32_t l = s->wanted_level; l <= s->levels.num_mips; ++l) {
+			st->stats.wanted_bytes += __gs_asset_texture_stream_level_size(s, l);
+		}
+		if (s->resident_level <= s->wanted_level) st->stats.satisfied_count++;
+	}
+}
+
+gs_asset_t gs_assets_texture_stream(gs_asset_manager_t* am, const char* path, const gs_asset_texture_load_opts_t* opts)
+{
+	gs_asset_texture_streamer_t* st = &am->streamer;
+	if (!st->stats.budget) st->stats.budget = GS_ASSET_TEXTURE_STREAM_BUDGET;
+
+	gs_asset_texture_t t = gs_default_val();
+	void* staging = NULL;
+	if (!gs_asset_texture_decode_from_file(path, &t, opts, &staging)) {
+		return gs_assets_create_asset(am, gs_asset_texture_t, &t);
+	}
+
+	// Only cooked textures have their levels addressable in the file, anything else is fully resident
+	if (!staging) {
+		gs_println("Warning:TextureStream:Not a cooked texture, loading fully resident: %s", path);
+		gs_asset_texture_upload(&t, opts, NULL);
+		return gs_assets_create_asset(am, gs_asset_texture_t, &t);
+	}
+
+	gs_asset_texture_stream_t s = gs_default_val();
+	gs_asset_texture_staging_t* ts = (gs_asset_texture_staging_t*)staging;
+	s.view = ts->view;
+	s.levels = t.desc;
+	gs_free(ts);
+
+	// Low resolution tail is uploaded now, everything finer on demand
+	while (s.tail_level < t.desc.num_mips && 
+		gs_max(t.desc.width >> s.tail_level, t.desc.height >> s.tail_level) > GS_ASSET_TEXTURE_STREAM_TAIL_SIZE) {
+		s.tail_level++;
+	}
+	s.resident_level = s.tail_level;
+	s.wanted_level = s.tail_level;
+	s.last_used = st->update;
+
+	t.desc.base_level = s.tail_level;
+	t.hndl = gs_graphics_texture_create(&t.desc);
+	t.desc.data = NULL;
+	memset(t.desc.mip_data, 0, sizeof(t.desc.mip_data));
+	s.asset = gs_assets_create_asset(am, gs_asset_texture_t, &t);
+
+	for (uint32_t l = s.tail_level; l <= t.desc.num_mips; ++l) {
+		st->stats.resident_bytes += __gs_asset_texture_stream_level_size(&s, l);
+	}
+
+	gs_hash_table_insert(st->lookup, s.asset.asset_id, gs_dyn_array_size(st->streams));
+	gs_dyn_array_push(st->streams, s);
+	return s.asset;
+}
+
+void gs_assets_texture_stream_feedback(gs_asset_manager_t* am, gs_asset_t hndl, float screen_size)
+{
+	gs_asset_texture_streamer_t* st = &am->streamer;
+	if (!st->lookup || !gs_hash_table_key_exists(st->lookup, hndl.asset_id)) return;
+	gs_asset_texture_stream_t* s = &st->streams[gs_hash_table_get(st->lookup, hndl.asset_id)];
+
+	// Level with texels closest to 1:1 with pixels on screen, finest request this update wins
+	float extent = (float)gs_max(s->levels.width, s->levels.height);
+	float lod = screen_size > 0.f ? log2f(extent / screen_size) : (float)s->tail_level;
+	uint32_t level = lod <= 0.f ? 0 : gs_min((uint32_t)lod, s->tail_level);
+	s->wanted_level = s->last_used == st->update ? gs_min(s->wanted_level, level) : level;
+	s->last_used = st->update;
+}
+
+void gs_assets_texture_stream_set_budget(gs_asset_manager_t* am, size_t bytes)
+{
+	am->streamer.stats.budget = bytes;
+}
+
+gs_asset_texture_stream_stats_t gs_assets_texture_stream_stats(gs_asset_manager_t* am)
+{
+	gs_asset_texture_stream_stats_t stats = am->streamer.stats;
+	stats.texture_count = gs_dyn_array_size(am->streamer.streams);
+	return stats;
+}
+
+void gs_assets_update(gs_asset_manager_t* am)
+{
+	__gs_assets_texture_stream_update(am);
+
+	gs_asset_loader_t* ld = am->loader;
+	if (!ld || !gs_dyn_array_size(ld->jobs)) return;
+
+	// Take a batch of decoded loads, uploads happen outside the lock
+	gs_asset_load_job_t* batch[GS_ASSET_UPLOADS_PER_UPDATE];
+	uint32_t count = 0;
+
+	gs_platform_mutex_lock(ld->mtx);
+	uint32_t ready = gs_dyn_array_size(ld->done);
+	count = gs_min(ready, GS_ASSET_UPLOADS_PER_UPDATE);
+	if (count) {
+		memcpy(batch, ld->done, count * sizeof(gs_asset_load_job_t*));
+		memmove(ld->done, ld->done + count, (ready - count) * sizeof(gs_asset_load_job_t*));
+		gs_dyn_array_head(ld->done)->size = ready - count;
+	}
+	gs_platform_mutex_unlock(ld->mtx);
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		gs_asset_load_job_t* job = batch[i];
+		gs_asset_importer_t* imp = gs_hash_table_getp(am->importers, job->type_id);
+
+		if (job->loaded) {
+			imp->desc.upload(job->data, job->opts, job->staging);
+			gs_asset_t hndl = __gs_asset_handle_create_impl(job->type_id, job->asset_id, job->importer_id);
+			memcpy(__gs_assets_getp_impl(am, job->type_id, hndl), job->data, imp->data_size);
+		} else {
+			gs_println("Warning: async load failed, keeping default asset: %s", job->path);
+		}
+
+		for (uint32_t j = 0; j < gs_dyn_array_size(ld->jobs); ++j) {
+			if (ld->jobs[j] == job) {
+				ld->jobs[j] = gs_dyn_array_back(ld->jobs);
+				gs_dyn_array_pop(ld->jobs);
+				break;
+			}
+		}
+
+		gs_asset_loader_job_free(job);
+	}
+}
+
+void gs_assets_flush(gs_asset_manager_t* am)
+{
+	while (gs_assets_pending(am)) {
+		gs_assets_update(am);
+		if (gs_assets_pending(am)) gs_platform_sleep(1.f);
+	}
+}
+
+uint32_t gs_assets_pending(gs_asset_manager_t* am)
+{
+	return am->loader ? gs_dyn_array_size(am->loader->jobs) : 0;
+}
+
+bool32_t gs_assets_is_loaded(gs_asset_manager_t* am, gs_asset_t hndl)
+{
+	gs_asset_loader_t* ld = am->loader;
+	if (!ld) return true;
+
+	for (uint32_t i = 0; i < gs_dyn_array_size(ld->jobs); ++i) {
+		gs_asset_load_job_t* job = ld->jobs[i];
+		if (job->importer_id == hndl.importer_id && job->asset_id == hndl.asset_id) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+gs_asset_t gs_asset_texture_default_asset(void* am)
+{
+	// Magenta checkerboard, hard to miss while the real texture streams in
+	const uint32_t sz = 8;
+	uint32_t pixels[8 * 8];
+	for (uint32_t y = 0; y < sz; ++y) {
+		for (uint32_t x = 0; x < sz; ++x) {
+			pixels[y * sz + x] = ((x ^ y) & 1) ? 0xff000000 : 0xffff00ff;
+		}
+	}
+
+	gs_asset_texture_t t = gs_default_val();
+	t.desc.width = sz;
+	t.desc.height = sz;
+	t.desc.format = GS_GRAPHICS_TEXTURE_FORMAT_RGBA8;
+	t.desc.min_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST;
+	t.desc.mag_filter = GS_GRAPHICS_TEXTURE_FILTER_NEAREST;
+	t.desc.wrap_s = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
+	t.desc.wrap_t = GS_GRAPHICS_TEXTURE_WRAP_REPEAT;
+	t.desc.data = pixels;
+	t.hndl = gs_graphics_texture_create(&t.desc);
+	t.desc.data = NULL;
+
+	return gs_assets_create_asset((gs_asset_manager_t*)am, gs_asset_texture_t, &t);
 }
 
 void* __gs_assets_getp_impl(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t hndl)
@@ -212,10 +842,7 @@ void* __gs_assets_getp_impl(gs_asset_manager_t* am, uint64_t type_id, gs_asset_t
 	size_t offset = (((sizeof(uint32_t) * hndl.asset_id) + 3) & (~3));
 	uint32_t idx = *(uint32_t*)((char*)(imp->slot_array_indices_ptr) + offset);
 	// Then need to return pointer to data at index
-	size_t data_sz = imp->data_size;
-	size_t s = data_sz == 8 ? 7 : 3;
-	offset = (((data_sz * idx) + s) & (~s));
-	return ((char*)(imp->slot_array_data_ptr) + offset);
+	return __gs_asset_importer_data_at(imp, idx);
 }
 
 void gs_asset_importer_set_desc(gs_asset_importer_t* imp, gs_asset_importer_desc_t* desc)
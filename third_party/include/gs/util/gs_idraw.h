@@ -34,6 +34,32 @@
     	#define GS_IMMEDIATE_DRAW_IMPL
     	#include "gs_idraw.h"
 
+    DEFERRED MODE:
+
+    	gsi_deferred_enabled(gsi, true) records draws instead of submitting them in call order. At gsi_draw(),
+    	draws are sorted by (layer, pipeline state, texture, sort depth) and neighbors sharing state are merged
+    	into single draw calls. Use gsi_layer() to order groups of draws, and gsi_preserve_order() for anything
+    	that relies on call order (translucency) - those draws are submitted after the layer's sorted draws.
+
+    RECORDERS (MULTI-THREADED RECORDING):
+
+    	gs_immediate_draw_new_recorder(&gsi) creates a context that shares gsi's pipelines, buffers, default
+    	texture and font read-only, and owns only its own command buffer and vertex data. Give each worker job
+    	its own recorder; recorders may record concurrently with each other. At frame end, on the main thread,
+    	gsi_merge(&gsi, recorders, count) appends their commands to gsi in array order (deterministic, whatever
+    	order the jobs finished in). Don't create graphics resources while recorders are recording, and free
+    	recorders before the context they were created from.
+
+    	The exception is SDF text: gsi_text_sdf() writes to the font it draws with (page LRU ticks, glyph cache,
+    	atlas uploads), so each gs_asset_sdf_font_t must only be drawn from one thread at a time. Record SDF
+    	text on the main context or on a single recorder.
+
+    TEXT:
+
+    	gsi_text() and gsi_text_sdf() shape each string once into a run of quads, cached by (text, font, size).
+    	Drawing the same text again (HUD, debug overlays) copies the cached run into the vertex stream at the pen
+    	position, so runs batch with whatever else shares their texture.
+
     TODO (john): 
 		* Convert flush command to push back commands
 		* On final flush, request update for vertex/index buffer data
@@ -49,12 +75,20 @@ gs_enum_decl(gsi_matrix_type,
 	GSI_MATRIX_PROJECTION
 );
 
+gs_enum_decl(gsi_shape_type,
+	GSI_SHAPE_SPHERE,
+	GSI_SHAPE_BOX,
+	GSI_SHAPE_CIRCLE,
+	GSI_SHAPE_RECT,		// Unit square [0, 1]
+	GSI_SHAPE_LINE		// (0, 0) -> (1, 1), lines only
+);
+
 // Need a configurable pipeline matrix
 /*
-	depth | stencil | face cull | blend | prim
-	e/d 	e/d 		e/d 		e/d 	l/t
+	depth | stencil | face cull | blend | prim | sdf
+	e/d 	e/d 		e/d 		e/d 	l/t 	e/d
 
-	2 ^ 5 = 32 generated pipeline choices.
+	2 ^ 6 = 64 generated pipeline choices.
 */
 
 // Hash bytes of state attr struct to get index key for pipeline
@@ -65,6 +99,7 @@ typedef struct gsi_pipeline_state_attr_t
 	uint16_t blend_enabled;	
 	uint16_t face_cull_enabled;
 	uint16_t prim_type;
+	uint16_t sdf_enabled;	// Texture holds a distance field (r channel), alpha from edge
 } gsi_pipeline_state_attr_t;
 
 typedef struct gs_immediate_vert_t
@@ -92,9 +127,111 @@ typedef struct gs_immediate_cache_t
 	gs_handle(gs_graphics_texture_t) texture;
 	// Cached pipeline state attr
 	gsi_pipeline_state_attr_t pipeline;
+	/* Sort layer (deferred mode only) */
+	uint8_t layer;
+	/* Sort depth (deferred mode only) */
+	float sort_depth;
+	/* Submit in call order within layer (deferred mode only) */
+	bool preserve_order;
 
 } gs_immediate_cache_t;
 
+// Deferred draw queue
+/*
+	Sort key layout (64 bits, msb to lsb):
+
+	unordered: layer(8) | 0 | pipeline(6) | texture(17) | depth(32)
+	ordered:   layer(8) | 1 | sequence(55)
+
+	Ordered entries of a layer always submit after its unordered entries, in call order.
+*/
+typedef struct gs_immediate_draw_entry_t
+{
+	uint64_t key;
+	gsi_pipeline_state_attr_t pipeline;
+	gs_handle(gs_graphics_texture_t) texture;
+	gs_mat4 mvp;
+	uint32_t start;
+	uint32_t count;
+} gs_immediate_draw_entry_t;
+
+typedef struct gs_immediate_batch_t
+{
+	uint32_t entry;	// First entry of batch (sorted), holds state for batch
+	uint32_t start;
+	uint32_t count;
+} gs_immediate_batch_t;
+
+typedef struct gs_immediate_deferred_t
+{
+	/* Opt-in: record draws and sort at gsi_draw() instead of submitting in call order */
+	bool enabled;
+	/* Call order counter for ordered entries */
+	uint32_t sequence;
+	/* Recorded draws */
+	gs_dyn_array(gs_immediate_draw_entry_t) entries;
+	/* Recorded vertex data, in call order */
+	gs_dyn_array(gs_immediate_vert_t) vertices;
+	/* Vertex data rebuilt in sorted order */
+	gs_dyn_array(gs_immediate_vert_t) sorted;
+	/* Merged batches */
+	gs_dyn_array(gs_immediate_batch_t) batches;
+	/* Radix sort index buffers */
+	gs_dyn_array(uint32_t) order;
+	gs_dyn_array(uint32_t) scratch;
+} gs_immediate_deferred_t;
+
+// Unit shape geometry, generated once and kept in a static vertex buffer
+typedef struct gs_immediate_retained_mesh_t
+{
+	gs_handle(gs_graphics_vertex_buffer_t) vbo;
+	/* CPU copy, expanded into the vertex stream in deferred mode */
+	gs_dyn_array(gs_immediate_vert_t) vertices;
+} gs_immediate_retained_mesh_t;
+
+// Per-instance record for instanced 2D shapes, expanded from the base shape in the vertex shader
+typedef struct gs_immediate_instance_t
+{
+	gs_vec4 rect;		// xy: offset, zw: scale of base shape
+	gs_vec4 uv;			// xy: uv0, zw: uv1
+	gs_color_t color;
+} gs_immediate_instance_t;
+
+typedef struct gs_immediate_instanced_t
+{
+	/* Instance stream buffer */
+	gs_handle(gs_graphics_vertex_buffer_t) vbo;
+	/* Pipeline state matrix table for instanced shapes */
+	gs_hash_table(gsi_pipeline_state_attr_t, gs_handle(gs_graphics_pipeline_t)) pipeline_table;
+	/* Pending instances, all of the same shape and primitive */
+	gs_dyn_array(gs_immediate_instance_t) instances;
+	gsi_shape_type shape;
+	gs_graphics_primitive_type prim;
+} gs_immediate_instanced_t;
+
+#ifndef gsi_text_cache_size
+	#define gsi_text_cache_size 64	// Power of two
+#endif
+
+// Shaped text, positioned quads relative to the pen origin (y down), one segment per texture
+typedef struct gs_immediate_text_segment_t
+{
+	gs_handle(gs_graphics_texture_t) texture;
+	uint16_t page;			// SDF atlas page
+	uint16_t generation;	// SDF atlas page generation when shaped, run is reshaped once it changes
+	uint32_t count;			// Vertex count
+} gs_immediate_text_segment_t;
+
+typedef struct gs_immediate_text_run_t
+{
+	uint64_t key;			// Hash of text, font and size (0 if slot unused)
+	const void* font;
+	float size;
+	gs_dyn_array(char) text;	// Copy of the shaped string, a key match alone isn't a hit
+	gs_dyn_array(gs_immediate_vert_t) vertices;
+	gs_dyn_array(gs_immediate_text_segment_t) segments;
+} gs_immediate_text_run_t;
+
 typedef struct gs_immediate_draw_t
 {
 	/* Handle to vertex buffer resource */
@@ -119,6 +256,22 @@ typedef struct gs_immediate_draw_t
 	gs_immediate_cache_t cache;
 	/* Internal Command Buffer */
 	gs_command_buffer_t commands;
+	/* Deferred (sorted) draw queue */
+	gs_immediate_deferred_t deferred;
+	/* Retained unit shapes, indexed by [shape][is_triangles] */
+	gs_immediate_retained_mesh_t retained[_gs_gsi_shape_type_count][2];
+	/* Pipeline state matrix table for retained shapes */
+	gs_hash_table(gsi_pipeline_state_attr_t, gs_handle(gs_graphics_pipeline_t)) retained_pipeline_table;
+	/* Retained shape tint uniform */
+	gs_handle(gs_graphics_uniform_t) tint;
+	/* Instanced 2D shapes */
+	gs_immediate_instanced_t instanced;
+	/* Retained/instanced pipeline currently bound in place of the fill pipeline (invalid handle if none) */
+	gs_handle(gs_graphics_pipeline_t) bound_alt;
+	/* Context shared resources were taken from (recorders only, NULL otherwise) */
+	const struct gs_immediate_draw_t* parent;
+	/* Text layout cache, direct mapped by run key */
+	gs_immediate_text_run_t text_cache[gsi_text_cache_size];
 
 } gs_immediate_draw_t;
 
@@ -131,6 +284,7 @@ typedef struct gs_immediate_draw_t
 // Create / Init / Shutdown / Free
 GS_API_DECL gs_immediate_draw_t gs_immediate_draw_new();
 GS_API_DECL void                gs_immediate_draw_free(gs_immediate_draw_t* gsi);
+GS_API_DECL gs_immediate_draw_t gs_immediate_draw_new_recorder(const gs_immediate_draw_t* parent);
 
 // Get pipeline from state
 GS_API_DECL gs_handle(gs_graphics_pipeline_t) gsi_get_pipeline(gs_immediate_draw_t* gsi, gsi_pipeline_state_attr_t state);
@@ -153,11 +307,19 @@ GS_API_DECL void gsi_blend_enabled(gs_immediate_draw_t* gsi, bool enabled);
 GS_API_DECL void gsi_depth_enabled(gs_immediate_draw_t* gsi, bool enabled);
 GS_API_DECL void gsi_stencil_enabled(gs_immediate_draw_t* gsi, bool enabled);
 GS_API_DECL void gsi_face_cull_enabled(gs_immediate_draw_t* gsi, bool enabled);
+GS_API_DECL void gsi_sdf_enabled(gs_immediate_draw_t* gsi, bool enabled);
 GS_API_DECL void gsi_defaults(gs_immediate_draw_t* gsi);
 
+// Deferred draw queue (opt-in)
+GS_API_DECL void gsi_deferred_enabled(gs_immediate_draw_t* gsi, bool enabled);
+GS_API_DECL void gsi_layer(gs_immediate_draw_t* gsi, uint8_t layer);
+GS_API_DECL void gsi_sort_depth(gs_immediate_draw_t* gsi, float depth);
+GS_API_DECL void gsi_preserve_order(gs_immediate_draw_t* gsi, bool enabled);
+
 // Final Submit / Merge
 GS_API_DECL void gsi_draw(gs_immediate_draw_t* gsi, gs_command_buffer_t* cb);
 GS_API_DECL void gsi_render_pass_submit(gs_immediate_draw_t* gsi, gs_command_buffer_t* cb, gs_color_t clear_color);
+GS_API_DECL void gsi_merge(gs_immediate_draw_t* gsi, gs_immediate_draw_t** recorders, uint32_t count);
 
 // Core Matrix Functions
 GS_API_DECL void gsi_push_matrix(gs_immediate_draw_t* gsi, gsi_matrix_type type);
@@ -199,8 +361,19 @@ GS_API_DECL void gsi_box(gs_immediate_draw_t* gsi, float x0, float y0, float z0,
 GS_API_DECL void gsi_sphere(gs_immediate_draw_t* gsi, float cx, float cy, float cz, float radius, uint8_t r, uint8_t g, uint8_t b, uint8_t a, gs_graphics_primitive_type type);
 GS_API_DECL void gsi_bezier(gs_immediate_draw_t* gsi, float x0, float y0, float x1, float y1, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 
+// Retained Shape Drawing Util (unit shape transformed by model and current matrices, no trig). Shapes under
+// gsi_retained_min_vertices are expanded into the vertex stream so runs of them batch, larger ones get their own draw
+GS_API_DECL void gsi_shape(gs_immediate_draw_t* gsi, gsi_shape_type shape, gs_mat4 model, gs_color_t color, gs_graphics_primitive_type type);
+
+// Instanced Shape Drawing Util (one gs_immediate_instance_t per shape, consecutive calls of same shape/primitive batch into one draw)
+GS_API_DECL void gsi_rect_instanced(gs_immediate_draw_t* gsi, gs_vec2 xy, gs_vec2 wh, gs_vec2 uv0, gs_vec2 uv1, gs_color_t color, gs_graphics_primitive_type type);
+GS_API_DECL void gsi_line_instanced(gs_immediate_draw_t* gsi, gs_vec2 v0, gs_vec2 v1, gs_color_t color);
+GS_API_DECL void gsi_circle_instanced(gs_immediate_draw_t* gsi, gs_vec2 c, float radius, gs_color_t color, gs_graphics_primitive_type type);
+
 // Text Drawing Util
 GS_API_DECL void gsi_text(gs_immediate_draw_t* gsi, float x, float y, const char* text, const gs_asset_font_t* fp, bool32_t flip_vertical, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+// Mutates fp (glyph cache, atlas), don't draw the same font from several recorder threads at once
+GS_API_DECL void gsi_text_sdf(gs_immediate_draw_t* gsi, float x, float y, const char* text, gs_asset_sdf_font_t* fp, float size, bool32_t flip_vertical, uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 
 // Private Internal Utilities (Not user facing)
 GS_API_DECL const char* GetDefaultCompressedFontDataTTFBase85();
@@ -214,6 +387,14 @@ GS_API_DECL void Decode85(const unsigned char* src, unsigned char* dst);
     #define gsi_smooth_circle_error_rate  0.5f
 #endif
 
+#ifndef gsi_retained_circle_segments
+    #define gsi_retained_circle_segments  64
+#endif
+
+#ifndef gsi_retained_min_vertices
+    #define gsi_retained_min_vertices     256     // Boxes and circles batch, spheres are drawn from their buffer
+#endif
+
 const f32 gsi_deg2rad = (f32)GS_PI / 180.f;
 
 const char* gsi_v_fillsrc = "\n"
@@ -230,6 +411,37 @@ const char* gsi_v_fillsrc = "\n"
 "  color = a_color;\n"
 "}\n";
 
+const char* gsi_v_retainedsrc = "\n"
+"#version 330\n"
+"layout(location = 0) in vec3 a_position;\n"
+"layout(location = 1) in vec2 a_uv;\n"
+"layout(location = 2) in vec4 a_color;\n"
+"uniform mat4 u_mvp;\n"
+"uniform vec4 u_tint;\n"
+"out vec2 uv;\n"
+"out vec4 color;\n"
+"void main() {\n"
+"  gl_Position = u_mvp * vec4(a_position, 1.0);\n"
+"  uv = a_uv;\n"
+"  color = a_color * u_tint;\n"
+"}\n";
+
+const char* gsi_v_instancedsrc = "\n"
+"#version 330\n"
+"layout(location = 0) in vec3 a_position;\n"
+"layout(location = 1) in vec2 a_uv;\n"
+"layout(location = 2) in vec4 a_rect;\n"
+"layout(location = 3) in vec4 a_uvrect;\n"
+"layout(location = 4) in vec4 a_color;\n"
+"uniform mat4 u_mvp;\n"
+"out vec2 uv;\n"
+"out vec4 color;\n"
+"void main() {\n"
+"  gl_Position = u_mvp * vec4(a_rect.xy + a_position.xy * a_rect.zw, a_position.z, 1.0);\n"
+"  uv = mix(a_uvrect.xy, a_uvrect.zw, a_uv);\n"
+"  color = a_color;\n"
+"}\n";
+
 const char* gsi_f_fillsrc = "\n"
  "#version 330\n"
 "in vec2 uv;\n"
@@ -240,6 +452,18 @@ const char* gsi_f_fillsrc = "\n"
 "  frag_color = color * texture(u_tex, uv);\n"
 "}\n";
 
+const char* gsi_f_sdfsrc = "\n"
+ "#version 330\n"
+"in vec2 uv;\n"
+"in vec4 color;\n"
+"uniform sampler2D u_tex;\n"
+"out vec4 frag_color;\n"
+"void main() {\n"
+"  float d = texture(u_tex, uv).r;\n"
+"  float w = max(fwidth(d), 1e-4);\n"
+"  frag_color = vec4(color.rgb, color.a * smoothstep(0.5 - w, 0.5 + w, d));\n"
+"}\n";
+
 gsi_pipeline_state_attr_t gsi_pipeline_state_default()
 {
 	gsi_pipeline_state_attr_t attr = gs_default_val();
@@ -248,6 +472,7 @@ gsi_pipeline_state_attr_t gsi_pipeline_state_default()
 	attr.blend_enabled = true;
 	attr.face_cull_enabled = false;
 	attr.prim_type = (uint16_t)GS_GRAPHICS_PRIMITIVE_TRIANGLES;
+	attr.sdf_enabled = false;
 	return attr;
 }
 
@@ -270,6 +495,176 @@ void gsi_reset(gs_immediate_draw_t* gsi)
 	gsi->cache.pipeline.prim_type = 0x00;
 	gsi->cache.uv = gs_v2(0.f, 0.f);
 	gsi->cache.color = GS_COLOR_WHITE;
+	gsi->cache.layer = 0;
+	gsi->cache.sort_depth = 0.f;
+	gsi->cache.preserve_order = false;
+	gsi->bound_alt = gs_handle_invalid(gs_graphics_pipeline_t);
+
+	gs_dyn_array_clear(gsi->deferred.entries);
+	gs_dyn_array_clear(gsi->deferred.vertices);
+	gsi->deferred.sequence = 0;
+	gs_dyn_array_clear(gsi->instanced.instances);
+}
+
+void gsi_retained_line(gs_dyn_array(gs_immediate_vert_t)* lines, gs_vec3 p0, gs_vec3 p1)
+{
+	gs_immediate_vert_t v = gs_default_val();
+	v.color = GS_COLOR_WHITE;
+	v.position = p0; gs_dyn_array_push(*lines, v);
+	v.position = p1; gs_dyn_array_push(*lines, v);
+}
+
+void gsi_retained_tri(gs_dyn_array(gs_immediate_vert_t)* tris, gs_dyn_array(gs_immediate_vert_t)* lines, 
+	gs_vec3 p0, gs_vec3 p1, gs_vec3 p2, gs_vec2 uv0, gs_vec2 uv1, gs_vec2 uv2)
+{
+	gs_immediate_vert_t v = gs_default_val();
+	v.color = GS_COLOR_WHITE;
+	v.position = p0; v.uv = uv0; gs_dyn_array_push(*tris, v);
+	v.position = p1; v.uv = uv1; gs_dyn_array_push(*tris, v);
+	v.position = p2; v.uv = uv2; gs_dyn_array_push(*tris, v);
+
+	// Outline, same as gsi_trianglex() with GS_GRAPHICS_PRIMITIVE_LINES
+	if (lines) {
+		gsi_retained_line(lines, p0, p1);
+		gsi_retained_line(lines, p1, p2);
+		gsi_retained_line(lines, p2, p0);
+	}
+}
+
+// Unit shapes match the geometry the immediate versions of gsi_sphere(), gsi_box() and gsi_circle() generate
+void gsi_retained_init(gs_immediate_draw_t* gsi)
+{
+	// Sphere: radius 1, centered at origin
+	{
+		gs_dyn_array(gs_immediate_vert_t)* lines = &gsi->retained[GSI_SHAPE_SPHERE][0].vertices;
+		gs_dyn_array(gs_immediate_vert_t)* tris = &gsi->retained[GSI_SHAPE_SPHERE][1].vertices;
+		const uint32_t stacks = 16;
+		const uint32_t sectors = 32; 
+		float sector_step = 2.f * (float)GS_PI / (float)sectors;
+		float stack_step = (float)GS_PI / (float)stacks;
+
+		#define sphere_vert(P, UV, I, J)\
+			do {\
+				float sa = GS_PI / 2.f - (I) * stack_step;\
+				float sca = (J) * sector_step;\
+				P = gs_v3(cosf(sa) * cosf(sca), sinf(sa), cosf(sa) * sinf(sca));\
+				UV = gs_v2((float)(J) / sectors, (float)(I) / stacks);\
+			} while (0)
+
+		for (uint32_t i = 0; i < stacks; ++i)
+		{
+			for (uint32_t j = 0; j < sectors; ++j)
+			{
+				gs_vec3 p0, p1, p2, p3;
+				gs_vec2 uv0, uv1, uv2, uv3;
+				sphere_vert(p0, uv0, i, j);
+				sphere_vert(p1, uv1, i, j + 1);
+				sphere_vert(p2, uv2, i + 1, j);
+				sphere_vert(p3, uv3, i + 1, j + 1);
+				gsi_retained_tri(tris, lines, p0, p3, p2, uv0, uv3, uv2);
+				gsi_retained_tri(tris, lines, p0, p1, p3, uv0, uv1, uv3);
+			}
+		}
+
+		#undef sphere_vert
+	}
+
+	// Box: unit extents, centered at origin
+	{
+		gs_dyn_array(gs_immediate_vert_t)* lines = &gsi->retained[GSI_SHAPE_BOX][0].vertices;
+		gs_dyn_array(gs_immediate_vert_t)* tris = &gsi->retained[GSI_SHAPE_BOX][1].vertices;
+
+		gs_vec3 v0 = gs_v3(-0.5f, -0.5f,  0.5f);
+		gs_vec3 v1 = gs_v3( 0.5f, -0.5f,  0.5f);
+		gs_vec3 v2 = gs_v3(-0.5f,  0.5f,  0.5f);
+		gs_vec3 v3 = gs_v3( 0.5f,  0.5f,  0.5f);
+		gs_vec3 v4 = gs_v3(-0.5f, -0.5f, -0.5f);
+		gs_vec3 v5 = gs_v3(-0.5f,  0.5f, -0.5f);
+		gs_vec3 v6 = gs_v3( 0.5f, -0.5f, -0.5f);
+		gs_vec3 v7 = gs_v3( 0.5f,  0.5f, -0.5f);
+
+		gs_vec2 uv0 = gs_v2(0.f, 0.f);
+		gs_vec2 uv1 = gs_v2(1.f, 0.f);
+		gs_vec2 uv2 = gs_v2(0.f, 1.f);
+		gs_vec2 uv3 = gs_v2(1.f, 1.f);
+
+		gsi_retained_tri(tris, NULL, v0, v1, v2, uv0, uv1, uv2);
+		gsi_retained_tri(tris, NULL, v3, v2, v1, uv3, uv2, uv1);
+		gsi_retained_tri(tris, NULL, v6, v5, v7, uv0, uv3, uv2);
+		gsi_retained_tri(tris, NULL, v6, v4, v5, uv0, uv1, uv3);
+		gsi_retained_tri(tris, NULL, v7, v2, v3, uv0, uv3, uv2);
+		gsi_retained_tri(tris, NULL, v7, v5, v2, uv0, uv1, uv3);
+		gsi_retained_tri(tris, NULL, v4, v1, v0, uv0, uv3, uv2);
+		gsi_retained_tri(tris, NULL, v4, v6, v1, uv0, uv1, uv3);
+		gsi_retained_tri(tris, NULL, v1, v7, v3, uv0, uv3, uv2);
+		gsi_retained_tri(tris, NULL, v1, v6, v7, uv0, uv1, uv3);
+		gsi_retained_tri(tris, NULL, v4, v2, v5, uv0, uv3, uv2);
+		gsi_retained_tri(tris, NULL, v4, v0, v2, uv0, uv1, uv3);
+
+		gs_vec3 edges[] = {
+			v0, v1, v1, v3, v3, v2, v2, v0,
+			v4, v6, v6, v7, v7, v5, v5, v4,
+			v1, v6, v6, v7, v7, v3, v3, v1,
+			v4, v6, v6, v1, v1, v0, v0, v4,
+			v5, v7, v7, v3, v3, v2, v2, v5,
+			v0, v4, v4, v5, v5, v2, v2, v0
+		};
+		for (uint32_t i = 0; i < sizeof(edges) / sizeof(gs_vec3); i += 2) {
+			gsi_retained_line(lines, edges[i], edges[i + 1]);
+		}
+	}
+
+	// Circle: radius 1, centered at origin, in xy plane
+	{
+		gs_dyn_array(gs_immediate_vert_t)* lines = &gsi->retained[GSI_SHAPE_CIRCLE][0].vertices;
+		gs_dyn_array(gs_immediate_vert_t)* tris = &gsi->retained[GSI_SHAPE_CIRCLE][1].vertices;
+		gs_vec2 uv = gs_v2(0.f, 0.f);
+		float step = 360.f / (float)gsi_retained_circle_segments;
+		for (uint32_t i = 0; i < gsi_retained_circle_segments; ++i)
+		{
+			float angle = step * (float)i;
+			gs_vec3 a = gs_v3(0.f, 0.f, 0.f);
+			gs_vec3 b = gs_v3(sinf(gsi_deg2rad * angle), cosf(gsi_deg2rad * angle), 0.f);
+			gs_vec3 c = gs_v3(sinf(gsi_deg2rad * (angle + step)), cosf(gsi_deg2rad * (angle + step)), 0.f);
+			gsi_retained_tri(tris, lines, a, b, c, uv, uv, uv);
+		}
+	}
+
+	// Rect: unit square [0, 1], uv matches position
+	{
+		gs_dyn_array(gs_immediate_vert_t)* lines = &gsi->retained[GSI_SHAPE_RECT][0].vertices;
+		gs_dyn_array(gs_immediate_vert_t)* tris = &gsi->retained[GSI_SHAPE_RECT][1].vertices;
+		gs_vec3 bl = gs_v3(0.f, 0.f, 0.f), br = gs_v3(1.f, 0.f, 0.f), tl = gs_v3(0.f, 1.f, 0.f), tr = gs_v3(1.f, 1.f, 0.f);
+		gsi_retained_tri(tris, NULL, bl, br, tl, gs_v2(0.f, 0.f), gs_v2(1.f, 0.f), gs_v2(0.f, 1.f));
+		gsi_retained_tri(tris, NULL, br, tr, tl, gs_v2(1.f, 0.f), gs_v2(1.f, 1.f), gs_v2(0.f, 1.f));
+		gsi_retained_line(lines, bl, br);
+		gsi_retained_line(lines, br, tr);
+		gsi_retained_line(lines, tr, tl);
+		gsi_retained_line(lines, tl, bl);
+	}
+
+	// Line: (0, 0) -> (1, 1), scaled by delta
+	{
+		gsi_retained_line(&gsi->retained[GSI_SHAPE_LINE][0].vertices, gs_v3(0.f, 0.f, 0.f), gs_v3(1.f, 1.f, 0.f));
+	}
+
+	// Upload to static vertex buffers
+	for (uint32_t s = 0; s < _gs_gsi_shape_type_count; ++s)
+	{
+		for (uint32_t t = 0; t < 2; ++t)
+		{
+			gs_immediate_retained_mesh_t* m = &gsi->retained[s][t];
+			if (!gs_dyn_array_size(m->vertices)) {
+				continue;
+			}
+
+			gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
+			vdesc.data = m->vertices;
+			vdesc.size = gs_dyn_array_size(m->vertices) * sizeof(gs_immediate_vert_t);
+			vdesc.usage = GS_GRAPHICS_BUFFER_USAGE_STATIC;
+			m->vbo = gs_graphics_vertex_buffer_create(&vdesc);
+		}
+	}
 }
 
 // Create / Init / Shutdown / Free
@@ -298,6 +693,13 @@ gs_immediate_draw_t gs_immediate_draw_new()
 	sbdesc.layout = &sldesc;
 	gsi.sampler = gs_graphics_uniform_create(&sbdesc); 
 
+	// Create tint uniform (retained shapes)
+	gs_graphics_uniform_layout_desc_t tldesc = {.type = GS_GRAPHICS_UNIFORM_VEC4};
+	gs_graphics_uniform_desc_t tdesc_u = gs_default_val();
+	tdesc_u.name = "u_tint";
+	tdesc_u.layout = &tldesc;
+	gsi.tint = gs_graphics_uniform_create(&tdesc_u);
+
 	// Create vertex buffer 
 	gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
 	vdesc.data = NULL;
@@ -342,12 +744,65 @@ gs_immediate_draw_t gs_immediate_draw_new()
 	// Iterate through attribute list, then create custom pipelines requested.
 	gs_handle(gs_graphics_shader_t) shader = gs_graphics_shader_create(&sdesc);
 
+	// Distance field variants of each shader (same vertex stage)
+	gs_graphics_shader_source_desc_t sdfsrc; sdfsrc.type = GS_GRAPHICS_SHADER_STAGE_FRAGMENT; sdfsrc.source = gsi_f_sdfsrc;
+	gs_graphics_shader_source_desc_t gsi_sdf_sources[] = {
+		vsrc, sdfsrc
+	};
+	sdesc.sources = gsi_sdf_sources;
+	sdesc.size = sizeof(gsi_sdf_sources);
+	sdesc.name = "gs_immediate_sdf_shader";
+	gs_handle(gs_graphics_shader_t) sdf_shader = gs_graphics_shader_create(&sdesc);
+
+	// Retained shape shader (same layout, tinted)
+	gs_graphics_shader_source_desc_t rvsrc; rvsrc.type = GS_GRAPHICS_SHADER_STAGE_VERTEX; rvsrc.source = gsi_v_retainedsrc;
+	gs_graphics_shader_source_desc_t gsi_retained_sources[] = {
+		rvsrc, fsrc
+	};
+	sdesc.sources = gsi_retained_sources;
+	sdesc.size = sizeof(gsi_retained_sources);
+	sdesc.name = "gs_immediate_retained_shader";
+	gs_handle(gs_graphics_shader_t) retained_shader = gs_graphics_shader_create(&sdesc);
+	gsi_retained_sources[1] = sdfsrc;
+	sdesc.name = "gs_immediate_retained_sdf_shader";
+	gs_handle(gs_graphics_shader_t) retained_sdf_shader = gs_graphics_shader_create(&sdesc);
+
+	// Instanced shape shader
+	gs_graphics_shader_source_desc_t ivsrc; ivsrc.type = GS_GRAPHICS_SHADER_STAGE_VERTEX; ivsrc.source = gsi_v_instancedsrc;
+	gs_graphics_shader_source_desc_t gsi_instanced_sources[] = {
+		ivsrc, fsrc
+	};
+	sdesc.sources = gsi_instanced_sources;
+	sdesc.size = sizeof(gsi_instanced_sources);
+	sdesc.name = "gs_immediate_instanced_shader";
+	gs_handle(gs_graphics_shader_t) instanced_shader = gs_graphics_shader_create(&sdesc);
+	gsi_instanced_sources[1] = sdfsrc;
+	sdesc.name = "gs_immediate_instanced_sdf_shader";
+	gs_handle(gs_graphics_shader_t) instanced_sdf_shader = gs_graphics_shader_create(&sdesc);
+
+	// Instanced layout: base shape vertex (buffer 0), instance record (buffer 1)
+	const size_t vsz = sizeof(gs_immediate_vert_t);
+	const size_t isz = sizeof(gs_immediate_instance_t);
+    gs_graphics_vertex_attribute_desc_t gsi_instanced_vattrs[] = {
+        (gs_graphics_vertex_attribute_desc_t){.format = GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT3, .stride = vsz, .offset = gs_offset(gs_immediate_vert_t, position), .buffer_idx = 0},
+        (gs_graphics_vertex_attribute_desc_t){.format = GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT2, .stride = vsz, .offset = gs_offset(gs_immediate_vert_t, uv), .buffer_idx = 0},
+        (gs_graphics_vertex_attribute_desc_t){.format = GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT4, .stride = isz, .offset = gs_offset(gs_immediate_instance_t, rect), .divisor = 1, .buffer_idx = 1},
+        (gs_graphics_vertex_attribute_desc_t){.format = GS_GRAPHICS_VERTEX_ATTRIBUTE_FLOAT4, .stride = isz, .offset = gs_offset(gs_immediate_instance_t, uv), .divisor = 1, .buffer_idx = 1},
+        (gs_graphics_vertex_attribute_desc_t){.format = GS_GRAPHICS_VERTEX_ATTRIBUTE_BYTE4, .stride = isz, .offset = gs_offset(gs_immediate_instance_t, color), .divisor = 1, .buffer_idx = 1}
+    };
+
+	// Instance stream buffer
+	gs_graphics_vertex_buffer_desc_t ivdesc = gs_default_val();
+	ivdesc.usage = GS_GRAPHICS_BUFFER_USAGE_STREAM;
+	gsi.instanced.vbo = gs_graphics_vertex_buffer_create(&ivdesc);
+
 	// Pipelines
 	for (uint16_t d = 0; d < 2; ++d) // Depth
 		for (uint16_t s = 0; s < 2; ++s) // Stencil
 			for (uint16_t b = 0; b < 2; ++b) // Blend
 				for (uint16_t f = 0; f < 2; ++f) // Face Cull
 					for (uint16_t p = 0; p < 2; ++p) // Prim Type
+						for (uint16_t t = 0; t < 2; ++t) // SDF
 	{
 		gsi_pipeline_state_attr_t attr = gs_default_val();
 
@@ -356,10 +811,11 @@ gs_immediate_draw_t gs_immediate_draw_new()
 		attr.blend_enabled 		= b;
 		attr.face_cull_enabled  = f;
 		attr.prim_type 			= p ? (uint16_t)GS_GRAPHICS_PRIMITIVE_TRIANGLES : (uint16_t)GS_GRAPHICS_PRIMITIVE_LINES;
+		attr.sdf_enabled 		= t;
 
 		// Create new pipeline based on this arrangement
 		gs_graphics_pipeline_desc_t pdesc = gs_default_val();
-		pdesc.raster.shader = shader;
+		pdesc.raster.shader = t ? sdf_shader : shader;
 		pdesc.raster.index_buffer_element_size = sizeof(uint16_t);
 		pdesc.raster.face_culling = attr.face_cull_enabled ? GS_GRAPHICS_FACE_CULLING_BACK : (gs_graphics_face_culling_type)0x00;
 		pdesc.raster.primitive = (gs_graphics_primitive_type)attr.prim_type; 
@@ -372,8 +828,21 @@ gs_immediate_draw_t gs_immediate_draw_new()
 
 		gs_handle(gs_graphics_pipeline_t) hndl = gs_graphics_pipeline_create(&pdesc);
 		gs_hash_table_insert(gsi.pipeline_table, attr, hndl);
+
+		pdesc.raster.shader = t ? retained_sdf_shader : retained_shader;
+		hndl = gs_graphics_pipeline_create(&pdesc);
+		gs_hash_table_insert(gsi.retained_pipeline_table, attr, hndl);
+
+		pdesc.raster.shader = t ? instanced_sdf_shader : instanced_shader;
+		pdesc.layout.attrs = gsi_instanced_vattrs;
+		pdesc.layout.size = sizeof(gsi_instanced_vattrs);
+		hndl = gs_graphics_pipeline_create(&pdesc);
+		gs_hash_table_insert(gsi.instanced.pipeline_table, attr, hndl);
 	} 
 
+	// Generate retained unit shapes
+	gsi_retained_init(&gsi);
+
 	// Create default font
 	gs_asset_font_t* f = &gsi.font_default;
 	stbtt_fontinfo font = gs_default_val();
@@ -434,16 +903,87 @@ gs_immediate_draw_t gs_immediate_draw_new()
 	return gsi;
 }
 
+gs_immediate_draw_t gs_immediate_draw_new_recorder(const gs_immediate_draw_t* parent)
+{
+	gs_immediate_draw_t gsi = gs_default_val();
+	memset(&gsi, 0, sizeof(gsi));
+	gsi.parent = parent;
+
+	// Shared resources (read-only, owned by parent)
+	gsi.vbo = parent->vbo;
+	gsi.ibo = parent->ibo;
+	gsi.tex_default = parent->tex_default;
+	gsi.font_default = parent->font_default;
+	gsi.pipeline_table = parent->pipeline_table;
+	gsi.uniform = parent->uniform;
+	gsi.sampler = parent->sampler;
+	gsi.tint = parent->tint;
+	memcpy(gsi.retained, parent->retained, sizeof(gsi.retained));
+	gsi.retained_pipeline_table = parent->retained_pipeline_table;
+	gsi.instanced.vbo = parent->instanced.vbo;
+	gsi.instanced.pipeline_table = parent->instanced.pipeline_table;
+
+	// Recorder owned
+	gsi.cache.color = GS_COLOR_WHITE;
+	gsi.commands = gs_command_buffer_new();
+	gsi_reset(&gsi);
+
+	return gsi;
+}
+
 void gs_immediate_draw_free(gs_immediate_draw_t* gsi)
 {
-	// Free all data
+	gs_command_buffer_free(&gsi->commands);
+	gs_dyn_array_free(gsi->vertices);
+	gs_dyn_array_free(gsi->indices);
+	gs_dyn_array_free(gsi->cache.pipelines);
+	gs_dyn_array_free(gsi->cache.modelview);
+	gs_dyn_array_free(gsi->cache.projection);
+	gs_dyn_array_free(gsi->cache.modes);
+	gs_dyn_array_free(gsi->deferred.entries);
+	gs_dyn_array_free(gsi->deferred.vertices);
+	gs_dyn_array_free(gsi->deferred.sorted);
+	gs_dyn_array_free(gsi->deferred.batches);
+	gs_dyn_array_free(gsi->deferred.order);
+	gs_dyn_array_free(gsi->deferred.scratch);
+	gs_dyn_array_free(gsi->instanced.instances);
+	for (uint32_t i = 0; i < gsi_text_cache_size; ++i) {
+		gs_dyn_array_free(gsi->text_cache[i].text);
+		gs_dyn_array_free(gsi->text_cache[i].vertices);
+		gs_dyn_array_free(gsi->text_cache[i].segments);
+	}
+
+	// Shared data belongs to the context recorders were created from
+	if (!gsi->parent) 
+	{
+		gs_hash_table_free(gsi->pipeline_table);
+		gs_hash_table_free(gsi->retained_pipeline_table);
+		gs_hash_table_free(gsi->instanced.pipeline_table);
+		for (uint32_t s = 0; s < _gs_gsi_shape_type_count; ++s) {
+			gs_dyn_array_free(gsi->retained[s][0].vertices);
+			gs_dyn_array_free(gsi->retained[s][1].vertices);
+		}
+	}
+
+	// GPU resources are left to the graphics backend shutdown
+	memset(gsi, 0, sizeof(gs_immediate_draw_t));
+}
+
+// Read-only pipeline table lookup. gs_hash_table_get() writes the table's tmp_key, which races when 
+// recorders on several threads share one table.
+uint32_t gsi_pipeline_table_index(void** data, size_t stride, size_t klpvl, gsi_pipeline_state_attr_t attr)
+{
+	uint32_t idx = gs_hash_table_get_key_index_func(data, &attr, sizeof(attr), sizeof(gs_handle(gs_graphics_pipeline_t)), stride, klpvl);
+	gs_assert(idx != GS_HASH_TABLE_INVALID_INDEX);
+	return idx;
 }
 
+#define gsi_pipeline_table_find(__HT, __ATTR)\
+	gs_hash_table_geti((__HT), gsi_pipeline_table_index((void**)&(__HT)->data, (__HT)->stride, (__HT)->klpvl, (__ATTR)))
+
 gs_handle(gs_graphics_pipeline_t) gsi_get_pipeline(gs_immediate_draw_t* gsi, gsi_pipeline_state_attr_t state)
 {
-	// Bind pipeline
-	gs_assert(gs_hash_table_key_exists(gsi->pipeline_table, state));
-	return gs_hash_table_get(gsi->pipeline_table, state);
+	return gsi_pipeline_table_find(gsi->pipeline_table, state);
 }
 
 void gs_immediate_draw_set_pipeline(gs_immediate_draw_t* gsi)
@@ -457,15 +997,275 @@ void gs_immediate_draw_set_pipeline(gs_immediate_draw_t* gsi)
 	gsi->cache.pipeline.stencil_enabled = gs_clamp(gsi->cache.pipeline.stencil_enabled, 0, 1);
 	gsi->cache.pipeline.face_cull_enabled = gs_clamp(gsi->cache.pipeline.face_cull_enabled, 0, 1);
 	gsi->cache.pipeline.blend_enabled = gs_clamp(gsi->cache.pipeline.blend_enabled, 0, 1);
+	gsi->cache.pipeline.sdf_enabled = gs_clamp(gsi->cache.pipeline.sdf_enabled, 0, 1);
 
-	// Bind pipeline
-	gs_assert(gs_hash_table_key_exists(gsi->pipeline_table, gsi->cache.pipeline));
-	gs_graphics_bind_pipeline(&gsi->commands, gs_hash_table_get(gsi->pipeline_table, gsi->cache.pipeline));
+	// Bind pipeline (deferred draws bind their pipeline at submit)
+	gs_handle(gs_graphics_pipeline_t) pip = gsi_get_pipeline(gsi, gsi->cache.pipeline);
+	if (gsi->deferred.enabled) {
+		return;
+	}
+	gs_graphics_bind_pipeline(&gsi->commands, pip);
+	gsi->bound_alt = gs_handle_invalid(gs_graphics_pipeline_t);
+}
+
+/* Deferred Draw Queue */
+void gsi_vert_append(gs_dyn_array(gs_immediate_vert_t)* arr, const gs_immediate_vert_t* verts, uint32_t count)
+{
+	uint32_t sz = gs_dyn_array_size(*arr);
+	uint32_t need = sz + count + 1;
+	if (need > (uint32_t)gs_dyn_array_capacity(*arr)) {
+		gs_dyn_array_reserve(*arr, gs_max(need, 2 * (uint32_t)gs_dyn_array_capacity(*arr)));
+	}
+	memcpy(*arr + sz, verts, count * sizeof(gs_immediate_vert_t));
+	gs_dyn_array_head(*arr)->size = sz + count;
+}
+
+uint64_t gsi_deferred_sort_key(gs_immediate_draw_t* gsi)
+{
+	uint64_t key = (uint64_t)gsi->cache.layer << 56;
+
+	// Ordered: submit in call order, after the layer's unordered draws
+	if (gsi->cache.preserve_order) {
+		return key | ((uint64_t)1 << 55) | (uint64_t)gsi->deferred.sequence;
+	}
+
+	gsi_pipeline_state_attr_t* p = &gsi->cache.pipeline;
+	uint64_t pip = (uint64_t)(
+		(p->sdf_enabled << 5) | 
+		(p->depth_enabled << 4) | 
+		(p->stencil_enabled << 3) | 
+		(p->blend_enabled << 2) | 
+		(p->face_cull_enabled << 1) | 
+		(p->prim_type == (uint16_t)GS_GRAPHICS_PRIMITIVE_LINES)
+	);
+
+	// Flip float bits so that depth compares as an unsigned integer (ascending, front to back)
+	uint32_t d = 0;
+	memcpy(&d, &gsi->cache.sort_depth, sizeof(d));
+	d = (d & 0x80000000) ? ~d : (d | 0x80000000);
+
+	return key | (pip << 49) | ((uint64_t)(gsi->cache.texture.id & 0x1FFFF) << 32) | (uint64_t)d;
+}
+
+void gsi_deferred_record(gs_immediate_draw_t* gsi, const gs_mat4* mvp)
+{
+	gs_immediate_deferred_t* dq = &gsi->deferred;
+
+	gs_immediate_draw_entry_t e = gs_default_val();
+	e.key = gsi_deferred_sort_key(gsi);
+	e.pipeline = gsi->cache.pipeline;
+	e.texture = gsi->cache.texture;
+	e.mvp = *mvp;
+	e.start = gs_dyn_array_size(dq->vertices);
+	e.count = gs_dyn_array_size(gsi->vertices);
+
+	gsi_vert_append(&dq->vertices, gsi->vertices, e.count);
+	gs_dyn_array_push(dq->entries, e);
+	dq->sequence++;
+}
+
+// Stable LSD radix sort of entry indices by key, 8 bits per pass
+void gsi_deferred_sort(gs_immediate_deferred_t* dq)
+{
+	uint32_t ct = gs_dyn_array_size(dq->entries);
+	gs_dyn_array_reserve(dq->order, ct + 1);
+	gs_dyn_array_reserve(dq->scratch, ct + 1);
+
+	uint32_t* src = dq->order;
+	uint32_t* dst = dq->scratch;
+	for (uint32_t i = 0; i < ct; ++i) {
+		src[i] = i;
+	}
+
+	for (uint32_t shift = 0; shift < 64; shift += 8)
+	{
+		uint32_t hist[256] = gs_default_val();
+		for (uint32_t i = 0; i < ct; ++i) {
+			hist[(dq->entries[i].key >> shift) & 0xFF]++;
+		}
+
+		// Every key shares this byte, nothing to do for this pass
+		if (hist[(dq->entries[0].key >> shift) & 0xFF] == ct) {
+			continue;
+		}
+
+		uint32_t sum = 0;
+		for (uint32_t b = 0; b < 256; ++b) {
+			uint32_t c = hist[b];
+			hist[b] = sum;
+			sum += c;
+		}
+
+		for (uint32_t i = 0; i < ct; ++i) {
+			dst[hist[(dq->entries[src[i]].key >> shift) & 0xFF]++] = src[i];
+		}
+
+		uint32_t* tmp = src; src = dst; dst = tmp;
+	}
+
+	if (src != dq->order) {
+		memcpy(dq->order, src, ct * sizeof(uint32_t));
+	}
+}
+
+bool gsi_deferred_can_merge(const gs_immediate_draw_entry_t* a, const gs_immediate_draw_entry_t* b)
+{
+	return a->texture.id == b->texture.id && 
+		memcmp(&a->pipeline, &b->pipeline, sizeof(gsi_pipeline_state_attr_t)) == 0 && 
+		memcmp(&a->mvp, &b->mvp, sizeof(gs_mat4)) == 0;
+}
+
+void gsi_deferred_submit(gs_immediate_draw_t* gsi)
+{
+	gs_immediate_deferred_t* dq = &gsi->deferred;
+	uint32_t ct = gs_dyn_array_size(dq->entries);
+	if (!ct) {
+		return;
+	}
+
+	gsi_deferred_sort(dq);
+
+	// Rebuild vertex data in sorted order, merging neighbors with matching state into batches
+	gs_dyn_array_clear(dq->sorted);
+	gs_dyn_array_clear(dq->batches);
+	for (uint32_t i = 0; i < ct; ++i)
+	{
+		uint32_t ei = dq->order[i];
+		gs_immediate_draw_entry_t* e = &dq->entries[ei];
+		uint32_t start = gs_dyn_array_size(dq->sorted);
+		gsi_vert_append(&dq->sorted, dq->vertices + e->start, e->count);
+
+		if (!gs_dyn_array_empty(dq->batches)) 
+		{
+			gs_immediate_batch_t* b = &gs_dyn_array_back(dq->batches);
+			if (gsi_deferred_can_merge(&dq->entries[b->entry], e)) {
+				b->count += e->count;
+				continue;
+			}
+		}
+
+		gs_immediate_batch_t b = {.entry = ei, .start = start, .count = e->count};
+		gs_dyn_array_push(dq->batches, b);
+	}
+
+	// Single upload for all batches
+	gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
+	vdesc.data = dq->sorted;
+	vdesc.size = gs_dyn_array_size(dq->sorted) * sizeof(gs_immediate_vert_t);
+	vdesc.usage = GS_GRAPHICS_BUFFER_USAGE_STREAM;
+	gs_graphics_vertex_buffer_request_update(&gsi->commands, gsi->vbo, &vdesc);
+
+	gs_graphics_bind_vertex_buffer_desc_t vbuffer = gs_default_val();
+	vbuffer.buffer = gsi->vbo;
+
+	const gsi_pipeline_state_attr_t* bound = NULL;
+	gsi->bound_alt = gs_handle_invalid(gs_graphics_pipeline_t);
+	for (uint32_t i = 0; i < gs_dyn_array_size(dq->batches); ++i)
+	{
+		gs_immediate_batch_t* b = &dq->batches[i];
+		gs_immediate_draw_entry_t* e = &dq->entries[b->entry];
+
+		// Only rebind pipeline on state change
+		if (!bound || memcmp(bound, &e->pipeline, sizeof(gsi_pipeline_state_attr_t)) != 0) {
+			gs_graphics_bind_pipeline(&gsi->commands, gsi_get_pipeline(gsi, e->pipeline));
+			bound = &e->pipeline;
+		}
+
+		gs_graphics_bind_uniform_desc_t ubinds[] = {
+			{.uniform = gsi->uniform, .data = &e->mvp},
+			{.uniform = gsi->sampler, .data = &e->texture}
+		};
+
+		gs_graphics_bind_desc_t binds = gs_default_val();
+		binds.vertex_buffers.desc = &vbuffer; 
+		binds.uniforms.desc = ubinds;
+		binds.uniforms.size = sizeof(ubinds);
+		gs_graphics_apply_bindings(&gsi->commands, &binds);
+
+		gs_graphics_draw(&gsi->commands, &(gs_graphics_draw_desc_t){.start = b->start, .count = b->count});
+	}
+
+	gs_dyn_array_clear(dq->entries);
+	gs_dyn_array_clear(dq->vertices);
+	dq->sequence = 0;
+}
+
+/* Instanced Shapes */
+void gsi_instance_flush(gs_immediate_draw_t* gsi)
+{
+	gs_immediate_instanced_t* inst = &gsi->instanced;
+	uint32_t ct = gs_dyn_array_size(inst->instances);
+	if (!ct) {
+		return;
+	}
+
+	gs_immediate_retained_mesh_t* base = &gsi->retained[inst->shape][inst->prim == GS_GRAPHICS_PRIMITIVE_TRIANGLES];
+
+	gs_mat4 mv = gsi->cache.modelview[gs_dyn_array_size(gsi->cache.modelview) - 1];
+	gs_mat4 proj = gsi->cache.projection[gs_dyn_array_size(gsi->cache.projection) - 1];
+	gs_mat4 mvp = gs_mat4_mul(proj, mv);
+
+	// Bind instanced pipeline for current state (only on change)
+	gsi_pipeline_state_attr_t attr = gsi->cache.pipeline;
+	attr.prim_type = (uint16_t)inst->prim;
+	gs_handle(gs_graphics_pipeline_t) pip = gsi_pipeline_table_find(inst->pipeline_table, attr);
+	if (gsi->bound_alt.id != pip.id) {
+		gs_graphics_bind_pipeline(&gsi->commands, pip);
+		gsi->bound_alt = pip;
+	}
+
+	// Upload instance records
+	gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
+	vdesc.data = inst->instances;
+	vdesc.size = ct * sizeof(gs_immediate_instance_t);
+	vdesc.usage = GS_GRAPHICS_BUFFER_USAGE_STREAM;
+	gs_graphics_vertex_buffer_request_update(&gsi->commands, inst->vbo, &vdesc);
+
+	gs_graphics_bind_vertex_buffer_desc_t vbuffers[] = {
+		{.buffer = base->vbo},
+		{.buffer = inst->vbo}
+	};
+
+	gs_graphics_bind_uniform_desc_t ubinds[] = {
+		{.uniform = gsi->uniform, .data = &mvp},
+		{.uniform = gsi->sampler, .data = &gsi->cache.texture}
+	};
+
+	gs_graphics_bind_desc_t binds = gs_default_val();
+	binds.vertex_buffers.desc = vbuffers; 
+	binds.vertex_buffers.size = sizeof(vbuffers); 
+	binds.uniforms.desc = ubinds;
+	binds.uniforms.size = sizeof(ubinds);
+	gs_graphics_apply_bindings(&gsi->commands, &binds);
+
+	gs_graphics_draw(&gsi->commands, &(gs_graphics_draw_desc_t){.start = 0, .count = gs_dyn_array_size(base->vertices), .instances = ct});
+
+	gs_dyn_array_clear(inst->instances);
+}
+
+void gsi_instance_push(gs_immediate_draw_t* gsi, gsi_shape_type shape, gs_graphics_primitive_type type, gs_vec4 rect, gs_vec4 uv, gs_color_t color)
+{
+	gs_immediate_instanced_t* inst = &gsi->instanced;
+
+	// Pending verts, or instances of another shape, go out first to keep call order
+	if (gs_dyn_array_size(gsi->vertices) || (gs_dyn_array_size(inst->instances) && (inst->shape != shape || inst->prim != type))) {
+		gsi_flush(gsi);
+	}
+
+	inst->shape = shape;
+	inst->prim = type;
+	gs_immediate_instance_t i = {.rect = rect, .uv = uv, .color = color};
+	gs_dyn_array_push(inst->instances, i);
 }
 
 /* Core Vertex Functions */
 void gsi_begin(gs_immediate_draw_t* gsi, gs_graphics_primitive_type type)
 {
+	// Pending instances go out first to keep call order
+	if (gs_dyn_array_size(gsi->instanced.instances)) {
+		gsi_instance_flush(gsi);
+	}
+
 	switch (type) {
 		default:
 		case GS_GRAPHICS_PRIMITIVE_TRIANGLES: type = GS_GRAPHICS_PRIMITIVE_TRIANGLES; break;
@@ -494,6 +1294,8 @@ void gsi_end(gs_immediate_draw_t* gsi)
 
 void gsi_flush(gs_immediate_draw_t* gsi)
 {
+	gsi_instance_flush(gsi);
+
 	// Don't flush if verts empty
 	if (gs_dyn_array_empty(gsi->vertices)) {
 		return;
@@ -504,6 +1306,18 @@ void gsi_flush(gs_immediate_draw_t* gsi)
 	gs_mat4 proj = gsi->cache.projection[gs_dyn_array_size(gsi->cache.projection) - 1];
 	gs_mat4 mvp = gs_mat4_mul(proj, mv);
 
+	// Record into deferred queue, sorted and submitted at gsi_draw()
+	if (gsi->deferred.enabled) {
+		gsi_deferred_record(gsi, &mvp);
+		gs_dyn_array_clear(gsi->vertices);
+		return;
+	}
+
+	// A retained/instanced pipeline was bound since the last flush, rebind ours
+	if (gsi->bound_alt.id != gs_handle_invalid(gs_graphics_pipeline_t).id) {
+		gs_immediate_draw_set_pipeline(gsi);
+	}
+
 	// Update vertex buffer (command buffer version)
 	gs_graphics_vertex_buffer_desc_t vdesc = gs_default_val();
 	vdesc.data = gsi->vertices;
@@ -622,6 +1436,23 @@ void gsi_texture(gs_immediate_draw_t* gsi, gs_handle(gs_graphics_texture_t) text
 	gsi->cache.texture = texture.id && texture.id != UINT32_MAX ? texture : gsi->tex_default;
 }
 
+void gsi_sdf_enabled(gs_immediate_draw_t* gsi, bool enabled)
+{
+	// Push a new pipeline?
+	if (gsi->cache.pipeline.sdf_enabled == (uint16_t)enabled) {
+		return;
+	}
+
+	// Otherwise, we need to flush previous content
+	gsi_flush(gsi);
+
+	// Set distance field sampling
+	gsi->cache.pipeline.sdf_enabled = (uint16_t)enabled;	
+
+	// Bind pipeline
+	gs_immediate_draw_set_pipeline(gsi);
+}
+
 // Not working for the moment
 void gsi_defaults(gs_immediate_draw_t* gsi)
 {
@@ -637,6 +1468,56 @@ void gsi_defaults(gs_immediate_draw_t* gsi)
 	gs_immediate_draw_set_pipeline(gsi);
 }
 
+// Deferred draw queue
+void gsi_deferred_enabled(gs_immediate_draw_t* gsi, bool enabled)
+{
+	if (gsi->deferred.enabled == enabled) {
+		return;
+	}
+
+	// Close out previous mode: either record pending verts, or emit them in call order
+	gsi_flush(gsi);
+
+	if (!enabled) {
+		// Queue goes out ahead of anything drawn from here on
+		gsi_deferred_submit(gsi);
+	}
+
+	gsi->deferred.enabled = enabled;
+
+	// Immediate mode expects the current pipeline to be bound
+	if (!enabled && gsi->cache.pipeline.prim_type) {
+		gs_immediate_draw_set_pipeline(gsi);
+	}
+}
+
+void gsi_layer(gs_immediate_draw_t* gsi, uint8_t layer)
+{
+	if (gsi->cache.layer == layer) {
+		return;
+	}
+	gsi_flush(gsi);
+	gsi->cache.layer = layer;
+}
+
+void gsi_sort_depth(gs_immediate_draw_t* gsi, float depth)
+{
+	if (gsi->cache.sort_depth == depth) {
+		return;
+	}
+	gsi_flush(gsi);
+	gsi->cache.sort_depth = depth;
+}
+
+void gsi_preserve_order(gs_immediate_draw_t* gsi, bool enabled)
+{
+	if (gsi->cache.preserve_order == enabled) {
+		return;
+	}
+	gsi_flush(gsi);
+	gsi->cache.preserve_order = enabled;
+}
+
 void gsi_tc2fv(gs_immediate_draw_t* gsi, gs_vec2 uv)
 {
 	// Set cache register
@@ -1004,172 +1885,129 @@ void gsi_circle_sector(gs_immediate_draw_t* gsi, float cx, float cy, float radiu
 
 void gsi_circle(gs_immediate_draw_t* gsi, float cx, float cy, float radius, int32_t segments, uint8_t r, uint8_t g, uint8_t b, uint8_t a, gs_graphics_primitive_type type)
 {
-	gsi_circle_sector(gsi, cx, cy, radius, 0, 360, segments, r, g, b, a, type);	
-}
+	// Explicit segment count, generate
+	if (segments >= 4) {
+		gsi_circle_sector(gsi, cx, cy, radius, 0, 360, segments, r, g, b, a, type);	
+		return;
+	}
 
-void gsi_box(gs_immediate_draw_t* gsi, float x, float y, float z, float hx, float hy, float hz, 
-		uint8_t r, uint8_t g, uint8_t b, uint8_t a, gs_graphics_primitive_type type)
-{
-	float width = hx;
-	float height = hy;
-	float length = hz;
+	// Retained unit circle only where it stays within the error rate without being over twice as fine as needed,
+	// everything else gets the radius adaptive segment count
+	radius = radius <= 0.f ? 0.1f : radius;
+	const float err_retained = 1.f - cosf((float)GS_PI / (float)gsi_retained_circle_segments);
+	const float err_half = 1.f - cosf(2.f * (float)GS_PI / (float)gsi_retained_circle_segments);
+	if (radius * err_retained > gsi_smooth_circle_error_rate || radius * err_half <= gsi_smooth_circle_error_rate) {
+		gsi_circle_sector(gsi, cx, cy, radius, 0, 360, 0, r, g, b, a, type);
+		return;
+	}
 
-	gs_vec3 v0 = gs_v3(x - width/2, y - height/2, z + length/2);
-	gs_vec3 v1 = gs_v3(x + width/2, y - height/2, z + length/2);
-	gs_vec3 v2 = gs_v3(x - width/2, y + height/2, z + length/2);
-	gs_vec3 v3 = gs_v3(x + width/2, y + height/2, z + length/2);
-	gs_vec3 v4 = gs_v3(x - width/2, y - height/2, z - length/2);
-	gs_vec3 v5 = gs_v3(x - width/2, y + height/2, z - length/2);
-	gs_vec3 v6 = gs_v3(x + width/2, y - height/2, z - length/2);
-	gs_vec3 v7 = gs_v3(x + width/2, y + height/2, z - length/2);
+	gs_mat4 model = gs_mat4_mul(gs_mat4_translate(cx, cy, 0.f), gs_mat4_scale(radius, radius, 1.f));
+	gsi_shape(gsi, GSI_SHAPE_CIRCLE, model, gs_color(r, g, b, a), type);
+}
 
-	gs_color_t color = gs_color(r, g, b, a);
+void gsi_shape(gs_immediate_draw_t* gsi, gsi_shape_type shape, gs_mat4 model, gs_color_t color, gs_graphics_primitive_type type)
+{
+	gs_assert(shape > _gs_gsi_shape_type_default && shape < _gs_gsi_shape_type_count);
+	type = type == GS_GRAPHICS_PRIMITIVE_LINES || shape == GSI_SHAPE_LINE ? GS_GRAPHICS_PRIMITIVE_LINES : GS_GRAPHICS_PRIMITIVE_TRIANGLES;
+	gs_immediate_retained_mesh_t* mesh = &gsi->retained[shape][type == GS_GRAPHICS_PRIMITIVE_TRIANGLES];
 
-	switch (type)
+	// Small shapes are cheaper to copy than to draw on their own, and deferred draws are sorted by vertex range, so
+	// both expand the cached unit shape instead (still no trig)
+	if (gsi->deferred.enabled || gs_dyn_array_size(mesh->vertices) < gsi_retained_min_vertices)
 	{
-		case GS_GRAPHICS_PRIMITIVE_TRIANGLES:
-		{
-			gsi_begin(gsi, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+		gsi_begin(gsi, type);
+			gsi_c4ub(gsi, color.r, color.g, color.b, color.a);
+			for (uint32_t i = 0; i < gs_dyn_array_size(mesh->vertices); ++i)
 			{
-				gs_vec2 uv0 = gs_v2(0.f, 0.f);
-				gs_vec2 uv1 = gs_v2(1.f, 0.f);
-				gs_vec2 uv2 = gs_v2(0.f, 1.f);
-				gs_vec2 uv3 = gs_v2(1.f, 1.f);
-
-		        // Front Face
-		        gsi_trianglevx(gsi, v0, v1, v2, uv0, uv1, uv2, color, type);
-		        gsi_trianglevx(gsi, v3, v2, v1, uv3, uv2, uv1, color, type);
-		        
-		        // Back face
-		        gsi_trianglevx(gsi, v6, v5, v7, uv0, uv3, uv2, color, type);
-		        gsi_trianglevx(gsi, v6, v4, v5, uv0, uv1, uv3, color, type);
-
-		        // Top face
-		        gsi_trianglevx(gsi, v7, v2, v3, uv0, uv3, uv2, color, type);
-		        gsi_trianglevx(gsi, v7, v5, v2, uv0, uv1, uv3, color, type);
-
-		        // Bottom face
-		        gsi_trianglevx(gsi, v4, v1, v0, uv0, uv3, uv2, color, type);
-		        gsi_trianglevx(gsi, v4, v6, v1, uv0, uv1, uv3, color, type);
-
-		        // Right face
-		        gsi_trianglevx(gsi, v1, v7, v3, uv0, uv3, uv2, color, type);
-		        gsi_trianglevx(gsi, v1, v6, v7, uv0, uv1, uv3, color, type);
-
-		        // Left face
-		        gsi_trianglevx(gsi, v4, v2, v5, uv0, uv3, uv2, color, type);
-		        gsi_trianglevx(gsi, v4, v0, v2, uv0, uv1, uv3, color, type);
+				gs_immediate_vert_t* v = &mesh->vertices[i];
+				gs_vec4 p = gs_mat4_mul_vec4(model, gs_v4(v->position.x, v->position.y, v->position.z, 1.f));
+				gsi_tc2fv(gsi, v->uv);
+				gsi_v3f(gsi, p.x, p.y, p.z);
 			}
-			gsi_end(gsi);
-		} break;
+		gsi_end(gsi);
+		return;
+	}
 
-		case GS_GRAPHICS_PRIMITIVE_LINES:
-		{
-			gs_color_t color = gs_color(r, g, b, a);
-			gsi_tc2f(gsi, 0.f, 0.f);
-
-			// Front face
-			gsi_line3Dv(gsi, v0, v1, color);
-			gsi_line3Dv(gsi, v1, v3, color);
-			gsi_line3Dv(gsi, v3, v2, color);
-			gsi_line3Dv(gsi, v2, v0, color);
-
-				// Back face
-			gsi_line3Dv(gsi, v4, v6, color);
-			gsi_line3Dv(gsi, v6, v7, color);
-			gsi_line3Dv(gsi, v7, v5, color);
-			gsi_line3Dv(gsi, v5, v4, color);
-
-				// Right face
-			gsi_line3Dv(gsi, v1, v6, color);
-			gsi_line3Dv(gsi, v6, v7, color);
-			gsi_line3Dv(gsi, v7, v3, color);
-			gsi_line3Dv(gsi, v3, v1, color);
-
-				// Left face
-			gsi_line3Dv(gsi, v4, v6, color);
-			gsi_line3Dv(gsi, v6, v1, color);
-			gsi_line3Dv(gsi, v1, v0, color);
-			gsi_line3Dv(gsi, v0, v4, color);
-
-				// Bottom face
-			gsi_line3Dv(gsi, v5, v7, color);
-			gsi_line3Dv(gsi, v7, v3, color);
-			gsi_line3Dv(gsi, v3, v2, color);
-			gsi_line3Dv(gsi, v2, v5, color);
-
-				// Top face
-			gsi_line3Dv(gsi, v0, v4, color);
-			gsi_line3Dv(gsi, v4, v5, color);
-			gsi_line3Dv(gsi, v5, v2, color);
-			gsi_line3Dv(gsi, v2, v0, color);
+	// Keep call order with pending verts
+	gsi_flush(gsi);
 
-		} break;
+	gs_mat4 mv = gsi->cache.modelview[gs_dyn_array_size(gsi->cache.modelview) - 1];
+	gs_mat4 proj = gsi->cache.projection[gs_dyn_array_size(gsi->cache.projection) - 1];
+	gs_mat4 mvp = gs_mat4_mul(proj, gs_mat4_mul(mv, model));
+	gs_vec4 tint = gs_v4((float)color.r / 255.f, (float)color.g / 255.f, (float)color.b / 255.f, (float)color.a / 255.f);
+
+	// Bind retained pipeline for current state (only on change)
+	gsi_pipeline_state_attr_t attr = gsi->cache.pipeline;
+	attr.prim_type = (uint16_t)type;
+	gs_handle(gs_graphics_pipeline_t) pip = gsi_pipeline_table_find(gsi->retained_pipeline_table, attr);
+	if (gsi->bound_alt.id != pip.id) {
+		gs_graphics_bind_pipeline(&gsi->commands, pip);
+		gsi->bound_alt = pip;
 	}
 
+	gs_graphics_bind_vertex_buffer_desc_t vbuffer = gs_default_val();
+	vbuffer.buffer = mesh->vbo;
+
+	gs_graphics_bind_uniform_desc_t ubinds[] = {
+		{.uniform = gsi->uniform, .data = &mvp},
+		{.uniform = gsi->sampler, .data = &gsi->cache.texture},
+		{.uniform = gsi->tint, .data = &tint}
+	};
+
+	gs_graphics_bind_desc_t binds = gs_default_val();
+	binds.vertex_buffers.desc = &vbuffer; 
+	binds.uniforms.desc = ubinds;
+	binds.uniforms.size = sizeof(ubinds);
+	gs_graphics_apply_bindings(&gsi->commands, &binds);
+
+	gs_graphics_draw(&gsi->commands, &(gs_graphics_draw_desc_t){.start = 0, .count = gs_dyn_array_size(mesh->vertices)});
+}
+
+void gsi_box(gs_immediate_draw_t* gsi, float x, float y, float z, float hx, float hy, float hz, 
+		uint8_t r, uint8_t g, uint8_t b, uint8_t a, gs_graphics_primitive_type type)
+{
+	gs_mat4 model = gs_mat4_mul(gs_mat4_translate(x, y, z), gs_mat4_scale(hx, hy, hz));
+	gsi_shape(gsi, GSI_SHAPE_BOX, model, gs_color(r, g, b, a), type);
 }
 
 void gsi_sphere(gs_immediate_draw_t* gsi, float cx, float cy, float cz, float radius, uint8_t r, uint8_t g, uint8_t b, uint8_t a, gs_graphics_primitive_type type)
 {
-	// Modified from: http://www.songho.ca/opengl/gl_sphere.html
-	const uint32_t stacks = 16;
-	const uint32_t sectors = 32; 
-	float sector_step = 2.f * (float)GS_PI / (float)sectors;
-	float stack_step = (float)GS_PI / (float)stacks;
-	struct { 
-		gs_vec3 p;
-		gs_vec2 uv;
-	} v0, v1, v2, v3;
-	gs_color_t color = gs_color(r, g, b, a);
+	gs_mat4 model = gs_mat4_mul(gs_mat4_translate(cx, cy, cz), gs_mat4_scale(radius, radius, radius));
+	gsi_shape(gsi, GSI_SHAPE_SPHERE, model, gs_color(r, g, b, a), type);
+}
 
-	// TODO(john): Need to get these verts to be positioned correctly (translate then rotate all verts to correct for odd 90 degree rotation)
-	#define make_vert(V, I, J, XZ, SECANGLE)\
-		do {\
-	        /* vertex position (x, y, z) */\
-		    V.p.x = cx + (XZ) * cosf((SECANGLE));\
-		    V.p.z = cz + (XZ) * sinf((SECANGLE));\
-	        /* vertex tex coord (s, t) range between [0, 1] */\
-	        V.uv.x = (float)(J) / sectors;\
-	        V.uv.y = (float)(I) / stacks;\
-		} while (0)
-
-	#define push_vert(V)\
-		do {\
-	        gsi_tc2f(gsi, V.s, V.t);\
-	        gsi_v3f(gsi, V.x, V.y, V.z);\
-		} while (0)
-
-	for (uint32_t i = 0; i < stacks; ++i)
-	{
-		float sa0 = GS_PI / 2.f - i * stack_step;      
-	    float sa1 = GS_PI / 2.f - (i + 1) * stack_step;
-	    float xz0 = radius * cosf(sa0); 
-	    float xz1 = radius * cosf(sa1); 
-	    float y0 = cy + radius * sinf(sa0);            // r * sin(u)
-	    float y1 = cy + radius * sinf(sa1);            // r * sin(u)
+void gsi_rect_instanced(gs_immediate_draw_t* gsi, gs_vec2 xy, gs_vec2 wh, gs_vec2 uv0, gs_vec2 uv1, gs_color_t color, gs_graphics_primitive_type type)
+{
+	// Deferred draws are sorted by vertex range, so generate instead
+	if (gsi->deferred.enabled) {
+		gsi_rectvd(gsi, xy, wh, uv0, uv1, color, type);
+		return;
+	}
 
-	    v0.p.y = y0;
-	    v1.p.y = y0;
-	    v2.p.y = y1;
-	    v3.p.y = y1;
+	type = type == GS_GRAPHICS_PRIMITIVE_LINES ? GS_GRAPHICS_PRIMITIVE_LINES : GS_GRAPHICS_PRIMITIVE_TRIANGLES;
+	gsi_instance_push(gsi, GSI_SHAPE_RECT, type, gs_v4(xy.x, xy.y, wh.x, wh.y), gs_v4(uv0.x, uv0.y, uv1.x, uv1.y), color);
+}
 
-	    for(uint32_t j = 0; j < sectors; ++j)
-	    {
-	        float sca0 = j * sector_step;           // starting from 0 to 2pi
-	        float sca1 = (j + 1) * sector_step;
+void gsi_line_instanced(gs_immediate_draw_t* gsi, gs_vec2 v0, gs_vec2 v1, gs_color_t color)
+{
+	if (gsi->deferred.enabled) {
+		gsi_linev(gsi, v0, v1, color);
+		return;
+	}
 
-	        // Make verts
-	        make_vert(v0, i, j, xz0, sca0);
-	        make_vert(v1, i, j + 1, xz0, sca1);
-	        make_vert(v2, i + 1, j, xz1, sca0);
-	        make_vert(v3, i + 1, j + 1, xz1, sca1);
+	gsi_instance_push(gsi, GSI_SHAPE_LINE, GS_GRAPHICS_PRIMITIVE_LINES, gs_v4(v0.x, v0.y, v1.x - v0.x, v1.y - v0.y), gs_v4(0.f, 0.f, 0.f, 0.f), color);
+}
 
-	        // First triangle
-	        gsi_trianglevx(gsi, v0.p, v3.p, v2.p, v0.uv, v3.uv, v2.uv, color, type);
-	        // Second triangle
-	        gsi_trianglevx(gsi, v0.p, v1.p, v3.p, v0.uv, v1.uv, v3.uv, color, type);
-	    }
+void gsi_circle_instanced(gs_immediate_draw_t* gsi, gs_vec2 c, float radius, gs_color_t color, gs_graphics_primitive_type type)
+{
+	if (gsi->deferred.enabled) {
+		gsi_circle(gsi, c.x, c.y, radius, 0, color.r, color.g, color.b, color.a, type);
+		return;
 	}
+
+	radius = radius <= 0.f ? 0.1f : radius;
+	type = type == GS_GRAPHICS_PRIMITIVE_LINES ? GS_GRAPHICS_PRIMITIVE_LINES : GS_GRAPHICS_PRIMITIVE_TRIANGLES;
+	gsi_instance_push(gsi, GSI_SHAPE_CIRCLE, type, gs_v4(c.x, c.y, radius, radius), gs_v4(0.f, 0.f, 0.f, 0.f), color);
 }
 
 // Modified from Raylib's implementation
@@ -1191,6 +2029,78 @@ void gsi_bezier(gs_immediate_draw_t* gsi, float x0, float y0, float x1, float y1
     }	
 }
 
+/* Text Runs */
+uint64_t gsi_text_key(const char* text, const void* fp, float size)
+{
+	uint32_t sz = 0;
+	memcpy(&sz, &size, sizeof(sz));
+	uint64_t key = (uint64_t)gs_hash_bytes((void*)text, strlen(text), (size_t)(uintptr_t)fp ^ (size_t)sz);
+	return key ? key : 1;	// 0 marks an empty slot
+}
+
+bool32_t gsi_text_run_match(const gs_immediate_text_run_t* run, uint64_t key, const char* text, const void* fp, float size)
+{
+	size_t len = strlen(text);
+	return run->key == key && run->font == fp && run->size == size &&
+		gs_dyn_array_size(run->text) == len && memcmp(run->text, text, len) == 0;
+}
+
+// A NULL text leaves the run uncached (key 0)
+gs_immediate_text_run_t* gsi_text_run_begin(gs_immediate_text_run_t* run, uint64_t key, const char* text, const void* fp, float size)
+{
+	uint32_t len = text ? (uint32_t)strlen(text) : 0;
+	run->key = text ? key : 0;
+	run->font = fp;
+	run->size = size;
+	gs_dyn_array_clear(run->text);
+	if (len) {
+		gs_dyn_array_reserve(run->text, len);
+		memcpy(run->text, text, len);
+		gs_dyn_array_head(run->text)->size = len;
+	}
+	gs_dyn_array_clear(run->vertices);
+	gs_dyn_array_clear(run->segments);
+	return run;
+}
+
+void gsi_text_run_quad(gs_immediate_text_run_t* run, float l, float t, float r, float b, float s0, float t0, float s1, float t1)
+{
+	gs_immediate_vert_t q[6] = gs_default_val();
+	q[0].position = gs_v3(l, t, 0.f); q[0].uv = gs_v2(s0, t0);	// TL
+	q[1].position = gs_v3(r, b, 0.f); q[1].uv = gs_v2(s1, t1);	// BR
+	q[2].position = gs_v3(l, b, 0.f); q[2].uv = gs_v2(s0, t1);	// BL
+	q[3] = q[0];												// TL
+	q[4].position = gs_v3(r, t, 0.f); q[4].uv = gs_v2(s1, t0);	// TR
+	q[5] = q[1];												// BR
+	gsi_vert_append(&run->vertices, q, 6);
+	(gs_dyn_array_back(run->segments)).count += 6;
+}
+
+// Appends run at pen position with a copy per segment. Flipping negates y per vertex, so it doesn't break batches
+void gsi_text_run_emit(gs_immediate_draw_t* gsi, const gs_immediate_text_run_t* run, float x, float y, bool32_t flip_vertical, gs_color_t color)
+{
+	const float sy = flip_vertical ? -1.f : 1.f;
+	gsi_begin(gsi, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+	{
+		uint32_t start = 0;
+		for (uint32_t i = 0; i < gs_dyn_array_size(run->segments); ++i)
+		{
+			const gs_immediate_text_segment_t* seg = &run->segments[i];
+			gsi_texture(gsi, seg->texture);
+
+			uint32_t base = gs_dyn_array_size(gsi->vertices);
+			gsi_vert_append(&gsi->vertices, run->vertices + start, seg->count);
+			for (gs_immediate_vert_t* v = gsi->vertices + base; v < gsi->vertices + base + seg->count; ++v) {
+				v->position.x += x;
+				v->position.y = (v->position.y + y) * sy;
+				v->color = color;
+			}
+			start += seg->count;
+		}
+	}
+	gsi_end(gsi);
+}
+
 void gsi_text(gs_immediate_draw_t* gsi, float x, float y, const char* text, const gs_asset_font_t* fp, bool32_t flip_vertical, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
 {
 	// If no font, set to default
@@ -1198,61 +2108,115 @@ void gsi_text(gs_immediate_draw_t* gsi, float x, float y, const char* text, cons
 		fp = &gsi->font_default;
 	}
 
-	gsi_texture(gsi, fp->texture.hndl);
-
-	gs_mat4 rot = gs_mat4_rotatev(gs_deg2rad(-180.f), GS_XAXIS);
-
-	// Needs to be fixed in here. Not elsewhere.
-	gsi_begin(gsi, GS_GRAPHICS_PRIMITIVE_TRIANGLES);
+	// Shape once, reuse while the same text is drawn
+	uint64_t key = gsi_text_key(text, fp, 0.f);
+	gs_immediate_text_run_t* run = &gsi->text_cache[key & (gsi_text_cache_size - 1)];
+	if (!gsi_text_run_match(run, key, text, fp, 0.f))
 	{
-		gsi_c4ub(gsi, r, g, b, a);
-		while (text[0] != '\0')
+		gsi_text_run_begin(run, key, text, fp, 0.f);
+		gs_immediate_text_segment_t seg = gs_default_val();
+		seg.texture = fp->texture.hndl;
+		gs_dyn_array_push(run->segments, seg);
+
+		float px = 0.f, py = 0.f;
+		for (const char* c = text; *c != '\0'; ++c)
 		{
-			char c = text[0];
-			if (c >= 32 && c <= 127) 
+			if (*c >= 32 && *c <= 127) 
 			{
 				stbtt_aligned_quad q = gs_default_val();
-				stbtt_GetBakedQuad((stbtt_bakedchar*)fp->glyphs, fp->texture.desc.width, fp->texture.desc.height, c - 32, &x, &y, &q, 1);
-
-				gs_vec3 v0 = gs_v3(q.x0, q.y0, 0.f);	// TL
-				gs_vec3 v1 = gs_v3(q.x1, q.y0, 0.f);	// TR
-				gs_vec3 v2 = gs_v3(q.x0, q.y1, 0.f);	// BL
-				gs_vec3 v3 = gs_v3(q.x1, q.y1, 0.f);	// BR
-
-				if (flip_vertical) {
-					v0 = gs_mat4_mul_vec3(rot, v0);
-					v1 = gs_mat4_mul_vec3(rot, v1);
-					v2 = gs_mat4_mul_vec3(rot, v2);
-					v3 = gs_mat4_mul_vec3(rot, v3);
-				}
+				stbtt_GetBakedQuad((stbtt_bakedchar*)fp->glyphs, fp->texture.desc.width, fp->texture.desc.height, *c - 32, &px, &py, &q, 1);
+				gsi_text_run_quad(run, q.x0, q.y0, q.x1, q.y1, q.s0, q.t0, q.s1, q.t1);
+			}
+		}
+	}
 
-				gs_vec2 uv0 = gs_v2(q.s0, q.t0);	// TL
-				gs_vec2 uv1 = gs_v2(q.s1, q.t0);	// TR
-				gs_vec2 uv2 = gs_v2(q.s0, q.t1);	// BL
-				gs_vec2 uv3 = gs_v2(q.s1, q.t1);	// BR
+	// Glyph origins land on whole pixels, as baked fonts are meant to be drawn
+	gsi_text_run_emit(gsi, run, floorf(x + 0.5f), floorf(y + 0.5f), flip_vertical, gs_color(r, g, b, a));
+}
+
+bool32_t gsi_text_run_resident(const gs_immediate_text_run_t* run, gs_asset_sdf_font_t* fp)
+{
+	for (uint32_t i = 0; i < gs_dyn_array_size(run->segments); ++i) {
+		if (fp->pages[run->segments[i].page].generation != run->segments[i].generation) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void gsi_text_sdf(gs_immediate_draw_t* gsi, float x, float y, const char* text, gs_asset_sdf_font_t* fp, float size, bool32_t flip_vertical, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+	if (!fp || !fp->font_info || !text) {
+		return;
+	}
 
-				gsi_tc2fv(gsi, uv0);
-				gsi_v3fv(gsi, v0);
+	gs_handle(gs_graphics_texture_t) tex = gsi->cache.texture;
+	bool sdf = gsi->cache.pipeline.sdf_enabled;
+	gs_color_t color = gs_color(r, g, b, a);
+	gsi_sdf_enabled(gsi, true);
 
-		        gsi_tc2fv(gsi, uv3); 
-				gsi_v3fv(gsi, v3); 
+	// Shape once, reuse while the same text is drawn and its atlas pages stay resident
+	uint64_t key = gsi_text_key(text, fp, size);
+	gs_immediate_text_run_t* run = &gsi->text_cache[key & (gsi_text_cache_size - 1)];
+	if (!gsi_text_run_match(run, key, text, fp, size) || !gsi_text_run_resident(run, fp))
+	{
+		gsi_text_run_begin(run, key, text, fp, size);
 
-		        gsi_tc2fv(gsi, uv2); 
-				gsi_v3fv(gsi, v2); 
+		const float scale = size / fp->base_size;
+		const float inv = 1.f / (float)fp->page_size;
+		float px = 0.f;
+		while (text[0] != '\0')
+		{
+			uint32_t c = gs_util_utf8_next(&text);
+			const gs_sdf_glyph_t* gl = gs_asset_sdf_font_find_glyph(fp, c);
+			if (!gl) 
+			{
+				// Caching may evict a page this run already has quads on, so draw those first. 
+				// The split run isn't kept, it's reshaped once all its glyphs are resident.
+				if (gs_dyn_array_size(run->vertices)) {
+					gsi_text_run_emit(gsi, run, x, y, flip_vertical, color);
+					gsi_text_run_begin(run, 0, NULL, fp, size);
+				}
 
-				gsi_tc2fv(gsi, uv0); 
-				gsi_v3fv(gsi, v0);
+				// Everything recorded so far has to go out ahead of the upload
+				gsi_flush(gsi);
+				if (gsi->deferred.enabled) {
+					gsi_deferred_submit(gsi);
+				}
+				gl = gs_asset_sdf_font_cache_glyph(fp, &gsi->commands, c);
+			}
 
-		        gsi_tc2fv(gsi, uv1); 
-				gsi_v3fv(gsi, v1); 
+			if (gl->x1 != gl->x0) 
+			{
+				// New segment on page change
+				if (!gs_dyn_array_size(run->segments) || (gs_dyn_array_back(run->segments)).page != gl->page) {
+					gs_immediate_text_segment_t seg = gs_default_val();
+					seg.texture = fp->pages[gl->page].texture;
+					seg.page = gl->page;
+					seg.generation = gl->generation;
+					gs_dyn_array_push(run->segments, seg);
+				}
 
-		        gsi_tc2fv(gsi, uv3); 
-				gsi_v3fv(gsi, v3); 
+				float l = px + gl->xoff * scale;
+				float t = gl->yoff * scale;
+				gsi_text_run_quad(run, l, t, l + (float)(gl->x1 - gl->x0) * scale, t + (float)(gl->y1 - gl->y0) * scale,
+					(float)gl->x0 * inv, (float)gl->y0 * inv, (float)gl->x1 * inv, (float)gl->y1 * inv);
 			}
-			text++;
+
+			px += gl->xadvance * scale;
 		}
 	}
-	gsi_end(gsi);
+
+	// Keep pages in use from being evicted
+	for (uint32_t i = 0; i < gs_dyn_array_size(run->segments); ++i) {
+		fp->pages[run->segments[i].page].tick = ++fp->tick;
+	}
+
+	gsi_text_run_emit(gsi, run, x, y, flip_vertical, color);
+
+	// Restore previous state
+	gsi_sdf_enabled(gsi, sdf);
+	gsi_texture(gsi, tex);
 }
 
 // Final Submit / Merge
@@ -1261,6 +2225,9 @@ void gsi_draw(gs_immediate_draw_t* gsi, gs_command_buffer_t* cb)
 	// Final flush (if necessary)(this might be a part of gsi_end() instead)
 	gsi_flush(gsi);
 
+	// Sort, batch and emit deferred draws
+	gsi_deferred_submit(gsi);
+
 	// Merge gsi commands to end of cb
 	gs_byte_buffer_write_bulk(&cb->commands, gsi->commands.commands.data, gsi->commands.commands.position);
 
@@ -1289,6 +2256,24 @@ void gsi_render_pass_submit(gs_immediate_draw_t* gsi, gs_command_buffer_t* cb, g
 	gs_graphics_end_render_pass(cb);
 }
 
+void gsi_merge(gs_immediate_draw_t* gsi, gs_immediate_draw_t** recorders, uint32_t count)
+{
+	// Keep call order with gsi's own pending draws
+	gsi_flush(gsi);
+	gsi_deferred_submit(gsi);
+
+	// Append recorder commands in array order
+	for (uint32_t i = 0; i < count; ++i) 
+	{
+		gs_assert(recorders[i]->parent == gsi);
+		gsi_draw(recorders[i], &gsi->commands);
+	}
+
+	// Recorders leave their own pipeline bound, force a rebind on next begin
+	gsi->cache.pipeline.prim_type = 0x00;
+	gsi->bound_alt = gs_handle_invalid(gs_graphics_pipeline_t);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Default font data (ProggyClean.ttf)
 //-----------------------------------------------------------------------------